@@ -0,0 +1,417 @@
+/**
+ * @file    nc_adcchar.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   ADC characterization: code histogram, DNL/INL, SNR/SINAD/ENOB
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_adcchar.h"
+#include "nc_fixmath.h"
+
+/** @defgroup ACH
+  * @brief ADC quality figures per resolution and sample time
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] For each setting to qualify: stop the ADC, apply the resolution with
+         ADC_Init() and the sample time with ADC_RegularChannelConfig(), then
+         ACH_Init() a histogram tagged with both. Feed it capture or DMA blocks
+         with ACH_Accumulate() until Full, or until enough samples are in:
+         about 64 hits per code for DNL within 0.1 LSB.
+    [..] Static figures: drive a ramp or an overdriven sine and call
+         ACH_Linearity(). A ramp gives each code equal weight; a sine is
+         corrected through its arcsine density by turning the cumulative
+         histogram into transition levels, -cos(pi * C[k] / Total). Noise: hold
+         the input at a steady level and call ACH_Noise().
+    [..] Dynamic figures: drive a pure sine sampled coherently, an odd number
+         of Cycles in a power of two block of N samples, and call
+         ACH_Dynamic() on one channel. It fits the fundamental and harmonics by
+         correlation, which for coherent records is the exact least squares
+         sine fit, and calls the residual noise. The Q15 FFT is not used: its
+         own rounding floor sits near 50 dB, below what a 12-bit ADC achieves.
+    [..] Nothing here touches a peripheral: the same file builds on the host,
+         which runs it over recorded captures at 12 bits, while the device keeps
+         to the 8 KB a 12-bit histogram of 16-bit bins takes.
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define ACH_SIN_SEGMENTS              256     /*!< Segments of the quarter sine table */
+
+/* Private macro -------------------------------------------------------------*/
+/* Quarter sine in Q30, sin(pi / 2 * k / ACH_SIN_SEGMENTS) for k = 0 .. ACH_SIN_SEGMENTS */
+#define ACH_S1(K)     NC_Q30(NC_CSIN(NC_PI / 2.0 * (double)(K) / (double)ACH_SIN_SEGMENTS))
+#define ACH_S4(K)     ACH_S1(K), ACH_S1((K) + 1), ACH_S1((K) + 2), ACH_S1((K) + 3)
+#define ACH_S16(K)    ACH_S4(K), ACH_S4((K) + 4), ACH_S4((K) + 8), ACH_S4((K) + 12)
+#define ACH_S64(K)    ACH_S16(K), ACH_S16((K) + 16), ACH_S16((K) + 32), ACH_S16((K) + 48)
+#define ACH_S256(K)   ACH_S64(K), ACH_S64((K) + 64), ACH_S64((K) + 128), ACH_S64((K) + 192)
+
+/* Centi-dB of a Q16 base 2 log ratio, 10 * log10(2) = 3.0103 */
+#define ACH_CENTI_DB(L2)              ((int32_t)(((int64_t)(L2) * 30103) / 6553600))
+
+/* Private variables ---------------------------------------------------------*/
+static const int32_t ACH_Sin[ACH_SIN_SEGMENTS + 1] = { ACH_S256(0), ACH_S1(256) };
+
+/* Private function prototypes -----------------------------------------------*/
+static int64_t ACH_Level(uint64_t Cumulative, uint32_t Total, uint32_t Input);
+static int32_t ACH_SinTurn(uint32_t Turn);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Binds and clears a histogram.
+  * @param  ACHx: pointer to the histogram.
+  * @param  pHist: 1 << bits entries for the resolution.
+  * @param  Resolution: ADC_Resolution_x.
+  * @param  SampleTime: ADC_SampleTime_x, recorded only.
+  * @retval None
+  */
+void ACH_Init(ACH_HistTypeDef* ACHx, uint16_t* pHist, uint32_t Resolution, uint8_t SampleTime)
+{
+  uint32_t n;
+
+  ACHx->pHist = pHist;
+  ACHx->Total = 0;
+  ACHx->Resolution = Resolution;
+  ACHx->SampleTime = SampleTime;
+  ACHx->Bits = (uint8_t)ACH_RESOLUTION_BITS(Resolution);
+  ACHx->Full = 0;
+  for (n = 0; n < (1UL << ACHx->Bits); n++)
+  {
+    pHist[n] = 0;
+  }
+}
+
+/**
+  * @brief  Adds right aligned codes of one channel to the histogram.
+  * @param  ACHx: pointer to the histogram.
+  * @param  pSrc: first sample of the channel.
+  * @param  Stride: distance between consecutive samples (1, or the scan length).
+  * @param  Count: samples to add.
+  * @retval Samples taken, less than Count once a bin is full.
+  */
+uint32_t ACH_Accumulate(ACH_HistTypeDef* ACHx, const uint16_t* pSrc, uint32_t Stride, uint32_t Count)
+{
+  uint16_t* hist = ACHx->pHist;
+  uint32_t mask = (1UL << ACHx->Bits) - 1;
+  uint32_t n;
+
+  if (ACHx->Full)
+  {
+    return 0;
+  }
+  for (n = 0; n < Count; n++)
+  {
+    if (++hist[*pSrc & mask] == ACH_BIN_MAX)
+    {
+      ACHx->Full = 1;
+      n++;
+      break;
+    }
+    pSrc += Stride;
+  }
+  ACHx->Total += n;
+  return n;
+}
+
+/**
+  * @brief  Mean and RMS code noise of a steady input.
+  * @param  ACHx: pointer to the histogram.
+  * @param  pMean: receives the mean code in thousandths, may be 0.
+  * @retval RMS deviation from the mean in thousandths of an LSB.
+  */
+uint32_t ACH_Noise(const ACH_HistTypeDef* ACHx, int32_t* pMean)
+{
+  uint64_t sum = 0;
+  uint64_t var = 0;
+  int64_t mean, d;
+  uint32_t k;
+
+  if (ACHx->Total == 0)
+  {
+    return 0;
+  }
+  for (k = 0; k < (1UL << ACHx->Bits); k++)
+  {
+    sum += (uint64_t)ACHx->pHist[k] * k;
+  }
+  mean = (int64_t)((sum * 1000 + ACHx->Total / 2) / ACHx->Total);
+  if (pMean != 0)
+  {
+    *pMean = (int32_t)mean;
+  }
+  /* Second pass in milli-LSB, each bin weighted by its share of Total */
+  for (k = 0; k < (1UL << ACHx->Bits); k++)
+  {
+    if (ACHx->pHist[k] != 0)
+    {
+      d = (int64_t)k * 1000 - mean;
+      var += ((uint64_t)(d * d) * ACHx->pHist[k]) / ACHx->Total;
+    }
+  }
+  return NC_ISqrt64(var);
+}
+
+/**
+  * @brief  DNL and INL of every code from a ramp or sine histogram.
+  * @note   End codes absorb the overdrive and are not rated; their entries
+  *         are 0. Costs a 64-bit division per code.
+  * @param  ACHx: pointer to the histogram.
+  * @param  Input: ACH_INPUT_RAMP or ACH_INPUT_SINE.
+  * @param  pDnl: 1 << bits entries in thousandths of an LSB, may be 0.
+  * @param  pInl: 1 << bits entries in thousandths of an LSB, may be 0.
+  * @param  pResult: extremes and missing code count.
+  * @retval 0 on success, -1 if the input did not reach both end codes.
+  */
+int32_t ACH_Linearity(const ACH_HistTypeDef* ACHx, uint32_t Input, int16_t* pDnl, int16_t* pInl, ACH_LinearityTypeDef* pResult)
+{
+  const uint16_t* hist = ACHx->pHist;
+  uint32_t codes = 1UL << ACHx->Bits;
+  uint64_t cum;
+  int64_t first, last, span, level, next;
+  int32_t dnl, inl;
+  uint32_t k;
+
+  pResult->DnlMin = 0;
+  pResult->DnlMax = 0;
+  pResult->InlMin = 0;
+  pResult->InlMax = 0;
+  pResult->Missing = 0;
+  if ((hist[0] == 0) || (hist[codes - 1] == 0))
+  {
+    return -1;
+  }
+  /* Transition k lies between code k-1 and code k; rate codes 1 .. codes-2 */
+  first = ACH_Level(hist[0], ACHx->Total, Input);
+  last = ACH_Level(ACHx->Total - hist[codes - 1], ACHx->Total, Input);
+  span = last - first;
+  if (span <= 0)
+  {
+    return -1;
+  }
+  if (pDnl != 0)
+  {
+    pDnl[0] = 0;
+    pDnl[codes - 1] = 0;
+  }
+  if (pInl != 0)
+  {
+    pInl[0] = 0;
+    pInl[codes - 1] = 0;
+  }
+  cum = hist[0];
+  level = first;
+  for (k = 1; k < codes - 1; k++)
+  {
+    cum += hist[k];
+    next = (k == codes - 2) ? last : ACH_Level(cum, ACHx->Total, Input);
+    /* Ideal LSB is span / (codes - 2) */
+    dnl = (int32_t)(((next - level) * 1000 * (int64_t)(codes - 2)) / span) - 1000;
+    inl = (int32_t)(((level - first) * 1000 * (int64_t)(codes - 2)) / span) - 1000 * (int32_t)(k - 1);
+    if (dnl < pResult->DnlMin)
+    {
+      pResult->DnlMin = dnl;
+    }
+    if (dnl > pResult->DnlMax)
+    {
+      pResult->DnlMax = dnl;
+    }
+    if (inl < pResult->InlMin)
+    {
+      pResult->InlMin = inl;
+    }
+    if (inl > pResult->InlMax)
+    {
+      pResult->InlMax = inl;
+    }
+    if (dnl < -900)
+    {
+      pResult->Missing++;
+    }
+    if (pDnl != 0)
+    {
+      pDnl[k] = (int16_t)((dnl > 32767) ? 32767 : dnl);
+    }
+    if (pInl != 0)
+    {
+      pInl[k] = (int16_t)((inl > 32767) ? 32767 : (inl < -32768) ? -32768 : inl);
+    }
+    level = next;
+  }
+  return 0;
+}
+
+/**
+  * @brief  SNR, SINAD, THD and ENOB of one channel holding a sine.
+  * @note   Harmonics up to ACH_HARMONICS are fitted at their aliased frequency;
+  *         with Cycles odd none of them lands on DC, the fundamental or each
+  *         other. About 2 * ACH_HARMONICS + 2 table lookups per sample.
+  * @param  pSrc: first sample of the channel, right aligned codes.
+  * @param  Stride: distance between consecutive samples (1, or the scan length).
+  * @param  N: samples, a power of two up to 65536.
+  * @param  Cycles: whole sine periods in the N samples, odd.
+  * @param  Bits: resolution of the codes, for ENOB.
+  * @param  pResult: receives the figures.
+  * @retval None
+  */
+void ACH_Dynamic(const uint16_t* pSrc, uint32_t Stride, uint32_t N, uint32_t Cycles, uint8_t Bits, ACH_DynamicTypeDef* pResult)
+{
+  const uint16_t* p;
+  int64_t ci[ACH_HARMONICS];
+  int64_t si[ACH_HARMONICS];
+  uint32_t log2n = 0;
+  uint64_t sum = 0;
+  uint64_t resid = 0;
+  uint64_t signal, dist = 0, noise;
+  int64_t d, mean, a, b;
+  uint32_t i, h, step, turn;
+  int32_t l2s;
+
+  while ((1UL << log2n) < N)
+  {
+    log2n++;
+  }
+  for (i = 0, p = pSrc; i < N; i++, p += Stride)
+  {
+    sum += *p;
+  }
+  mean = (int64_t)((sum << 8) >> log2n);                  /* Q8 codes */
+  for (h = 0; h < ACH_HARMONICS; h++)
+  {
+    ci[h] = 0;
+    si[h] = 0;
+  }
+  /* Correlate with each harmonic, phase in Q30 turns */
+  step = (uint32_t)(((uint64_t)Cycles << 30) >> log2n);
+  for (i = 0, p = pSrc, turn = 0; i < N; i++, p += Stride, turn += step)
+  {
+    d = ((int64_t)*p << 8) - mean;
+    for (h = 0; h < ACH_HARMONICS; h++)
+    {
+      si[h] += d * (ACH_SinTurn(turn * (h + 1)) >> 15);
+      ci[h] += d * (ACH_SinTurn(turn * (h + 1) + (1UL << 28)) >> 15);
+    }
+  }
+  /* Amplitudes 2 * sum / N are Q23 codes; harmonic power (a^2 + b^2) / 2 in Q24 */
+  for (h = 1; h < ACH_HARMONICS; h++)
+  {
+    a = (ci[h] >> (log2n - 1)) >> 11;
+    b = (si[h] >> (log2n - 1)) >> 11;
+    dist += (uint64_t)(a * a + b * b) >> 1;
+  }
+  a = (ci[0] >> (log2n - 1)) >> 11;
+  b = (si[0] >> (log2n - 1)) >> 11;
+  signal = (uint64_t)(a * a + b * b) >> 1;
+  pResult->Amplitude = (uint32_t)(((uint64_t)NC_ISqrt64(signal << 1) * 1000) >> 12);
+  /* Noise and distortion as the residual of the fundamental, not a difference
+     of two large powers; fit coefficients in Q16 codes */
+  a = (ci[0] >> (log2n - 1)) >> 7;
+  b = (si[0] >> (log2n - 1)) >> 7;
+  for (i = 0, p = pSrc, turn = 0; i < N; i++, p += Stride, turn += step)
+  {
+    d = ((int64_t)*p << 8) - mean;
+    d -= (a * ACH_SinTurn(turn + (1UL << 28)) + b * ACH_SinTurn(turn)) >> 38;
+    resid += (uint64_t)(d * d);
+  }
+  resid = (resid >> log2n) << 8;                          /* Mean square, Q24 codes^2 */
+  noise = (resid > dist) ? resid - dist : 1;
+  if (resid == 0)
+  {
+    resid = 1;
+  }
+  l2s = NC_Log2Q16((signal != 0) ? signal : 1);
+  pResult->Snr = ACH_CENTI_DB(l2s - NC_Log2Q16(noise));
+  pResult->Sinad = ACH_CENTI_DB(l2s - NC_Log2Q16(resid));
+  pResult->Thd = ACH_CENTI_DB(NC_Log2Q16((dist != 0) ? dist : 1) - l2s);
+  /* ENOB = Bits - log2(rms error / (1 LSB / sqrt(12))), error power in Q24 codes^2 */
+  pResult->Enob = (int32_t)Bits * 100 -
+                  (int32_t)((((int64_t)NC_Log2Q16(resid * 12) - (24L << 16)) * 50) >> 16);
+}
+
+/**
+  * @brief  Input level at a transition from the cumulative count below it.
+  * @param  Cumulative: samples below the transition.
+  * @param  Total: samples in the histogram.
+  * @param  Input: ACH_INPUT_RAMP or ACH_INPUT_SINE.
+  * @retval Level in Q30 of the input range, monotonic in Cumulative.
+  */
+static int64_t ACH_Level(uint64_t Cumulative, uint32_t Total, uint32_t Input)
+{
+  int64_t p = (int64_t)((Cumulative << 30) / Total);      /* Q30, 0 .. 1 */
+
+  if (Input == ACH_INPUT_RAMP)
+  {
+    return p;
+  }
+  /* -cos(pi * p) = sin(pi * (p - 1/2)), half a turn per unit of p */
+  return ACH_SinTurn((uint32_t)((p - (1L << 29)) >> 1));
+}
+
+/**
+  * @brief  Sine of an angle in turns, from the quarter table by symmetry.
+  * @param  Turn: angle in Q30 turns, taken modulo one turn.
+  * @retval Sine in Q30, linear interpolation error below 5e-6.
+  */
+static int32_t ACH_SinTurn(uint32_t Turn)
+{
+  uint32_t quadrant = (Turn >> 28) & 3;
+  uint32_t r = Turn & ((1UL << 28) - 1);
+  uint32_t i;
+  int32_t s;
+
+  if (quadrant & 1)
+  {
+    r = (1UL << 28) - r;
+  }
+  /* 28 bits of quadrant: 8 bits of table index, 20 of interpolation */
+  i = r >> 20;
+  if (i >= ACH_SIN_SEGMENTS)
+  {
+    s = ACH_Sin[ACH_SIN_SEGMENTS];
+  }
+  else
+  {
+    s = ACH_Sin[i] + (int32_t)(((int64_t)(ACH_Sin[i + 1] - ACH_Sin[i]) * (r & ((1UL << 20) - 1))) >> 20);
+  }
+  return (quadrant & 2) ? -s : s;
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,111 @@
+/**
+ * @file    nc_adcchar.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   ADC characterization: code histogram, DNL/INL, SNR/SINAD/ENOB
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_ADCCHAR_H
+#define NC_ADCCHAR_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_ADCCHAR_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define ACH_INPUT_RAMP                0       /*!< Linear ramp or triangle, uniform code density */
+#define ACH_INPUT_SINE                1       /*!< Sine slightly overdriving both rails */
+
+#define ACH_BIN_MAX                   0xFFFF  /*!< A histogram bin stops accumulating here */
+#define ACH_HARMONICS                 6       /*!< Highest harmonic counted as distortion */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  Code histogram for one resolution and sample time setting.
+  */
+typedef struct
+{
+  uint16_t* pHist;            /*!< 1 << Bits bins */
+  uint32_t Total;             /*!< Samples accumulated */
+  uint32_t Resolution;        /*!< ADC_Resolution_x the histogram belongs to */
+  uint8_t SampleTime;         /*!< ADC_SampleTime_x the histogram belongs to */
+  uint8_t Bits;               /*!< 12, 10, 8 or 6 */
+  uint8_t Full;               /*!< A bin reached ACH_BIN_MAX */
+}ACH_HistTypeDef;
+
+/**
+  * @brief  Static linearity, in thousandths of an LSB, endpoint fit.
+  */
+typedef struct
+{
+  int32_t DnlMin;
+  int32_t DnlMax;
+  int32_t InlMin;
+  int32_t InlMax;
+  uint32_t Missing;           /*!< Codes with DNL below -0.9 LSB */
+}ACH_LinearityTypeDef;
+
+/**
+  * @brief  Dynamic performance from one coherently sampled sine.
+  */
+typedef struct
+{
+  int32_t Snr;                /*!< Hundredths of a dB */
+  int32_t Sinad;              /*!< Hundredths of a dB */
+  int32_t Thd;                /*!< Hundredths of a dB, negative */
+  int32_t Enob;               /*!< Hundredths of a bit, against full scale */
+  uint32_t Amplitude;         /*!< Fitted fundamental, thousandths of a code */
+}ACH_DynamicTypeDef;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Resolution in bits of an ADC_Resolution_x value */
+#define ACH_RESOLUTION_BITS(RES)      (12 - 2 * (uint8_t)((RES) >> 24))
+
+/* Exported functions ------------------------------------------------------- */
+void ACH_Init(ACH_HistTypeDef* ACHx, uint16_t* pHist, uint32_t Resolution, uint8_t SampleTime);
+uint32_t ACH_Accumulate(ACH_HistTypeDef* ACHx, const uint16_t* pSrc, uint32_t Stride, uint32_t Count);
+uint32_t ACH_Noise(const ACH_HistTypeDef* ACHx, int32_t* pMean);
+int32_t ACH_Linearity(const ACH_HistTypeDef* ACHx, uint32_t Input, int16_t* pDnl, int16_t* pInl, ACH_LinearityTypeDef* pResult);
+void ACH_Dynamic(const uint16_t* pSrc, uint32_t Stride, uint32_t N, uint32_t Cycles, uint8_t Bits, ACH_DynamicTypeDef* pResult);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_ADCCHAR_H */
@@ -0,0 +1,273 @@
+/**
+ * @file    nc_adpcm.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   IMA-ADPCM codec for audio-band channels
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_adpcm.h"
+#include "nc_fixmath.h"
+
+/** @defgroup ADP
+  * @brief 4:1 IMA-ADPCM of 12-bit channels
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] One ADP_StateTypeDef per coded channel, ADP_Init() on both sides.
+         ADP_Encode() takes one channel of a DMA block, 12-bit codes at any
+         stride, and writes 4 bits per sample, first sample in the low nibble
+         as in IMA/DVI WAV data. 16-bit PCM samples in 4 bits is 4:1; against
+         the 12-bit code it is 3:1.
+    [..] The codec has no notion of time, it follows whatever rate TIM3 drives
+         the scan at (ZC_TIM3SampleRate() reports it): 8 kHz takes 32 kbit/s,
+         48 kHz 192 kbit/s per channel.
+    [..] ADP_Decode() is target independent and also builds on the host;
+         ADP_Snr() compares a decoded block against the original codes.
+         tools/nc_adpcm_check.c reports it at 8 kHz: a 50 Hz tone keeps
+         42.9 dB at full scale and 48.1 dB at -20 dB, a 1 kHz tone 21.9 and
+         20.7 dB, as the fixed step adaptation lags the faster slope.
+    [..] To let a receiver join mid-stream or survive a lost block, send the
+         encoder state as it was before each block and load it into the
+         decoder state before decoding.
+
+                         ##### Cycle model #####
+    [..] About 40 cycles per sample to encode on the Cortex-M3 (three step
+         compares, clamps and two table loads), 30 to decode; one 8 kHz
+         channel costs 1% of a 32 MHz core.
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define ADP_INDEX_MAX             88
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static const int8_t ADP_IndexTable[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+
+static const uint16_t ADP_StepTable[ADP_INDEX_MAX + 1] =
+{
+  7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+  50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+  253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+  1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+  3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+  12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static void ADP_Update(ADP_StateTypeDef* ADPx, uint32_t Nibble);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Resets a channel state to silence at the smallest step.
+  * @param  ADPx: pointer to the state.
+  * @retval None
+  */
+void ADP_Init(ADP_StateTypeDef* ADPx)
+{
+  ADPx->Predictor = 0;
+  ADPx->Index = 0;
+}
+
+/**
+  * @brief  Encodes one channel of a block.
+  * @param  ADPx: pointer to the encoder state.
+  * @param  pSrc: first sample of the channel, right aligned 12-bit codes.
+  * @param  Stride: distance between consecutive samples (1, or the scan length).
+  * @param  Count: samples.
+  * @param  pDst: ADP_BYTES(Count) bytes; an odd count leaves the last high nibble 0.
+  * @retval None
+  */
+void ADP_Encode(ADP_StateTypeDef* ADPx, const uint16_t* pSrc, uint32_t Stride, uint32_t Count, uint8_t* pDst)
+{
+  uint32_t n, nibble, step;
+  int32_t diff;
+
+  for (n = 0; n < Count; n++)
+  {
+    diff = ADP_ADC12_TO_PCM(*pSrc) - ADPx->Predictor;
+    pSrc += Stride;
+    nibble = 0;
+    if (diff < 0)
+    {
+      nibble = 8;
+      diff = -diff;
+    }
+    /* Quantize |diff| / step to 3 bits by successive approximation */
+    step = ADP_StepTable[ADPx->Index];
+    if (diff >= (int32_t)step)
+    {
+      nibble |= 4;
+      diff -= step;
+    }
+    step >>= 1;
+    if (diff >= (int32_t)step)
+    {
+      nibble |= 2;
+      diff -= step;
+    }
+    step >>= 1;
+    if (diff >= (int32_t)step)
+    {
+      nibble |= 1;
+    }
+    /* Track the decoder exactly, it is the predictor */
+    ADP_Update(ADPx, nibble);
+    if (n & 1)
+    {
+      *pDst++ |= (uint8_t)(nibble << 4);
+    }
+    else
+    {
+      *pDst = (uint8_t)nibble;
+    }
+  }
+}
+
+/**
+  * @brief  Decodes one channel of a block to 16-bit PCM.
+  * @param  ADPx: pointer to the decoder state.
+  * @param  pSrc: ADP_BYTES(Count) bytes.
+  * @param  Count: samples.
+  * @param  pDst: Count samples; ADP_PCM_TO_ADC12() gives codes back.
+  * @retval None
+  */
+void ADP_Decode(ADP_StateTypeDef* ADPx, const uint8_t* pSrc, uint32_t Count, int16_t* pDst)
+{
+  uint32_t n;
+
+  for (n = 0; n < Count; n++)
+  {
+    ADP_Update(ADPx, (n & 1) ? (uint32_t)(*pSrc++ >> 4) : (uint32_t)(*pSrc & 0x0F));
+    pDst[n] = ADPx->Predictor;
+  }
+}
+
+/**
+  * @brief  Signal to noise ratio of a decoded block against its source.
+  * @note   Signal is the AC power of the source, so a DC offset does not
+  *         flatter the figure. Two passes: the mean first, then the
+  *         deviations from it, so each term is below 2^32 and the 64-bit sums
+  *         hold for any Count.
+  * @param  pSrc: original channel, right aligned 12-bit codes.
+  * @param  Stride: distance between consecutive source samples.
+  * @param  pDecoded: ADP_Decode() output for the same samples.
+  * @param  Count: samples.
+  * @retval SNR in hundredths of a dB.
+  */
+int32_t ADP_Snr(const uint16_t* pSrc, uint32_t Stride, const int16_t* pDecoded, uint32_t Count)
+{
+  const uint16_t* p = pSrc;
+  int64_t sum = 0;
+  uint64_t sum2 = 0;
+  uint64_t err = 0;
+  uint64_t rem;
+  int32_t mean, x, e;
+  uint32_t n;
+
+  if (Count == 0)
+  {
+    return 0;
+  }
+  for (n = 0; n < Count; n++)
+  {
+    sum += ADP_ADC12_TO_PCM(*p);
+    p += Stride;
+  }
+  /* Floor of the mean, so rem = sum - mean * Count is in [0, Count) */
+  mean = (int32_t)(sum / (int64_t)Count);
+  if ((int64_t)mean * Count > sum)
+  {
+    mean--;
+  }
+  rem = (uint64_t)(sum - (int64_t)mean * Count);
+  p = pSrc;
+  for (n = 0; n < Count; n++)
+  {
+    x = ADP_ADC12_TO_PCM(*p) - mean;
+    p += Stride;
+    e = x + mean - pDecoded[n];
+    sum2 += (uint64_t)((int64_t)x * x);
+    err += (uint64_t)((int64_t)e * e);
+  }
+  /* Count times the variance, against the error energy */
+  sum2 -= (rem * rem) / Count;
+  if (err == 0)
+  {
+    err = 1;
+  }
+  /* 10 * log10(x) = 3.0103 * log2(x) */
+  return (int32_t)((((int64_t)NC_Log2Q16(sum2) - NC_Log2Q16(err)) * 30103) / 6553600);
+}
+
+/**
+  * @brief  Reconstructs the next sample from a nibble and adapts the step.
+  * @param  ADPx: pointer to the state.
+  * @param  Nibble: sign in bit 3, magnitude in bits 2..0.
+  * @retval None
+  */
+static void ADP_Update(ADP_StateTypeDef* ADPx, uint32_t Nibble)
+{
+  uint32_t step = ADP_StepTable[ADPx->Index];
+  int32_t diff = step >> 3;
+  int32_t pred;
+  int32_t index;
+
+  if (Nibble & 4)
+  {
+    diff += step;
+  }
+  if (Nibble & 2)
+  {
+    diff += step >> 1;
+  }
+  if (Nibble & 1)
+  {
+    diff += step >> 2;
+  }
+  pred = ADPx->Predictor + ((Nibble & 8) ? -diff : diff);
+  ADPx->Predictor = (int16_t)((pred > 32767) ? 32767 : (pred < -32768) ? -32768 : pred);
+  index = ADPx->Index + ADP_IndexTable[Nibble & 7];
+  ADPx->Index = (int8_t)((index < 0) ? 0 : (index > ADP_INDEX_MAX) ? ADP_INDEX_MAX : index);
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,81 @@
+/**
+ * @file    nc_adpcm.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   IMA-ADPCM codec for audio-band channels
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_ADPCM_H
+#define NC_ADPCM_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_ADPCM_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  Codec state of one channel, the same on both sides.
+  * @note   Sending it ahead of a block lets the decoder start at that block.
+  */
+typedef struct
+{
+  int16_t Predictor;          /*!< Last reconstructed sample, 16-bit PCM */
+  int8_t  Index;              /*!< Step table index, 0 .. 88 */
+}ADP_StateTypeDef;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Bytes for Count samples, two per byte */
+#define ADP_BYTES(COUNT)              (((uint32_t)(COUNT) + 1) / 2)
+
+/* 12-bit code to 16-bit PCM and back */
+#define ADP_ADC12_TO_PCM(CODE)        ((int16_t)(((int32_t)(CODE) - 2048) * 16))
+#define ADP_PCM_TO_ADC12(PCM)         ((uint16_t)(((int32_t)(PCM) >> 4) + 2048))
+
+/* Exported functions ------------------------------------------------------- */
+void ADP_Init(ADP_StateTypeDef* ADPx);
+void ADP_Encode(ADP_StateTypeDef* ADPx, const uint16_t* pSrc, uint32_t Stride, uint32_t Count, uint8_t* pDst);
+void ADP_Decode(ADP_StateTypeDef* ADPx, const uint8_t* pSrc, uint32_t Count, int16_t* pDst);
+int32_t ADP_Snr(const uint16_t* pSrc, uint32_t Stride, const int16_t* pDecoded, uint32_t Count);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_ADPCM_H */
@@ -0,0 +1,153 @@
+/**
+ * @file    nc_biquad.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Q31 biquad IIR cascade for per-channel conditioning
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_biquad.h"
+
+/** @defgroup BIQ
+  * @brief Biquad IIR cascade
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] Declare the coefficient tables with the build-time generators, e.g. a
+         50 Hz notch followed by a 200 Hz low-pass at 1 kHz:
+           static const int32_t Ch0Coeffs[] = { BIQ_NOTCH(50, 1000, 10),
+                                                BIQ_LOWPASS(200, 1000, 0.7071) };
+         then one BIQ_ChannelTypeDef per scan rank and a state array of
+         BIQ_STATE_PER_STAGE words per stage of every channel.
+    [..] BIQ_ProcessBlock() takes a whole interleaved DMA block (Frames scans of
+         NumChannels 12-bit samples) and writes Q31 results with the same layout.
+    [..] Direct form I with a 64-bit accumulator: five SMLAL per stage and sample,
+         no internal overflow, a single rounding per stage.
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Binds the channel filters and clears the whole state array.
+  * @param  BIQx: pointer to the filter bank.
+  * @param  pChannels: NumChannels channel descriptors, in scan rank order.
+  * @param  pState: BIQ_STATE_PER_STAGE words for every stage of every channel.
+  * @param  NumChannels: number of ranks in the interleaved block.
+  * @retval None
+  */
+void BIQ_Init(BIQ_CascadeTypeDef* BIQx, const BIQ_ChannelTypeDef* pChannels, int32_t* pState, uint8_t NumChannels)
+{
+  uint32_t ch;
+  uint32_t i;
+  uint32_t words = 0;
+
+  BIQx->pChannels   = pChannels;
+  BIQx->pState      = pState;
+  BIQx->NumChannels = NumChannels;
+
+  for (ch = 0; ch < NumChannels; ch++)
+  {
+    words += (uint32_t)pChannels[ch].NumStages * BIQ_STATE_PER_STAGE;
+  }
+  for (i = 0; i < words; i++)
+  {
+    pState[i] = 0;
+  }
+}
+
+/**
+  * @brief  Filters an interleaved block, every channel through its own cascade.
+  * @param  BIQx: pointer to the filter bank.
+  * @param  pSrc: Frames * NumChannels 12-bit ADC codes, scan order.
+  * @param  pDst: Frames * NumChannels Q31 outputs, same order.
+  * @param  Frames: number of complete scans in the block.
+  * @retval None
+  */
+void BIQ_ProcessBlock(BIQ_CascadeTypeDef* BIQx, const uint16_t* pSrc, int32_t* pDst, uint32_t Frames)
+{
+  const BIQ_ChannelTypeDef* chan;
+  const int32_t* c;
+  int32_t* s;
+  int32_t* state;
+  uint32_t nch = BIQx->NumChannels;
+  uint32_t ch, stage, n;
+  int32_t x, y;
+  int64_t acc;
+
+  /* Channel-outer loop: one channel's coefficient and state pointers are set up
+     once per block while its samples are picked out of the block by stride */
+  state = BIQx->pState;
+  for (ch = 0; ch < nch; ch++)
+  {
+    chan = &BIQx->pChannels[ch];
+    for (n = 0; n < Frames; n++)
+    {
+      x = BIQ_ADC12_TO_Q31(pSrc[n * nch + ch]);
+      c = chan->pCoeffs;
+      s = state;
+      for (stage = 0; stage < chan->NumStages; stage++)
+      {
+        acc  = (int64_t)c[0] * x;
+        acc += (int64_t)c[1] * s[0];
+        acc += (int64_t)c[2] * s[1];
+        acc += (int64_t)c[3] * s[2];
+        acc += (int64_t)c[4] * s[3];
+        acc  = (acc + (1LL << (BIQ_COEFF_SHIFT - 1))) >> BIQ_COEFF_SHIFT;
+        y = NC_SAT_Q31(acc);
+        s[1] = s[0];
+        s[0] = x;
+        s[3] = s[2];
+        s[2] = y;
+        x = y;
+        c += BIQ_COEFFS_PER_STAGE;
+        s += BIQ_STATE_PER_STAGE;
+      }
+      pDst[n * nch + ch] = x;
+    }
+    state += (uint32_t)chan->NumStages * BIQ_STATE_PER_STAGE;
+  }
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,116 @@
+/**
+ * @file    nc_biquad.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Q31 biquad IIR cascade for per-channel conditioning
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_BIQUAD_H
+#define NC_BIQUAD_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_BIQUAD_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "nc_fixmath.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define BIQ_COEFFS_PER_STAGE          5       /*!< b0, b1, b2, -a1, -a2 */
+#define BIQ_STATE_PER_STAGE           4       /*!< x[n-1], x[n-2], y[n-1], y[n-2] */
+#define BIQ_COEFF_SHIFT               30      /*!< Coefficients are Q2.30 so |a1| up to 2 fits */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  Filter of one channel: NumStages direct-form I sections in series.
+  */
+typedef struct
+{
+  const int32_t* pCoeffs;     /*!< BIQ_COEFFS_PER_STAGE Q2.30 values per stage */
+  uint8_t NumStages;          /*!< 0 passes the channel through unfiltered */
+}BIQ_ChannelTypeDef;
+
+/**
+  * @brief  Filter bank for an interleaved scan of NumChannels ranks.
+  * @note   pState holds the sections of channel 0, then channel 1, ... with
+  *         BIQ_STATE_PER_STAGE words per section, so a channel's whole history
+  *         sits in consecutive words.
+  */
+typedef struct
+{
+  const BIQ_ChannelTypeDef* pChannels;
+  int32_t* pState;
+  uint8_t NumChannels;
+}BIQ_CascadeTypeDef;
+
+/* Exported macro ------------------------------------------------------------*/
+/**
+ * @brief  Build-time coefficient generators (RBJ audio EQ cookbook designs)
+ * @note   Each expands to one stage worth of initializers for a static const
+ *         int32_t table, folded by the compiler: F0 and FS in Hz, Q the quality factor.
+ */
+#define BIQ_W0(F0, FS)                (2.0 * NC_PI * (double)(F0) / (double)(FS))
+#define BIQ_COSW0(F0, FS)             NC_CCOS(BIQ_W0(F0, FS))
+#define BIQ_ALPHA(F0, FS, Q)          (NC_CSIN(BIQ_W0(F0, FS)) / (2.0 * (double)(Q)))
+#define BIQ_A0(F0, FS, Q)             (1.0 + BIQ_ALPHA(F0, FS, Q))
+
+#define BIQ_LOWPASS(F0, FS, Q)                                                       \
+  NC_Q30((1.0 - BIQ_COSW0(F0, FS)) / 2.0 / BIQ_A0(F0, FS, Q)),                       \
+  NC_Q30((1.0 - BIQ_COSW0(F0, FS)) / BIQ_A0(F0, FS, Q)),                             \
+  NC_Q30((1.0 - BIQ_COSW0(F0, FS)) / 2.0 / BIQ_A0(F0, FS, Q)),                       \
+  NC_Q30(2.0 * BIQ_COSW0(F0, FS) / BIQ_A0(F0, FS, Q)),                               \
+  NC_Q30(-(1.0 - BIQ_ALPHA(F0, FS, Q)) / BIQ_A0(F0, FS, Q))
+
+#define BIQ_NOTCH(F0, FS, Q)                                                         \
+  NC_Q30(1.0 / BIQ_A0(F0, FS, Q)),                                                   \
+  NC_Q30(-2.0 * BIQ_COSW0(F0, FS) / BIQ_A0(F0, FS, Q)),                              \
+  NC_Q30(1.0 / BIQ_A0(F0, FS, Q)),                                                   \
+  NC_Q30(2.0 * BIQ_COSW0(F0, FS) / BIQ_A0(F0, FS, Q)),                               \
+  NC_Q30(-(1.0 - BIQ_ALPHA(F0, FS, Q)) / BIQ_A0(F0, FS, Q))
+
+/* 12-bit right aligned ADC code to Q31, mid-scale maps to 0 */
+#define BIQ_ADC12_TO_Q31(CODE)        ((int32_t)(((uint32_t)(CODE) - 2048UL) << 20))
+
+/* Exported functions ------------------------------------------------------- */
+void BIQ_Init(BIQ_CascadeTypeDef* BIQx, const BIQ_ChannelTypeDef* pChannels, int32_t* pState, uint8_t NumChannels);
+void BIQ_ProcessBlock(BIQ_CascadeTypeDef* BIQx, const uint16_t* pSrc, int32_t* pDst, uint32_t Frames);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_BIQUAD_H */
@@ -0,0 +1,417 @@
+/**
+ * @file    nc_capture.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Pre/post-trigger capture engine
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_capture.h"
+#include "nc_pack12.h"
+#include "nc_stm32l1_adc.h"
+#include "nc_stm32l1_dma.h"
+#include "nc_stm32l1_rcc.h"
+
+/** @defgroup CAP
+  * @brief Oscilloscope mode: pre/post-trigger windows, zero copy
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] Give CAP_Init() a pool of 2 to CAP_POOL_SIZE buffers of Length samples,
+         the post-trigger count and the scan length. Length must be a multiple
+         of the scan length and Post at most Length less one scan, since the
+         stop point is rounded up to a whole scan; CAP_Init() returns -1
+         otherwise. CAP_Start() points
+         DMA1_Channel1 at the first buffer in circular mode: the buffer itself is
+         the pre-trigger ring, there is no second copy of the data. Call
+         CAP_DMAIRQHandler() from DMA1_Channel1_IRQHandler.
+    [..] CAP_Trigger() from software, or from ADC1_IRQHandler on AWD after
+         CAP_WatchdogTrigger(), marks the write position and reprograms the
+         running transfer to stop exactly Post samples later (rounded up to a
+         whole scan). The DMA interrupt then freezes the buffer as a record and
+         points the DMA at the next free buffer, so the next pre-trigger ring is
+         filling again within one interrupt.
+    [..] The consumer takes records with CAP_GetCapture(), reads the window in
+         place and gives the buffer back with CAP_Release(). With every buffer
+         held, the engine idles (State IDLE) and counts each trigger it rejects
+         there as a Missed window. The DMA keeps serving the ADC into a
+         one-scan scratch ring meanwhile, so the ADC does not overrun and the
+         scan position is not lost: CAP_Release() restarts the engine at the
+         next scan boundary, and index i of every buffer still holds rank
+         i % NumRegular.
+    [..] To keep a window longer than the pool allows, CAP_Pack() copies it
+         into the caller's 12-bit storage, and the buffer can be released
+         straight away. The pool itself stays uint16_t, as the DMA writes it.
+    [..] Each reprogramming disables the channel for a few bus cycles, well
+         inside one conversion, so no sample is lost as long as the ADC is not
+         converting faster than the interrupt latency.
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define CAP_QUEUE_MASK            (CAP_POOL_SIZE - 1)
+#define CAP_CCR_BASE              (DMA_CCR1_MINC | DMA_CCR1_PSIZE_0 | DMA_CCR1_MSIZE_0 | DMA_CCR1_PL_1)
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void CAP_Arm(CAP_EngineTypeDef* CAPx);
+static void CAP_Program(CAP_EngineTypeDef* CAPx, uint32_t Index, uint32_t Count, uint32_t Ccr);
+static void CAP_Park(CAP_EngineTypeDef* CAPx, uint32_t Index, uint32_t Ccr);
+static void CAP_Freeze(CAP_EngineTypeDef* CAPx);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Binds the buffer pool; the engine stays idle until CAP_Start().
+  * @param  CAPx: pointer to the engine.
+  * @param  ppBuffers: NumBuffers buffers of Length samples.
+  * @param  NumBuffers: 2 to CAP_POOL_SIZE.
+  * @param  Length: samples per buffer, a multiple of NumRegular.
+  * @param  Post: post-trigger samples, 1 to Length - NumRegular.
+  * @param  NumRegular: ranks in the regular scan, 1 to CAP_MAX_REGULAR.
+  * @retval 0 on success, -1 if a parameter is out of range.
+  */
+int32_t CAP_Init(CAP_EngineTypeDef* CAPx, uint16_t* const* ppBuffers, uint8_t NumBuffers, uint16_t Length, uint16_t Post, uint8_t NumRegular)
+{
+  uint32_t n;
+
+  if ((NumBuffers < 2) || (NumBuffers > CAP_POOL_SIZE) || (NumRegular == 0) || (NumRegular > CAP_MAX_REGULAR) ||
+      ((Length % NumRegular) != 0) || (Post == 0) || (Post > Length - NumRegular))
+  {
+    return -1;
+  }
+  for (n = 0; n < NumBuffers; n++)
+  {
+    CAPx->Pool[n] = ppBuffers[n];
+  }
+  CAPx->NumBuffers = NumBuffers;
+  CAPx->Free = (1UL << NumBuffers) - 1;
+  CAPx->Head = 0;
+  CAPx->Tail = 0;
+  CAPx->State = CAP_STATE_IDLE;
+  CAPx->Sequence = 0;
+  CAPx->Missed = 0;
+  CAPx->Length = Length;
+  CAPx->Post = Post;
+  CAPx->NumRegular = NumRegular;
+  return 0;
+}
+
+/**
+  * @brief  Starts free-running into the first free buffer.
+  * @note   ADC1 must issue DMA requests (ADC_CR2 DMA and DDS) and the
+  *         DMA1_Channel1 interrupt must be enabled in the NVIC.
+  * @param  CAPx: pointer to the engine.
+  * @retval None
+  */
+void CAP_Start(CAP_EngineTypeDef* CAPx)
+{
+  RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+  DMA_DeInit(DMA1_Channel1);
+  DMA1_Channel1->CPAR = (uint32_t)&ADC1->DR;
+  CAP_Arm(CAPx);
+}
+
+/**
+  * @brief  Trigger: keeps the last Length - Post samples, captures Post more.
+  * @note   Safe from any context, it masks interrupts while it reprograms the
+  *         channel. Triggers while a window is completing are ignored; triggers
+  *         while the engine is idle for want of a buffer count as Missed.
+  * @param  CAPx: pointer to the engine.
+  * @retval 1 if the trigger was accepted, 0 otherwise.
+  */
+uint32_t CAP_Trigger(CAP_EngineTypeDef* CAPx)
+{
+  uint32_t primask = __get_PRIMASK();
+  uint32_t pos, end, scan, keep;
+
+  __disable_irq();
+  if (CAPx->State != CAP_STATE_ARMED)
+  {
+    if (CAPx->State == CAP_STATE_IDLE)
+    {
+      CAPx->Missed++;                           /* Every buffer is held by the consumer */
+    }
+    __set_PRIMASK(primask);
+    return 0;
+  }
+  DMA1_Channel1->CCR &= ~DMA_CCR1_EN;
+  if ((DMA1->ISR & DMA1_IT_TC(1)) != 0)
+  {
+    /* Wrap not yet seen by the interrupt, it must not count as post-trigger */
+    DMA1->IFCR = DMA1_IT_TC(1) | DMA1_IT_HT(1);
+    CAPx->Written = CAPx->Length;
+  }
+  pos = CAPx->Length - DMA1_Channel1->CNDTR;    /* Next sample the DMA would write */
+  if (pos == CAPx->Length)
+  {
+    pos = 0;
+  }
+  /* End on a scan boundary so the next buffer starts with rank 0 */
+  scan = CAPx->NumRegular;
+  end = pos + CAPx->Post;
+  end += (scan - end % scan) % scan;
+  keep = CAPx->Length - (end - pos);
+  CAPx->Trigger = (uint16_t)pos;
+  CAPx->Pre = (uint16_t)((CAPx->Written + pos < keep) ? CAPx->Written + pos : keep);
+  CAPx->Remaining = (uint16_t)(end - pos);
+  CAPx->State = CAP_STATE_TRIGGERED;
+  CAP_Program(CAPx, pos, CAPx->Remaining, CAP_CCR_BASE | DMA_CCR1_TCIE);
+  __set_PRIMASK(primask);
+  return 1;
+}
+
+/**
+  * @brief  Lets the analog watchdog trigger captures on one channel.
+  * @note   Call CAP_Trigger() from ADC1_IRQHandler when ADC_SR AWD is set, and
+  *         clear AWD there.
+  * @param  ADC_Channel: guarded channel.
+  * @param  LowThreshold: trigger below, 12-bit.
+  * @param  HighThreshold: trigger above, 12-bit.
+  * @retval None
+  */
+void CAP_WatchdogTrigger(uint8_t ADC_Channel, uint16_t LowThreshold, uint16_t HighThreshold)
+{
+  ADC_AnalogWatchdogThresholdsConfig(ADC1, HighThreshold, LowThreshold);
+  ADC_AnalogWatchdogSingleChannelConfig(ADC1, ADC_Channel);
+  ADC_AnalogWatchdogCmd(ADC1, ADC_AnalogWatchdog_SingleRegEnable);
+  ADC_ITConfig(ADC1, ADC_IT_AWD, ENABLE);
+}
+
+/**
+  * @brief  DMA1 channel 1 interrupt body in capture mode.
+  * @param  CAPx: pointer to the engine.
+  * @retval None
+  */
+void CAP_DMAIRQHandler(CAP_EngineTypeDef* CAPx)
+{
+  uint32_t isr = DMA1->ISR;
+
+  /* Clear only what was seen: GL would also clear a TC raised since the read */
+  DMA1->IFCR = isr & (DMA1_IT_TC(1) | DMA1_IT_HT(1));
+  if ((isr & DMA1_IT_TC(1)) == 0)
+  {
+    return;
+  }
+  if (CAPx->State == CAP_STATE_ARMED)
+  {
+    CAPx->Written = CAPx->Length;               /* The pre-trigger ring is full */
+  }
+  else if (CAPx->State == CAP_STATE_IDLE)
+  {
+    CAP_Arm(CAPx);                              /* Scan boundary after CAP_Release() */
+  }
+  else if (CAPx->State == CAP_STATE_TRIGGERED)
+  {
+    CAPx->Remaining -= CAPx->Segment;
+    if (CAPx->Remaining != 0)
+    {
+      /* Post-trigger run wrapped past the end of the buffer */
+      CAP_Program(CAPx, 0, CAPx->Remaining, CAP_CCR_BASE | DMA_CCR1_TCIE);
+    }
+    else
+    {
+      CAP_Freeze(CAPx);
+      CAP_Arm(CAPx);
+    }
+  }
+}
+
+/**
+  * @brief  Takes the oldest frozen capture.
+  * @param  CAPx: pointer to the engine.
+  * @param  pRecord: receives the record, its buffer stays owned until CAP_Release().
+  * @retval 1 if a capture was returned, 0 if none is ready.
+  */
+uint32_t CAP_GetCapture(CAP_EngineTypeDef* CAPx, CAP_RecordTypeDef* pRecord)
+{
+  uint32_t tail = CAPx->Tail;
+
+  if (tail == CAPx->Head)
+  {
+    return 0;
+  }
+  *pRecord = CAPx->Ready[tail & CAP_QUEUE_MASK];
+  CAPx->Tail = tail + 1;
+  return 1;
+}
+
+/**
+  * @brief  Returns a capture buffer to the pool, restarting an idle engine at
+  *         the next scan boundary.
+  * @param  CAPx: pointer to the engine.
+  * @param  pRecord: record from CAP_GetCapture().
+  * @retval None
+  */
+void CAP_Release(CAP_EngineTypeDef* CAPx, const CAP_RecordTypeDef* pRecord)
+{
+  uint32_t primask = __get_PRIMASK();
+  uint32_t n, pos;
+
+  for (n = 0; n < CAPx->NumBuffers; n++)
+  {
+    if (CAPx->Pool[n] == pRecord->pBuffer)
+    {
+      break;
+    }
+  }
+  if (n == CAPx->NumBuffers)
+  {
+    return;
+  }
+  __disable_irq();
+  CAPx->Free |= 1UL << n;
+  if (CAPx->State == CAP_STATE_IDLE)
+  {
+    /* Run the scratch ring to the end of the scan in progress, its TC arms */
+    DMA1_Channel1->CCR &= ~DMA_CCR1_EN;
+    DMA1->IFCR = DMA1_IT_TC(1) | DMA1_IT_HT(1);
+    pos = CAPx->NumRegular - DMA1_Channel1->CNDTR;
+    if (pos == CAPx->NumRegular)
+    {
+      pos = 0;
+    }
+    CAP_Park(CAPx, pos, CAP_CCR_BASE | DMA_CCR1_TCIE);
+  }
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Packs a frozen window to 12 bits, 1.5 bytes per sample.
+  * @note   The copy keeps buffer order, so Start, Trigger and Pre still index
+  *         it: sample i of the window is P12_Get(pDst, (Start + i) % Length).
+  * @param  pRecord: record from CAP_GetCapture(), not yet released.
+  * @param  pDst: P12_WORDS(Length) words.
+  * @retval None
+  */
+void CAP_Pack(const CAP_RecordTypeDef* pRecord, uint32_t* pDst)
+{
+  P12_Pack(pRecord->pBuffer, pDst, pRecord->Length);
+}
+
+/**
+  * @brief  Points the DMA at a free buffer in circular mode, or idles.
+  * @note   Runs with the DMA interrupt masked or from it, on a scan boundary.
+  * @param  CAPx: pointer to the engine.
+  * @retval None
+  */
+static void CAP_Arm(CAP_EngineTypeDef* CAPx)
+{
+  uint32_t free = CAPx->Free;
+  uint32_t n = 0;
+
+  if (free == 0)
+  {
+    CAPx->State = CAP_STATE_IDLE;
+    CAP_Park(CAPx, 0, CAP_CCR_BASE | DMA_CCR1_CIRC);
+    return;
+  }
+  while ((free & (1UL << n)) == 0)
+  {
+    n++;
+  }
+  CAPx->Free = free & ~(1UL << n);
+  CAPx->Active = (uint8_t)n;
+  CAPx->Written = 0;
+  CAPx->State = CAP_STATE_ARMED;
+  CAP_Program(CAPx, 0, CAPx->Length, CAP_CCR_BASE | DMA_CCR1_CIRC | DMA_CCR1_TCIE);
+}
+
+/**
+  * @brief  Restarts the channel on Count samples at Index of the active buffer.
+  * @param  CAPx: pointer to the engine.
+  * @param  Index: first sample to write.
+  * @param  Count: samples to transfer, never past the end of the buffer.
+  * @param  Ccr: channel configuration without EN.
+  * @retval None
+  */
+static void CAP_Program(CAP_EngineTypeDef* CAPx, uint32_t Index, uint32_t Count, uint32_t Ccr)
+{
+  if (Count > (uint32_t)CAPx->Length - Index)
+  {
+    Count = CAPx->Length - Index;
+  }
+  CAPx->Segment = (uint16_t)Count;
+  DMA1_Channel1->CCR = Ccr;                     /* EN clear: CMAR, CNDTR and CIRC are writable */
+  DMA1_Channel1->CMAR = (uint32_t)(CAPx->Pool[CAPx->Active] + Index);
+  DMA1_Channel1->CNDTR = Count;
+  DMA1_Channel1->CCR = Ccr | DMA_CCR1_EN;
+}
+
+/**
+  * @brief  Restarts the channel on the scratch ring, from Index to the end of
+  *         the scan.
+  * @param  CAPx: pointer to the engine.
+  * @param  Index: rank the next conversion belongs to.
+  * @param  Ccr: channel configuration without EN.
+  * @retval None
+  */
+static void CAP_Park(CAP_EngineTypeDef* CAPx, uint32_t Index, uint32_t Ccr)
+{
+  DMA1_Channel1->CCR = Ccr;
+  DMA1_Channel1->CMAR = (uint32_t)(CAPx->Scratch + Index);
+  DMA1_Channel1->CNDTR = CAPx->NumRegular - Index;
+  DMA1_Channel1->CCR = Ccr | DMA_CCR1_EN;
+}
+
+/**
+  * @brief  Queues the active buffer as a finished window.
+  * @param  CAPx: pointer to the engine.
+  * @retval None
+  */
+static void CAP_Freeze(CAP_EngineTypeDef* CAPx)
+{
+  uint32_t head = CAPx->Head;
+  uint32_t start = CAPx->Trigger + CAPx->Length - CAPx->Pre;
+  CAP_RecordTypeDef* r;
+
+  /* The queue holds CAP_POOL_SIZE records and every record owns a buffer, so it cannot overflow */
+  r = &CAPx->Ready[head & CAP_QUEUE_MASK];
+  r->pBuffer = CAPx->Pool[CAPx->Active];
+  r->Sequence = CAPx->Sequence++;
+  r->Length = CAPx->Length;
+  r->Trigger = CAPx->Trigger;
+  r->Pre = CAPx->Pre;
+  r->Start = (uint16_t)((start >= CAPx->Length) ? start - CAPx->Length : start);
+  CAPx->Head = head + 1;
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,116 @@
+/**
+ * @file    nc_capture.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Pre/post-trigger capture engine
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_CAPTURE_H
+#define NC_CAPTURE_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_CAPTURE_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l1xx.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define CAP_POOL_SIZE                 4       /*!< Capture buffers, power of two */
+#define CAP_MAX_REGULAR               28      /*!< Regular ranks, SQ1..SQ28 */
+
+#define CAP_STATE_IDLE                0       /*!< Every buffer held, DMA parked on Scratch */
+#define CAP_STATE_ARMED               1       /*!< Free-running into the pre-trigger ring */
+#define CAP_STATE_TRIGGERED           2       /*!< Counting post-trigger samples */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  One frozen capture window, the buffer the DMA wrote it into.
+  * @note   The window is circular: Length samples starting at Start and
+  *         wrapping at the end of pBuffer. Index i holds rank i % NumRegular.
+  */
+typedef struct
+{
+  uint16_t* pBuffer;
+  uint32_t Sequence;          /*!< Capture number */
+  uint16_t Length;            /*!< Samples in the window, the whole buffer */
+  uint16_t Start;             /*!< Oldest sample */
+  uint16_t Trigger;           /*!< First sample converted after the trigger */
+  uint16_t Pre;               /*!< Valid samples before Trigger, less than asked if triggered early */
+}CAP_RecordTypeDef;
+
+/**
+  * @brief  Capture engine state.
+  */
+typedef struct
+{
+  uint16_t* Pool[CAP_POOL_SIZE];
+  uint16_t Scratch[CAP_MAX_REGULAR];  /*!< One scan, written while idle so the ADC never overruns */
+  CAP_RecordTypeDef Ready[CAP_POOL_SIZE];
+  volatile uint32_t Head;     /*!< Frozen captures, written by the DMA interrupt */
+  volatile uint32_t Tail;     /*!< Written by the consumer */
+  volatile uint32_t Free;     /*!< Bit n set: Pool[n] can be written */
+  volatile uint32_t State;    /*!< CAP_STATE_x */
+  uint32_t Sequence;
+  uint32_t Missed;            /*!< Triggers rejected while idle because no buffer was free */
+  uint32_t Written;           /*!< 0 until the active buffer has wrapped once, then Length */
+  uint16_t Length;            /*!< Samples per buffer, a multiple of NumRegular */
+  uint16_t Post;              /*!< Post-trigger samples, at most Length - NumRegular */
+  uint16_t Remaining;         /*!< Post-trigger samples not yet programmed */
+  uint16_t Segment;           /*!< Samples programmed in the running DMA transfer */
+  uint16_t Trigger;
+  uint16_t Pre;
+  uint8_t  Active;            /*!< Pool index the DMA writes */
+  uint8_t  NumRegular;        /*!< Ranks in the regular scan */
+  uint8_t  NumBuffers;        /*!< Entries of Pool in use */
+}CAP_EngineTypeDef;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+int32_t CAP_Init(CAP_EngineTypeDef* CAPx, uint16_t* const* ppBuffers, uint8_t NumBuffers, uint16_t Length, uint16_t Post, uint8_t NumRegular);
+void CAP_Start(CAP_EngineTypeDef* CAPx);
+uint32_t CAP_Trigger(CAP_EngineTypeDef* CAPx);
+void CAP_WatchdogTrigger(uint8_t ADC_Channel, uint16_t LowThreshold, uint16_t HighThreshold);
+void CAP_DMAIRQHandler(CAP_EngineTypeDef* CAPx);
+uint32_t CAP_GetCapture(CAP_EngineTypeDef* CAPx, CAP_RecordTypeDef* pRecord);
+void CAP_Release(CAP_EngineTypeDef* CAPx, const CAP_RecordTypeDef* pRecord);
+void CAP_Pack(const CAP_RecordTypeDef* pRecord, uint32_t* pDst);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_CAPTURE_H */
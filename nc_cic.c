@@ -0,0 +1,178 @@
+/**
+ * @file    nc_cic.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Fixed-point CIC decimator for the ADC sample stream
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_cic.h"
+
+/** @defgroup CIC
+  * @brief Cascaded integrator-comb decimator
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] CIC_Init() once per channel, then CIC_Decimate() on each DMA block.
+         Interleaved scan blocks are read in place: pass the address of the
+         channel's first sample and the number of ranks as Stride.
+    [..] Cost: N integrator adds per input sample plus N comb subtracts per output
+         sample, i.e. N * (1 + 1/R) adds per input and no multiply. The output is
+         scaled back to the input range by a shift of ceil(log2(R^N)): the DC
+         gain R^N / 2^Shift is 1 when R is a power of two and between 1/2 and 1
+         otherwise (R = 5, N = 3: 125/128).
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Resets a decimator and sets its order and rate change.
+  * @param  CICx: pointer to the decimator state.
+  * @param  Stages: number of integrator/comb pairs, 1 to CIC_MAX_STAGES.
+  * @param  Rate: decimation factor, 2 or more.
+  * @retval 0 on success, -1 if the register growth R^N does not fit in 32 bits.
+  */
+int32_t CIC_Init(CIC_TypeDef* CICx, uint8_t Stages, uint16_t Rate)
+{
+  uint32_t i;
+  uint32_t bits = 0;
+  uint32_t gain = 1;
+
+  if ((Stages == 0) || (Stages > CIC_MAX_STAGES) || (Rate < 2))
+  {
+    return -1;
+  }
+  for (i = 0; i < Stages; i++)        /* R^N, the DC gain */
+  {
+    if (gain > (1UL << (32 - CIC_INPUT_BITS)) / Rate)
+    {
+      return -1;
+    }
+    gain *= Rate;
+  }
+  while ((1UL << bits) < gain)        /* ceil(log2(R^N)) */
+  {
+    bits++;
+  }
+
+  CICx->Stages = Stages;
+  CICx->Shift  = (uint8_t)bits;
+  CICx->Rate   = Rate;
+  CICx->Phase  = 0;
+  for (i = 0; i < CIC_MAX_STAGES; i++)
+  {
+    CICx->Integ[i] = 0;
+    CICx->Comb[i]  = 0;
+  }
+  CICx->CompHook    = NULL;
+  CICx->CompContext = NULL;
+  return 0;
+}
+
+/**
+  * @brief  Installs the compensation filter run on every block of outputs.
+  * @param  CICx: pointer to the decimator state.
+  * @param  Hook: compensation function, NULL to remove it.
+  * @param  Context: user pointer handed back to Hook.
+  * @retval None
+  */
+void CIC_SetCompHook(CIC_TypeDef* CICx, CIC_CompHookTypeDef Hook, void* Context)
+{
+  CICx->CompHook    = Hook;
+  CICx->CompContext = Context;
+}
+
+/**
+  * @brief  Filters and decimates a block of ADC samples.
+  * @param  CICx: pointer to the decimator state.
+  * @param  pSrc: first sample of this channel in the DMA block.
+  * @param  Stride: distance between consecutive samples (1, or the scan length).
+  * @param  Count: number of input samples of this channel.
+  * @param  pDst: output buffer, at least Count / Rate + 1 entries.
+  * @retval Number of output samples written.
+  */
+uint32_t CIC_Decimate(CIC_TypeDef* CICx, const uint16_t* pSrc, uint32_t Stride, uint32_t Count, int32_t* pDst)
+{
+  uint32_t* integ = CICx->Integ;
+  uint32_t* comb  = CICx->Comb;
+  uint32_t  stages = CICx->Stages;
+  uint32_t  phase  = CICx->Phase;
+  uint32_t  produced = 0;
+  uint32_t  acc, prev, k;
+
+  while (Count-- != 0)
+  {
+    /* Integrator section, running at the input rate */
+    acc = *pSrc;
+    pSrc += Stride;
+    for (k = 0; k < stages; k++)
+    {
+      integ[k] += acc;
+      acc = integ[k];
+    }
+
+    /* Comb section, running at the output rate */
+    if (++phase == CICx->Rate)
+    {
+      phase = 0;
+      for (k = 0; k < stages; k++)
+      {
+        prev = comb[k];
+        comb[k] = acc;
+        acc -= prev;
+      }
+      pDst[produced++] = (int32_t)(acc >> CICx->Shift);
+    }
+  }
+  CICx->Phase = (uint16_t)phase;
+
+  if ((CICx->CompHook != NULL) && (produced != 0))
+  {
+    CICx->CompHook(pDst, produced, CICx->CompContext);
+  }
+  return produced;
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
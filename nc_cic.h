@@ -0,0 +1,90 @@
+/**
+ * @file    nc_cic.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Fixed-point CIC decimator for the ADC sample stream
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_CIC_H
+#define NC_CIC_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_CIC_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define CIC_MAX_STAGES                5
+#define CIC_INPUT_BITS                12      /*!< ADC_Resolution_12b right aligned samples */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  Compensation hook, called once per CIC_Decimate() on the new outputs.
+  * @note   Typically a short FIR correcting the sinc^N droop, working in place.
+  */
+typedef void (*CIC_CompHookTypeDef)(int32_t* pBlock, uint32_t Count, void* Context);
+
+/**
+  * @brief  CIC decimator state (differential delay M = 1).
+  * @note   Integrators and combs use modulo 2^32 arithmetic: the wrap-around
+  *         cancels out as long as CIC_INPUT_BITS + log2(Rate^Stages) <= 32.
+  */
+typedef struct
+{
+  uint8_t  Stages;                      /*!< N, 1 to CIC_MAX_STAGES */
+  uint8_t  Shift;                       /*!< Output right shift, ceil(log2(Rate^N)): DC gain Rate^N / 2^Shift, in (1/2, 1] */
+  uint16_t Rate;                        /*!< Decimation factor R */
+  uint16_t Phase;                       /*!< Input samples since the last output */
+  uint32_t Integ[CIC_MAX_STAGES];       /*!< Integrator accumulators */
+  uint32_t Comb[CIC_MAX_STAGES];        /*!< Comb delay elements */
+  CIC_CompHookTypeDef CompHook;         /*!< Optional compensation filter, NULL if unused */
+  void*    CompContext;                 /*!< Passed back to CompHook */
+}CIC_TypeDef;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+int32_t CIC_Init(CIC_TypeDef* CICx, uint8_t Stages, uint16_t Rate);
+void CIC_SetCompHook(CIC_TypeDef* CICx, CIC_CompHookTypeDef Hook, void* Context);
+uint32_t CIC_Decimate(CIC_TypeDef* CICx, const uint16_t* pSrc, uint32_t Stride, uint32_t Count, int32_t* pDst);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_CIC_H */
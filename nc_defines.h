@@ -1,42 +1,69 @@
-/** 
- * @file    nc_defines.h
- * @author  Noel Cruz   
- * @email   noel_s_cruz@yahoo.com
- * @github  https://github.com/noey2020
- * @version v1.0
- * @ide     Keil uVision
- * @license GNU GPL v3
- * @brief   Global place for project defines
- *
-@verbatim
-----------------------------------------------------------------------
-Copyright (C) 2020, Noel Cruz
-
-Permission is hereby granted, free of charge, to any person
-obtaining a copy of this software and associated documentation
-files (the "Software"), to deal in the Software without restriction,
-including without limitation the rights to use, copy, modify, merge,
-publish, distribute, sublicense, and/or sell copies of the Software, 
-and to permit persons to whom the Software is furnished to do so, 
-subject to the following conditions:
-
-The above copyright notice and this permission notice shall be
-included in all copies or substantial portions of the Software.
-
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
-EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
-OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
-AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
-HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
-WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
-FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
-OTHER DEALINGS IN THE SOFTWARE.
-----------------------------------------------------------------------
-@endverbatim
- */
-#ifndef NC_DEFINES_H
-#define NC_DEFINES_H 100
-
-/* Put your global variables defined in project/libraries here. */
-
-#endif /* NC_DEFINES_H */
+/** 
+ * @file    nc_defines.h
+ * @author  Noel Cruz   
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Global place for project defines
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software, 
+and to permit persons to whom the Software is furnished to do so, 
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+#ifndef NC_DEFINES_H
+#define NC_DEFINES_H 100
+
+/* Put your global variables defined in project/libraries here. */
+
+/**
+ * @brief Board pin map, applied by GPIO_PinMapInit() (nc_stm32l1_gpio.c)
+ * @note  One X(P, PORT, PIN, MODE, OTYPE, AF, SPEED, PULL) entry per pin, P is passed through.
+ *        A pin listed twice or an out of range field fails the build.
+ */
+#define NC_GPIO_PIN_MAP(X, P) \
+  X(P, GPIO_PortA,  9, GPIO_Mode_AF,  GPIO_OType_PP, GPIO_AF_USART1, GPIO_Speed_40MHz,  GPIO_PuPd_UP)      /* PA9 AF7 (USART1_TX) */ \
+  X(P, GPIO_PortB,  6, GPIO_Mode_AF,  GPIO_OType_PP, GPIO_AF_TIM4,   GPIO_Speed_40MHz,  GPIO_PuPd_NOPULL)  /* PB6 AF2 (TIM4_CH1) */ \
+  X(P, GPIO_PortB, 12, GPIO_Mode_OUT, GPIO_OType_PP, 0,              GPIO_Speed_40MHz,  GPIO_PuPd_NOPULL)  /* NC_PROBE_ISR */ \
+  X(P, GPIO_PortB, 13, GPIO_Mode_OUT, GPIO_OType_PP, 0,              GPIO_Speed_40MHz,  GPIO_PuPd_NOPULL)  /* NC_PROBE_DMA_HT */ \
+  X(P, GPIO_PortB, 14, GPIO_Mode_OUT, GPIO_OType_PP, 0,              GPIO_Speed_40MHz,  GPIO_PuPd_NOPULL)  /* NC_PROBE_DMA_TC */ \
+  X(P, GPIO_PortB, 15, GPIO_Mode_OUT, GPIO_OType_PP, 0,              GPIO_Speed_40MHz,  GPIO_PuPd_NOPULL)  /* NC_PROBE_DSP */
+
+/**
+ * @brief Scope probe pins marking pipeline stages (all on NC_PROBE_PORT)
+ * @note  NC_PROBE_MARK() raises and drops any set of probes with one BSRR store.
+ */
+#define NC_PROBE_PORT         GPIOB
+#define NC_PROBE_ISR          GPIO_Pin_12   /* ADC interrupt entry/exit */
+#define NC_PROBE_DMA_HT       GPIO_Pin_13   /* DMA half transfer handled */
+#define NC_PROBE_DMA_TC       GPIO_Pin_14   /* DMA full transfer handled */
+#define NC_PROBE_DSP          GPIO_Pin_15   /* Block processing done */
+
+#define NC_PROBE_ON(PINS)           GPIO_WRITE_MASK(NC_PROBE_PORT, (PINS), 0)
+#define NC_PROBE_OFF(PINS)          GPIO_WRITE_MASK(NC_PROBE_PORT, 0, (PINS))
+#define NC_PROBE_MARK(SET, CLR)     GPIO_WRITE_MASK(NC_PROBE_PORT, (SET), (CLR))
+
+#endif /* NC_DEFINES_H */
@@ -0,0 +1,328 @@
+/**
+ * @file    nc_delta.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Delta + zigzag sample block codec, varint or bit-packed
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_delta.h"
+
+/** @defgroup DLT
+  * @brief Lossless delta coding of interleaved sample blocks
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] DLT_Init() an encoder bank on the device and a decoder bank on the
+         host with the same scan length, and DLT_SetOrder() the same way on
+         both. DLT_EncodeBlock() turns one interleaved DMA block into a byte
+         stream of at most DLT_BLOCK_BOUND() bytes; DLT_DecodeBlock() restores
+         it exactly.
+    [..] Predictors carry over from block to block, so blocks must be decoded
+         in order. Call DLT_Reset() on both sides at a sync point, e.g. after a
+         lost frame; the first residual after a reset is the sample itself.
+    [..] Block layout, channel after channel in rank order:
+           tag byte: 0..19 packed width W, or DLT_TAG_VARINT
+           W:        Frames residuals of W bits, LSB first, padded to a byte
+           varint:   Frames LEB128 varints, 7 bits per byte
+         Residuals are zigzag coded: 0, -1, 1, -2 .. map to 0, 1, 2, 3 ..
+    [..] A channel drifting by a few codes costs a byte per sample as varints,
+         or 3 to 4 bits per sample packed; DLT_MODE_AUTO takes the smaller per
+         channel and block at the cost of a second pass over the residuals.
+
+                         ##### Cycle model #####
+    [..] Per sample on the Cortex-M3: predictor and zigzag 6 cycles, packing
+         8 cycles, a varint byte 6 cycles; with the sample load and stride
+         about 20 cycles (AUTO about 30), or 1.5 Msamples/s at 32 MHz. The
+         decoder costs about the same.
+    [..] tools/sim/sim_delta.c measures the modes on a tone, a drifting and a
+         noisy rank: 9.4, 6.9 and 6.5 bits per sample for VARINT, PACKED and
+         AUTO, or 2.5:1 against 16-bit samples and 1.85:1 against 12-bit
+         packing for AUTO. The first pass makes PACKED and AUTO encode at
+         about twice the VARINT cost; decoding costs the same in all modes.
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define DLT_MAX_WIDTH             19      /*!< Zigzag of a 2nd order residual of 16-bit samples */
+
+/* Private macro -------------------------------------------------------------*/
+#define DLT_ZIGZAG(R)             (((uint32_t)(R) << 1) ^ (uint32_t)((R) >> 31))
+#define DLT_UNZIGZAG(Z)           ((int32_t)((Z) >> 1) ^ -(int32_t)((Z) & 1))
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static int32_t DLT_Predict(const DLT_ChannelTypeDef* c);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Sets the scan length and mode, first order prediction, reset state.
+  * @param  DLTx: pointer to the bank.
+  * @param  NumRegular: ranks in the regular scan, 1 to DLT_MAX_CHANNELS.
+  * @param  Mode: DLT_MODE_x, ignored by the decoder.
+  * @retval 0 on success, -1 if a parameter is out of range.
+  */
+int32_t DLT_Init(DLT_BankTypeDef* DLTx, uint8_t NumRegular, uint8_t Mode)
+{
+  uint32_t ch;
+
+  if ((NumRegular == 0) || (NumRegular > DLT_MAX_CHANNELS) || (Mode > DLT_MODE_AUTO))
+  {
+    return -1;
+  }
+  DLTx->NumRegular = NumRegular;
+  DLTx->Mode = Mode;
+  for (ch = 0; ch < DLT_MAX_CHANNELS; ch++)
+  {
+    DLTx->Channel[ch].Order = 1;
+  }
+  DLT_Reset(DLTx);
+  return 0;
+}
+
+/**
+  * @brief  Selects the predictor of one channel.
+  * @note   Second order suits smooth signals sampled well above their
+  *         bandwidth; on noise it doubles the residuals. Both sides must agree.
+  * @param  DLTx: pointer to the bank.
+  * @param  Channel: rank, below DLT_MAX_CHANNELS.
+  * @param  Order: 1 or 2.
+  * @retval 0 on success, -1 if a parameter is out of range.
+  */
+int32_t DLT_SetOrder(DLT_BankTypeDef* DLTx, uint8_t Channel, uint8_t Order)
+{
+  if ((Channel >= DLT_MAX_CHANNELS) || (Order < 1) || (Order > 2))
+  {
+    return -1;
+  }
+  DLTx->Channel[Channel].Order = Order;
+  return 0;
+}
+
+/**
+  * @brief  Clears every predictor, a sync point on both sides.
+  * @param  DLTx: pointer to the bank.
+  * @retval None
+  */
+void DLT_Reset(DLT_BankTypeDef* DLTx)
+{
+  uint32_t ch;
+
+  for (ch = 0; ch < DLT_MAX_CHANNELS; ch++)
+  {
+    DLTx->Channel[ch].Prev1 = 0;
+    DLTx->Channel[ch].Prev2 = 0;
+  }
+}
+
+/**
+  * @brief  Encodes one interleaved block.
+  * @param  DLTx: pointer to the encoder bank.
+  * @param  pSrc: Frames scans of NumRegular samples.
+  * @param  Frames: scans in the block.
+  * @param  pDst: at least DLT_BLOCK_BOUND(Frames, NumRegular) bytes.
+  * @retval Bytes written.
+  */
+uint32_t DLT_EncodeBlock(DLT_BankTypeDef* DLTx, const uint16_t* pSrc, uint32_t Frames, uint8_t* pDst)
+{
+  uint32_t stride = DLTx->NumRegular;
+  uint8_t* out = pDst;
+  DLT_ChannelTypeDef* c;
+  const uint16_t* p;
+  uint32_t ch, n, z, width, any, bytes, acc, bits;
+  int32_t x, p1, p2;
+
+  for (ch = 0; ch < stride; ch++)
+  {
+    c = &DLTx->Channel[ch];
+    width = 0;
+    if (DLTx->Mode != DLT_MODE_VARINT)
+    {
+      /* First pass: widest residual, and the varint size for AUTO */
+      any = 0;
+      bytes = 0;
+      p1 = c->Prev1;
+      p2 = c->Prev2;
+      for (n = 0, p = pSrc + ch; n < Frames; n++, p += stride)
+      {
+        x = *p;
+        z = DLT_ZIGZAG(x - ((c->Order == 2) ? 2 * p1 - p2 : p1));
+        any |= z;
+        bytes += (z < 0x80) ? 1 : (z < 0x4000) ? 2 : 3;
+        p2 = p1;
+        p1 = x;
+      }
+      while ((any >> width) != 0)
+      {
+        width++;
+      }
+      if ((DLTx->Mode == DLT_MODE_AUTO) && (bytes * 8 < width * Frames))
+      {
+        width = DLT_TAG_VARINT;
+      }
+    }
+    else
+    {
+      width = DLT_TAG_VARINT;
+    }
+    *out++ = (uint8_t)width;
+    acc = 0;
+    bits = 0;
+    for (n = 0, p = pSrc + ch; n < Frames; n++, p += stride)
+    {
+      x = *p;
+      z = DLT_ZIGZAG(x - DLT_Predict(c));
+      c->Prev2 = c->Prev1;
+      c->Prev1 = x;
+      if (width == DLT_TAG_VARINT)
+      {
+        while (z >= 0x80)
+        {
+          *out++ = (uint8_t)(z | 0x80);
+          z >>= 7;
+        }
+        *out++ = (uint8_t)z;
+      }
+      else
+      {
+        acc |= z << bits;
+        bits += width;
+        while (bits >= 8)
+        {
+          *out++ = (uint8_t)acc;
+          acc >>= 8;
+          bits -= 8;
+        }
+      }
+    }
+    if ((width != DLT_TAG_VARINT) && (bits != 0))
+    {
+      *out++ = (uint8_t)acc;
+    }
+  }
+  return (uint32_t)(out - pDst);
+}
+
+/**
+  * @brief  Decodes one block into interleaved samples.
+  * @param  DLTx: pointer to the decoder bank.
+  * @param  pSrc: encoded block.
+  * @param  Size: bytes available at pSrc.
+  * @param  pDst: Frames scans of NumRegular samples.
+  * @param  Frames: scans in the block, as given to the encoder.
+  * @retval Bytes consumed, or -1 if the block is malformed or truncated.
+  */
+int32_t DLT_DecodeBlock(DLT_BankTypeDef* DLTx, const uint8_t* pSrc, uint32_t Size, uint16_t* pDst, uint32_t Frames)
+{
+  uint32_t stride = DLTx->NumRegular;
+  const uint8_t* in = pSrc;
+  const uint8_t* end = pSrc + Size;
+  DLT_ChannelTypeDef* c;
+  uint16_t* p;
+  uint32_t ch, n, z, width, acc, bits, shift, mask;
+  int32_t x;
+
+  for (ch = 0; ch < stride; ch++)
+  {
+    c = &DLTx->Channel[ch];
+    if (in == end)
+    {
+      return -1;
+    }
+    width = *in++;
+    if ((width > DLT_MAX_WIDTH) && (width != DLT_TAG_VARINT))
+    {
+      return -1;
+    }
+    if ((width != DLT_TAG_VARINT) && ((uint32_t)(end - in) < (width * Frames + 7) / 8))
+    {
+      return -1;
+    }
+    mask = (1UL << (width & 31)) - 1;
+    acc = 0;
+    bits = 0;
+    for (n = 0, p = pDst + ch; n < Frames; n++, p += stride)
+    {
+      if (width == DLT_TAG_VARINT)
+      {
+        z = 0;
+        shift = 0;
+        do
+        {
+          if ((in == end) || (shift > 14))
+          {
+            return -1;
+          }
+          z |= (uint32_t)(*in & 0x7F) << shift;
+          shift += 7;
+        } while ((*in++ & 0x80) != 0);
+      }
+      else
+      {
+        while (bits < width)
+        {
+          acc |= (uint32_t)*in++ << bits;
+          bits += 8;
+        }
+        z = acc & mask;
+        acc >>= width;
+        bits -= width;
+      }
+      x = DLT_Predict(c) + DLT_UNZIGZAG(z);
+      c->Prev2 = c->Prev1;
+      c->Prev1 = x;
+      *p = (uint16_t)x;
+    }
+  }
+  return (int32_t)(in - pSrc);
+}
+
+/**
+  * @brief  Next sample as the channel's predictor sees it.
+  * @param  c: channel state.
+  * @retval Prediction.
+  */
+static int32_t DLT_Predict(const DLT_ChannelTypeDef* c)
+{
+  return (c->Order == 2) ? 2 * c->Prev1 - c->Prev2 : c->Prev1;
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
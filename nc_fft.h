@@ -0,0 +1,69 @@
+/**
+ * @file    nc_fft.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Q15 real FFT for captured ADC blocks
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_FFT_H
+#define NC_FFT_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_FFT_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define FFT_MIN_POINTS                64
+#define FFT_MAX_POINTS                1024
+#define FFT_TABLE_BITS                9       /*!< log2(FFT_MAX_POINTS / 2), bit reverse table width */
+
+/* Exported macro ------------------------------------------------------------*/
+/* 12-bit code to Q15 at half scale (+/-0.5), the headroom FFT_RealQ15() relies on */
+#define FFT_ADC12_TO_Q15(CODE)        ((int16_t)(((int32_t)(CODE) - 2048) * 8))
+
+/* Exported functions ------------------------------------------------------- */
+void FFT_HannInit(int16_t* pWindow, uint32_t N);
+void FFT_Load(int16_t* pBuf, const uint16_t* pSrc, uint32_t Stride, uint32_t N, const int16_t* pWindow);
+int32_t FFT_RealQ15(int16_t* pBuf, uint32_t N);
+void FFT_MagSquared(const int16_t* pBuf, uint32_t N, uint32_t* pDst);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_FFT_H */
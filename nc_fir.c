@@ -0,0 +1,174 @@
+/**
+ * @file    nc_fir.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Q15 polyphase FIR decimator for ADC sample blocks
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_fir.h"
+
+/** @defgroup FIR
+  * @brief Anti-alias FIR decimation
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] FIR_DecimInit() with the Q15 anti-alias coefficients in natural order,
+         a FIR_DECIM_STATE_SIZE(NumTaps, M) state buffer and the decimation
+         factor M, then FIR_Decimate() on each DMA block. Interleaved scan
+         blocks are read in place through Stride.
+    [..] Polyphase structure: the filter is split into M branches of NumTaps / M
+         taps, branch p seeing the inputs x[mM - p] only. Each input sample runs
+         just its own branch and adds the result to the output being built, so
+         every input costs NumTaps / M MACs and the output is ready when the
+         M-th input arrives. Nothing is computed for the dropped outputs.
+    [..] The accumulator is 64-bit: int16 x int16 products summed into an int64
+         compile to SMLAL on the Cortex-M3, so no intermediate scaling is needed.
+         Results are rounded, shifted back to Q15 and saturated. The sum is
+         exact, so the output is bit for bit that of the direct form
+         y[n] = sum h[k] x[n - k] kept at n = M - 1, 2M - 1, ...; the host
+         check tools/nc_fir_check.c compares the two.
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Initializes a decimator and clears its history.
+  * @param  FIRx: pointer to the instance.
+  * @param  pCoeffs: NumTaps Q15 coefficients, natural order.
+  * @param  pState: FIR_DECIM_STATE_SIZE(NumTaps, Rate) entries of history.
+  * @param  NumTaps: filter length.
+  * @param  Rate: decimation factor M, 1 or more.
+  * @retval None
+  */
+void FIR_DecimInit(FIR_DecimTypeDef* FIRx, const int16_t* pCoeffs, int16_t* pState, uint16_t NumTaps, uint16_t Rate)
+{
+  uint32_t i;
+
+  FIRx->pCoeffs = pCoeffs;
+  FIRx->pState  = pState;
+  FIRx->NumTaps = NumTaps;
+  FIRx->Rate    = Rate;
+  FIRx->Length  = (uint16_t)((NumTaps + Rate - 1) / Rate);
+  FIRx->Acc     = 0;
+  FIRx->Index   = 0;
+  FIRx->Phase   = 0;
+  for (i = 0; i < FIR_DECIM_STATE_SIZE(NumTaps, Rate); i++)
+  {
+    pState[i] = 0;
+  }
+}
+
+/**
+  * @brief  Filters and decimates a block of ADC samples.
+  * @param  FIRx: pointer to the instance.
+  * @param  pSrc: first sample of this channel in the DMA block (12-bit codes).
+  * @param  Stride: distance between consecutive samples (1, or the scan length).
+  * @param  Count: number of input samples of this channel.
+  * @param  pDst: Q15 output buffer, at least Count / Rate + 1 entries.
+  * @retval Number of output samples written.
+  */
+uint32_t FIR_Decimate(FIR_DecimTypeDef* FIRx, const uint16_t* pSrc, uint32_t Stride, uint32_t Count, int16_t* pDst)
+{
+  const int16_t* coeffs = FIRx->pCoeffs;
+  const int16_t* x;
+  int16_t* branch;
+  uint32_t taps   = FIRx->NumTaps;
+  uint32_t rate   = FIRx->Rate;
+  uint32_t length = FIRx->Length;
+  uint32_t index  = FIRx->Index;
+  uint32_t phase  = FIRx->Phase;
+  int64_t acc     = FIRx->Acc;
+  uint32_t produced = 0;
+  uint32_t p, k;
+  int32_t y;
+  int16_t sample;
+
+  while (Count-- != 0)
+  {
+    if (phase == 0)
+    {
+      /* New output: every branch gets one more sample, newest first in the
+         window, so walk the histories backwards */
+      index = (index == 0) ? (length - 1) : (index - 1);
+    }
+    /* The first input of an output period feeds branch M - 1, the last one branch 0 */
+    p = rate - 1 - phase;
+    branch = &FIRx->pState[2 * length * p];
+    sample = FIR_ADC12_TO_Q15(*pSrc);
+    pSrc += Stride;
+    branch[index] = sample;
+    branch[index + length] = sample;
+
+    /* Branch p: taps p, p + M, ... below NumTaps */
+    x = &branch[index];
+    for (k = p; k < taps; k += rate)
+    {
+      acc += (int64_t)coeffs[k] * *x++;           /* SMLAL */
+    }
+
+    if (++phase == rate)
+    {
+      phase = 0;
+      y = (int32_t)((acc + (1 << 14)) >> 15);
+      acc = 0;
+      if (y > 32767)
+      {
+        y = 32767;
+      }
+      else if (y < -32768)
+      {
+        y = -32768;
+      }
+      pDst[produced++] = (int16_t)y;
+    }
+  }
+  FIRx->Index = (uint16_t)index;
+  FIRx->Phase = (uint16_t)phase;
+  FIRx->Acc = acc;
+  return produced;
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,90 @@
+/**
+ * @file    nc_fir.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Q15 polyphase FIR decimator for ADC sample blocks
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_FIR_H
+#define NC_FIR_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_FIR_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  Polyphase FIR decimator instance.
+  * @note   Branch p filters every M-th input with the coefficients
+  *         pCoeffs[p], pCoeffs[p + M], ... Each branch keeps 2 * Length
+  *         samples: every input is written twice, Length apart, so a branch's
+  *         newest Length samples are always contiguous and the MAC loop needs
+  *         no wrap test.
+  */
+typedef struct
+{
+  const int16_t* pCoeffs;     /*!< NumTaps Q15 coefficients, pCoeffs[k] weights x[n-k] */
+  int16_t* pState;            /*!< FIR_DECIM_STATE_SIZE(NumTaps, M) Q15 history, caller allocated */
+  int64_t Acc;                /*!< Branch sums of the output being built */
+  uint16_t NumTaps;
+  uint16_t Rate;              /*!< Decimation factor M */
+  uint16_t Length;            /*!< Taps per branch, NumTaps / M rounded up */
+  uint16_t Index;             /*!< Position of the newest sample in every branch */
+  uint16_t Phase;             /*!< Input samples since the last output */
+}FIR_DecimTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* History entries for NumTaps taps decimated by M: M branches of 2 * Length,
+   never more than 2 * (NumTaps + M - 1) */
+#define FIR_DECIM_STATE_SIZE(TAPS, M) (2UL * (M) * (((TAPS) + (M) - 1) / (M)))
+
+/* 12-bit right aligned ADC code to Q15, mid-scale maps to 0. Multiplied, not
+   shifted: a left shift of the negative half is undefined. */
+#define FIR_ADC12_TO_Q15(CODE)        ((int16_t)(((int32_t)(CODE) - 2048) * 8))
+
+/* Exported functions ------------------------------------------------------- */
+void FIR_DecimInit(FIR_DecimTypeDef* FIRx, const int16_t* pCoeffs, int16_t* pState, uint16_t NumTaps, uint16_t Rate);
+uint32_t FIR_Decimate(FIR_DecimTypeDef* FIRx, const uint16_t* pSrc, uint32_t Stride, uint32_t Count, int16_t* pDst);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_FIR_H */
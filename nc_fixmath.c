@@ -0,0 +1,121 @@
+/**
+ * @file    nc_fixmath.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Fixed-point and compile-time math helpers
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_fixmath.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Integer square root, floor(sqrt(Value)).
+  * @note   Bit by bit method: 32 iterations of shifts, compares and subtracts,
+  *         no multiply or divide. Meant for per-window results, not per sample.
+  * @param  Value: 64-bit radicand.
+  * @retval Square root rounded down.
+  */
+uint32_t NC_ISqrt64(uint64_t Value)
+{
+  uint64_t root = 0;
+  uint64_t bit = (uint64_t)1 << 62;
+
+  while (bit > Value)
+  {
+    bit >>= 2;
+  }
+  while (bit != 0)
+  {
+    if (Value >= root + bit)
+    {
+      Value -= root + bit;
+      root = (root >> 1) + bit;
+    }
+    else
+    {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (uint32_t)root;
+}
+
+/**
+  * @brief  Base 2 logarithm in Q16.
+  * @note   Normalizes to [1, 2) then squares 16 times, one result bit per
+  *         squaring. Exact to 1 LSB; for dB figures, 10 * log10(x) is
+  *         log2(x) * 3.0103.
+  * @param  Value: argument, 0 is treated as 1.
+  * @retval log2(Value) * 65536.
+  */
+int32_t NC_Log2Q16(uint64_t Value)
+{
+  uint32_t e = 0;
+  uint32_t n;
+  uint64_t m;
+  int32_t result;
+
+  if (Value == 0)
+  {
+    return 0;
+  }
+  while ((Value >> e) > 1)
+  {
+    e++;
+  }
+  /* Mantissa in Q31, 1.0 <= m < 2.0 */
+  m = (e > 31) ? (Value >> (e - 31)) : (Value << (31 - e));
+  result = (int32_t)(e << 16);
+  for (n = 0; n < 16; n++)
+  {
+    m = (m * m) >> 31;
+    if (m >= ((uint64_t)1 << 32))
+    {
+      m >>= 1;
+      result |= 1L << (15 - n);
+    }
+  }
+  return result;
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
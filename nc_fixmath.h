@@ -0,0 +1,95 @@
+/**
+ * @file    nc_fixmath.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Fixed-point and compile-time math helpers
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_FIXMATH_H
+#define NC_FIXMATH_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_FIXMATH_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/**
+ * @brief    Compile-time math
+ * @note     Every macro below is a floating constant expression when its arguments
+ *           are constants: used in a static const initializer it is folded by the
+ *           compiler and no floating point code or libm call reaches the target.
+ * @{
+ */
+#define NC_PI                         3.14159265358979323846
+
+/* sin(x) for |x| <= pi/2, Taylor series to x^13 in Horner form (error < 1e-9) */
+#define NC_CSIN_CORE(X)               ((X) * (1.0 - (X) * (X) / 6.0 * (1.0 - (X) * (X) / 20.0 * \
+                                       (1.0 - (X) * (X) / 42.0 * (1.0 - (X) * (X) / 72.0 *     \
+                                       (1.0 - (X) * (X) / 110.0 * (1.0 - (X) * (X) / 156.0)))))))
+
+/* sin(x) for -pi/2 <= x <= 3*pi/2 and cos(x) for -pi <= x <= pi */
+#define NC_CSIN(X)                    NC_CSIN_CORE(((X) > NC_PI / 2.0) ? (NC_PI - (X)) : (X))
+#define NC_CCOS(X)                    NC_CSIN(NC_PI / 2.0 - (X))
+
+/* Real to fixed-point with rounding and saturation */
+#define NC_FIX(X, SCALE, MAX, MIN)    (((X) * (SCALE) >= (MAX)) ? (MAX) : ((X) * (SCALE) <= (MIN)) ? (MIN) : \
+                                       ((X) >= 0.0) ? ((X) * (SCALE) + 0.5) : ((X) * (SCALE) - 0.5))
+#define NC_Q15(X)                     ((int16_t)NC_FIX((X), 32768.0, 32767.0, -32768.0))
+#define NC_Q30(X)                     ((int32_t)NC_FIX((X), 1073741824.0, 2147483647.0, -2147483648.0))
+#define NC_Q31(X)                     ((int32_t)NC_FIX((X), 2147483648.0, 2147483647.0, -2147483648.0))
+/**
+ * @}
+ */
+
+/**
+ * @brief    Run-time fixed-point helpers
+ * @{
+ */
+#define NC_SAT_Q31(X)                 (((X) > 2147483647LL) ? 2147483647L : ((X) < -2147483648LL) ? (-2147483647L - 1) : (int32_t)(X))
+/**
+ * @}
+ */
+
+/* Exported functions ------------------------------------------------------- */
+uint32_t NC_ISqrt64(uint64_t Value);
+int32_t NC_Log2Q16(uint64_t Value);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_FIXMATH_H */
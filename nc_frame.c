@@ -0,0 +1,290 @@
+/**
+ * @file    nc_frame.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Framed binary sample protocol
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "nc_frame.h"
+#include "nc_stm32l1_crc.h"
+
+/** @defgroup FRM
+  * @brief Sync, header, payload, CRC32 framing of blocks, events and statistics
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] Wire format, all words little-endian:
+           A5 5A | Type | Flags | Sequence:16 | Length:16 | Timestamp:32 |
+           ChannelMask:32 | payload, padded to a word | CRC:32
+         The CRC is CRC_CalcBlockCRC() over the header and padded payload
+         words, so the device computes it on the CRC unit (CRC_Init() first)
+         and the host from a table with NC_HOST defined, bit for bit the same.
+    [..] Sending in place: FRM_InitHeader(), then FRM_Crc() over the header and
+         the payload where it already lies, e.g. a DMA buffer half; send the
+         three pieces back to back. The payload must be word aligned and
+         readable up to FRM_PADDED(Length). Small records, events or
+         statistics, can go through FRM_Encode() into one contiguous buffer.
+    [..] Length counts the payload's own bytes, never padding, so the receiver
+         can tell the sample count from it: 2N for N FRM_TYPE_SAMPLES codes,
+         P12_BYTES(N) = ceil(12N / 8) for N FRM_TYPE_PACKED12 ones. The
+         P12_WORDS(N) words the packer fills are storage, not the length: a
+         word-padded Length would decode to a phantom sample.
+    [..] Receiving: FRM_ParserInit() once per link, then feed whatever the link
+         delivers to FRM_Parse() until it has used it all, and then call it
+         with Size 0 until it returns 0: a rescan can leave whole frames
+         buffered, which only come out one per call. Each call returns the
+         next good frame or 0; header and payload stay valid until the next
+         call. Bad CRCs and garbage cost a rescan from the byte after the
+         false sync, and are counted, as are gaps in Sequence.
+    [..] The parser only copies each byte once into its frame buffer and does
+         one table CRC pass over it; on a host that is several hundred MB/s.
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define FRM_HEADER_WORDS          (FRM_HEADER_BYTES / 4)
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void FRM_Resync(FRM_ParserTypeDef* FRMx, uint32_t From);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Fills a frame header.
+  * @param  pHeader: header to fill, word aligned.
+  * @param  Type: FRM_TYPE_x.
+  * @param  Flags: FRM_FLAG_x.
+  * @param  Sequence: per-link frame counter.
+  * @param  Timestamp: tick count at the first sample.
+  * @param  ChannelMask: ranks present in the payload.
+  * @param  Length: payload bytes, at most FRM_MAX_PAYLOAD.
+  * @retval None
+  */
+void FRM_InitHeader(FRM_HeaderTypeDef* pHeader, uint8_t Type, uint8_t Flags, uint16_t Sequence, uint32_t Timestamp, uint32_t ChannelMask, uint16_t Length)
+{
+  pHeader->Sync = FRM_SYNC;
+  pHeader->Type = Type;
+  pHeader->Flags = Flags;
+  pHeader->Sequence = Sequence;
+  pHeader->Length = Length;
+  pHeader->Timestamp = Timestamp;
+  pHeader->ChannelMask = ChannelMask;
+}
+
+/**
+  * @brief  CRC of a frame whose header and payload lie apart.
+  * @param  pHeader: filled header.
+  * @param  pPayload: payload, readable up to FRM_PADDED(Length).
+  * @retval The CRC word to send after the payload.
+  */
+uint32_t FRM_Crc(const FRM_HeaderTypeDef* pHeader, const uint32_t* pPayload)
+{
+  uint32_t crc = CRC_CalcBlockCRC((const uint32_t*)pHeader, FRM_HEADER_WORDS);
+
+  return CRC_UpdateBlockCRC(crc, pPayload, FRM_PADDED(pHeader->Length) / 4);
+}
+
+/**
+  * @brief  Builds a whole frame in one buffer, padding with zeros.
+  * @param  pDst: FRM_FRAME_BYTES(Length) bytes, word aligned.
+  * @param  pHeader: filled header.
+  * @param  pPayload: Length bytes.
+  * @retval Frame size in bytes.
+  */
+uint32_t FRM_Encode(uint32_t* pDst, const FRM_HeaderTypeDef* pHeader, const void* pPayload)
+{
+  uint32_t words = FRM_PADDED(pHeader->Length) / 4;
+
+  memcpy(pDst, pHeader, FRM_HEADER_BYTES);
+  if (words != 0)
+  {
+    pDst[FRM_HEADER_WORDS + words - 1] = 0;
+  }
+  memcpy(pDst + FRM_HEADER_WORDS, pPayload, pHeader->Length);
+  pDst[FRM_HEADER_WORDS + words] = CRC_CalcBlockCRC(pDst, FRM_HEADER_WORDS + words);
+  return FRM_FRAME_BYTES(pHeader->Length);
+}
+
+/**
+  * @brief  Resets a parser and its counters.
+  * @param  FRMx: pointer to the parser.
+  * @retval None
+  */
+void FRM_ParserInit(FRM_ParserTypeDef* FRMx)
+{
+  FRMx->Fill = 0;
+  FRMx->Total = 0;
+  FRMx->Frames = 0;
+  FRMx->CrcErrors = 0;
+  FRMx->Skipped = 0;
+  FRMx->Lost = 0;
+  FRMx->NextSequence = 0;
+}
+
+/**
+  * @brief  Consumes stream bytes up to the end of the next good frame.
+  * @param  FRMx: pointer to the parser.
+  * @param  pData: received bytes.
+  * @param  Size: bytes at pData, 0 to take frames already buffered.
+  * @param  pUsed: receives the bytes consumed; call again with the rest,
+  *         then with Size 0 until 0 is returned.
+  * @retval Header of the frame, payload at FRM_PAYLOAD(FRMx), or 0 when all
+  *         input was used without completing one.
+  */
+const FRM_HeaderTypeDef* FRM_Parse(FRM_ParserTypeDef* FRMx, const uint8_t* pData, uint32_t Size, uint32_t* pUsed)
+{
+  uint8_t* b = (uint8_t*)FRMx->Buf;
+  const FRM_HeaderTypeDef* h = (const FRM_HeaderTypeDef*)FRMx->Buf;
+  const uint8_t* p;
+  uint32_t used = 0;
+  uint32_t need, n, words;
+
+  if ((FRMx->Total != 0) && (FRMx->Fill >= FRMx->Total))
+  {
+    /* Drop the frame returned last time, keep what a resync left behind it */
+    FRMx->Fill -= FRMx->Total;
+    memmove(b, b + FRMx->Total, FRMx->Fill);
+    FRMx->Total = 0;
+    FRM_Resync(FRMx, 0);
+  }
+  for (;;)
+  {
+    if (FRMx->Fill == 0)
+    {
+      p = (const uint8_t*)memchr(pData + used, FRM_SYNC0, Size - used);
+      n = (p != 0) ? (uint32_t)(p - (pData + used)) : Size - used;
+      FRMx->Skipped += n;
+      used += n;
+      if (used == Size)
+      {
+        break;
+      }
+      b[FRMx->Fill++] = pData[used++];
+    }
+    if (FRMx->Fill == 1)
+    {
+      if (used == Size)
+      {
+        break;
+      }
+      if (pData[used] != FRM_SYNC1)
+      {
+        /* Not a sync; a second A5 may still start one */
+        FRMx->Skipped++;
+        FRMx->Fill = 0;
+        continue;
+      }
+      b[FRMx->Fill++] = pData[used++];
+    }
+    need = (FRMx->Total == 0) ? FRM_HEADER_BYTES : FRMx->Total;
+    if (FRMx->Fill < need)
+    {
+      n = need - FRMx->Fill;
+      if (n > Size - used)
+      {
+        n = Size - used;
+      }
+      memcpy(b + FRMx->Fill, pData + used, n);
+      FRMx->Fill += n;
+      used += n;
+      if (FRMx->Fill < need)
+      {
+        break;
+      }
+    }
+    if (FRMx->Total == 0)
+    {
+      if (h->Length > FRM_MAX_PAYLOAD)
+      {
+        FRM_Resync(FRMx, 1);
+      }
+      else
+      {
+        FRMx->Total = FRM_FRAME_BYTES(h->Length);
+      }
+      continue;
+    }
+    words = (FRMx->Total - FRM_CRC_BYTES) / 4;
+    if (CRC_CalcBlockCRC(FRMx->Buf, words) != FRMx->Buf[words])
+    {
+      FRMx->CrcErrors++;
+      FRMx->Total = 0;
+      FRM_Resync(FRMx, 1);
+      continue;
+    }
+    if (FRMx->Frames != 0)
+    {
+      FRMx->Lost += (uint16_t)(h->Sequence - FRMx->NextSequence);
+    }
+    FRMx->NextSequence = (uint16_t)(h->Sequence + 1);
+    FRMx->Frames++;
+    *pUsed = used;
+    return h;
+  }
+  *pUsed = used;
+  return 0;
+}
+
+/**
+  * @brief  Discards buffered bytes up to the next sync candidate.
+  * @param  FRMx: pointer to the parser.
+  * @param  From: first byte that may start a frame.
+  * @retval None
+  */
+static void FRM_Resync(FRM_ParserTypeDef* FRMx, uint32_t From)
+{
+  uint8_t* b = (uint8_t*)FRMx->Buf;
+  uint32_t i = From;
+
+  while ((i < FRMx->Fill) && !((b[i] == FRM_SYNC0) && ((i + 1 == FRMx->Fill) || (b[i + 1] == FRM_SYNC1))))
+  {
+    i++;
+  }
+  FRMx->Skipped += i;
+  FRMx->Fill -= i;
+  FRMx->Total = 0;
+  memmove(b, b + i, FRMx->Fill);
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,139 @@
+/**
+ * @file    nc_frame.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Framed binary sample protocol
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_FRAME_H
+#define NC_FRAME_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_FRAME_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define FRM_SYNC0                     0xA5    /*!< First byte on the wire */
+#define FRM_SYNC1                     0x5A    /*!< Second byte on the wire */
+#define FRM_SYNC                      ((uint16_t)(FRM_SYNC0 | (FRM_SYNC1 << 8)))
+
+#define FRM_HEADER_BYTES              16
+#define FRM_CRC_BYTES                 4
+
+#ifndef FRM_MAX_PAYLOAD
+#define FRM_MAX_PAYLOAD               4096    /*!< Largest payload the parser accepts, bytes */
+#endif /* FRM_MAX_PAYLOAD */
+
+/** @defgroup FRM_Type
+  * @{
+  */
+#define FRM_TYPE_SAMPLES              0x01    /*!< uint16_t codes, interleaved scans */
+#define FRM_TYPE_PACKED12             0x02    /*!< nc_pack12 stream, interleaved scans, Length P12_BYTES(N) */
+#define FRM_TYPE_DELTA                0x03    /*!< DLT_EncodeBlock() output */
+#define FRM_TYPE_ADPCM                0x04    /*!< ADP_Encode() output, one channel */
+#define FRM_TYPE_EVENTS               0x10    /*!< EVT_EventTypeDef records */
+#define FRM_TYPE_STATS                0x11    /*!< STAT_RecordTypeDef records */
+#define FRM_TYPE_ZC                   0x12    /*!< ZC_RecordTypeDef records */
+/**
+  * @}
+  */
+
+/** @defgroup FRM_Flags
+  * @{
+  */
+#define FRM_FLAG_RESET                0x01    /*!< Codec predictors were reset before this block */
+#define FRM_FLAG_OVERRUN              0x02    /*!< Data was dropped before this frame */
+/**
+  * @}
+  */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  Frame header, 16 bytes, little-endian on the wire.
+  * @note   A frame is the header, Length payload bytes padded with whatever
+  *         follows them to a whole word, then CRC_CalcBlockCRC() of all of it.
+  */
+typedef struct
+{
+  uint16_t Sync;              /*!< FRM_SYNC */
+  uint8_t  Type;              /*!< FRM_TYPE_x */
+  uint8_t  Flags;             /*!< FRM_FLAG_x */
+  uint16_t Sequence;          /*!< Per-link counter, gaps are lost frames */
+  uint16_t Length;            /*!< Payload bytes before padding, exact */
+  uint32_t Timestamp;         /*!< Sender's tick count at the first sample */
+  uint32_t ChannelMask;       /*!< Bit r set: rank r is in the payload */
+}FRM_HeaderTypeDef;
+
+/**
+  * @brief  Stream parser, one per link, no allocation.
+  */
+typedef struct
+{
+  uint32_t Buf[(FRM_HEADER_BYTES + FRM_MAX_PAYLOAD + FRM_CRC_BYTES) / 4];
+  uint32_t Fill;              /*!< Bytes in Buf, starting at a sync candidate */
+  uint32_t Total;             /*!< Size of the frame in Buf once its header checked out */
+  uint32_t Frames;            /*!< Good frames */
+  uint32_t CrcErrors;         /*!< Frames rejected by CRC */
+  uint32_t Skipped;           /*!< Bytes discarded while hunting for sync */
+  uint32_t Lost;              /*!< Frames missing from the sequence */
+  uint16_t NextSequence;
+}FRM_ParserTypeDef;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Payload bytes on the wire, padded to a word */
+#define FRM_PADDED(LENGTH)            ((((uint32_t)(LENGTH)) + 3) & ~3UL)
+
+/* Whole frame on the wire */
+#define FRM_FRAME_BYTES(LENGTH)       (FRM_HEADER_BYTES + FRM_PADDED(LENGTH) + FRM_CRC_BYTES)
+
+/* Payload of a parsed frame, valid until the next FRM_Parse() */
+#define FRM_PAYLOAD(PARSER)           ((const uint8_t*)(PARSER)->Buf + FRM_HEADER_BYTES)
+
+/* Exported functions ------------------------------------------------------- */
+void FRM_InitHeader(FRM_HeaderTypeDef* pHeader, uint8_t Type, uint8_t Flags, uint16_t Sequence, uint32_t Timestamp, uint32_t ChannelMask, uint16_t Length);
+uint32_t FRM_Crc(const FRM_HeaderTypeDef* pHeader, const uint32_t* pPayload);
+uint32_t FRM_Encode(uint32_t* pDst, const FRM_HeaderTypeDef* pHeader, const void* pPayload);
+void FRM_ParserInit(FRM_ParserTypeDef* FRMx);
+const FRM_HeaderTypeDef* FRM_Parse(FRM_ParserTypeDef* FRMx, const uint8_t* pData, uint32_t Size, uint32_t* pUsed);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_FRAME_H */
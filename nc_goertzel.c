@@ -0,0 +1,181 @@
+/**
+ * @file    nc_goertzel.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Fixed-point Goertzel tone detection bank
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_goertzel.h"
+
+/** @defgroup GOERTZEL
+  * @brief Multi-target Goertzel tone detector
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] List the watched frequencies at build time, e.g. mains and harmonics at
+         fs = 1 kHz:
+           static const int32_t MainsCoeffs[] = { GOERTZEL_COEFF(50, 1000),
+                                                  GOERTZEL_COEFF(150, 1000) };
+         then GOERTZEL_Init() with the window length N, 1 to GOERTZEL_MAX_WINDOW.
+    [..] GOERTZEL_Process() consumes blocks of any size, in place with a stride for
+         interleaved scans. Each time N samples have been seen, Amplitude[] holds
+         the amplitude of every target over that window and Windows is incremented.
+    [..] Cost per input sample: one SMULL, two adds and a shift per target, so it
+         grows linearly with NumTargets. A full N point FFT costs about log2(N)
+         complex butterflies per sample, so below roughly log2(N) targets the bank
+         is the cheaper option. The magnitude and square root run once per window.
+         tools/sim/sim_goertzel.c measures it: about 15 host instructions per
+         sample plus 11.7 per target, including the per-window magnitude step.
+    [..] Range: the resonator is s[n] = sum x[n-k] * sin((k+1)w) / sin(w), and
+         each ratio is at most k+1 in magnitude, so with |x| <= 2048 a window
+         of N samples keeps |s| <= 2048 * N(N+1)/2, about 2^30 for N = 1024.
+         The states fit int32 and the products of the magnitude step stay below
+         2^63, whatever the tone, its frequency and the coefficient.
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void GOERTZEL_Close(GOERTZEL_BankTypeDef* GOERTZELx);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Binds the target coefficients and starts an empty window.
+  * @param  GOERTZELx: pointer to the bank.
+  * @param  pCoeffs: NumTargets values built with GOERTZEL_COEFF().
+  * @param  NumTargets: 1 to GOERTZEL_MAX_TARGETS.
+  * @param  WindowLen: N, samples per result, 1 to GOERTZEL_MAX_WINDOW.
+  * @retval 0 on success, -1 if NumTargets or WindowLen is out of range.
+  */
+int32_t GOERTZEL_Init(GOERTZEL_BankTypeDef* GOERTZELx, const int32_t* pCoeffs, uint8_t NumTargets, uint16_t WindowLen)
+{
+  uint32_t t;
+
+  if ((NumTargets == 0) || (NumTargets > GOERTZEL_MAX_TARGETS) ||
+      (WindowLen == 0) || (WindowLen > GOERTZEL_MAX_WINDOW))
+  {
+    return -1;
+  }
+
+  GOERTZELx->pCoeffs    = pCoeffs;
+  GOERTZELx->NumTargets = NumTargets;
+  GOERTZELx->WindowLen  = WindowLen;
+  GOERTZELx->Count      = 0;
+  GOERTZELx->Windows    = 0;
+  for (t = 0; t < GOERTZEL_MAX_TARGETS; t++)
+  {
+    GOERTZELx->S1[t] = 0;
+    GOERTZELx->S2[t] = 0;
+    GOERTZELx->Amplitude[t] = 0;
+  }
+  return 0;
+}
+
+/**
+  * @brief  Runs the resonators over a block of 12-bit samples.
+  * @param  GOERTZELx: pointer to the bank.
+  * @param  pSrc: first sample of this channel in the DMA block.
+  * @param  Stride: distance between consecutive samples (1, or the scan length).
+  * @param  Count: number of samples of this channel.
+  * @retval Number of windows completed during this call.
+  */
+uint32_t GOERTZEL_Process(GOERTZEL_BankTypeDef* GOERTZELx, const uint16_t* pSrc, uint32_t Stride, uint32_t Count)
+{
+  const int32_t* coeffs = GOERTZELx->pCoeffs;
+  int32_t* s1 = GOERTZELx->S1;
+  int32_t* s2 = GOERTZELx->S2;
+  uint32_t targets = GOERTZELx->NumTargets;
+  uint32_t closed = 0;
+  uint32_t t;
+  int32_t x, s0;
+
+  while (Count-- != 0)
+  {
+    x = (int32_t)*pSrc - 2048;            /* Remove mid-scale, the DC bin is not watched */
+    pSrc += Stride;
+    for (t = 0; t < targets; t++)
+    {
+      s0 = x + (int32_t)(((int64_t)coeffs[t] * s1[t]) >> GOERTZEL_COEFF_SHIFT) - s2[t];
+      s2[t] = s1[t];
+      s1[t] = s0;
+    }
+    if (++GOERTZELx->Count == GOERTZELx->WindowLen)
+    {
+      GOERTZEL_Close(GOERTZELx);
+      closed++;
+    }
+  }
+  return closed;
+}
+
+/**
+  * @brief  Converts the resonator states into amplitudes and restarts the window.
+  * @note   |X|^2 = s1^2 + s2^2 - coeff * s1 * s2, amplitude = 2 * |X| / N.
+  * @param  GOERTZELx: pointer to the bank.
+  * @retval None
+  */
+static void GOERTZEL_Close(GOERTZEL_BankTypeDef* GOERTZELx)
+{
+  uint32_t t;
+  int64_t a, b;
+  int64_t power;
+
+  for (t = 0; t < GOERTZELx->NumTargets; t++)
+  {
+    a = GOERTZELx->S1[t];
+    b = GOERTZELx->S2[t];
+    power = a * a + b * b - ((((int64_t)GOERTZELx->pCoeffs[t] * a) >> GOERTZEL_COEFF_SHIFT) * b);
+    if (power < 0)
+    {
+      power = 0;                          /* Rounding of the cross term near zero */
+    }
+    GOERTZELx->Amplitude[t] = (32 * NC_ISqrt64((uint64_t)power)) / GOERTZELx->WindowLen;
+    GOERTZELx->S1[t] = 0;
+    GOERTZELx->S2[t] = 0;
+  }
+  GOERTZELx->Count = 0;
+  GOERTZELx->Windows++;
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,85 @@
+/**
+ * @file    nc_goertzel.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Fixed-point Goertzel tone detection bank
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_GOERTZEL_H
+#define NC_GOERTZEL_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_GOERTZEL_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "nc_fixmath.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define GOERTZEL_MAX_TARGETS          8
+#define GOERTZEL_COEFF_SHIFT          30      /*!< Coefficients are Q2.30 */
+#define GOERTZEL_MAX_WINDOW           1024    /*!< Longest N with int32 resonator states for any tone */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  Goertzel bank watching NumTargets frequencies of one channel.
+  */
+typedef struct
+{
+  const int32_t* pCoeffs;                     /*!< GOERTZEL_COEFF() per target */
+  int32_t  S1[GOERTZEL_MAX_TARGETS];          /*!< s[n-1] per target */
+  int32_t  S2[GOERTZEL_MAX_TARGETS];          /*!< s[n-2] per target */
+  uint32_t Amplitude[GOERTZEL_MAX_TARGETS];   /*!< Last window: tone amplitude, codes in Q4 */
+  uint32_t Windows;                           /*!< Completed windows */
+  uint16_t WindowLen;                         /*!< N, samples per window */
+  uint16_t Count;                             /*!< Samples in the current window */
+  uint8_t  NumTargets;
+}GOERTZEL_BankTypeDef;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Build-time coefficient 2*cos(2*pi*F/FS), any F below FS/2 (not limited to bin centres) */
+#define GOERTZEL_COEFF(F, FS)         NC_Q30(2.0 * NC_CCOS(2.0 * NC_PI * (double)(F) / (double)(FS)))
+
+/* Exported functions ------------------------------------------------------- */
+int32_t GOERTZEL_Init(GOERTZEL_BankTypeDef* GOERTZELx, const int32_t* pCoeffs, uint8_t NumTargets, uint16_t WindowLen);
+uint32_t GOERTZEL_Process(GOERTZEL_BankTypeDef* GOERTZELx, const uint16_t* pSrc, uint32_t Stride, uint32_t Count);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_GOERTZEL_H */
@@ -0,0 +1,106 @@
+/**
+ * @file    nc_lin.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Compile-time sensor linearization tables
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_lin.h"
+
+/** @defgroup LIN
+  * @brief Piecewise-linear code to unit conversion from build-time tables
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] Describe the sensor as a constant expression of the code X, in the
+         output units wanted on device, e.g. a pressure bridge in Pa:
+           #define PRESS_CURVE(X)    (-1250.0 + 30.5 * (X) + 0.0011 * (X) * (X))
+    [..] Pick the flash budget, let LIN_BITS_FOR_BUDGET() give the segment count,
+         and define and check the table in one translation unit:
+           #define PRESS_BITS        6                        (LIN_BITS_FOR_BUDGET(300))
+           LIN_TABLE_DEFINE(PressTable, PRESS_CURVE, PRESS_BITS);
+           LIN_TABLE_CHECK(PressTable, PRESS_BITS, 300);
+         The check refuses to build if the table does not fill the budget.
+    [..] List the curve in tools/nc_lin_check.c as well. Run on the host, it
+         evaluates LIN_LOOKUP() exactly as the device does at all 4096 codes,
+         rounded break points and truncated interpolation included, and prints
+         the maximum deviation from the curve per table, failing if one is
+         above its bound. Expect the chord error max|f''| * h^2 / 8
+         (h = 4096 / 2^BITS codes) plus up to 1.5 units: 1.47 Pa for the
+         table above.
+    [..] Per sample, LIN_LOOKUP() or LIN_ConvertBlock() cost one shift, one mask,
+         two loads and one multiply, with no branch.
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Converts one channel of a block of 12-bit codes.
+  * @param  pTable: table built by LIN_TABLE_DEFINE().
+  * @param  Bits: the BITS the table was built with.
+  * @param  pSrc: first sample of this channel.
+  * @param  pDst: output units, one per sample, packed.
+  * @param  Stride: distance between consecutive samples (1, or the scan length).
+  * @param  Count: number of samples of this channel.
+  * @retval None
+  */
+void LIN_ConvertBlock(const int32_t* pTable, uint32_t Bits, const uint16_t* pSrc, int32_t* pDst, uint32_t Stride, uint32_t Count)
+{
+  uint32_t shift = LIN_CODE_BITS - Bits;
+  uint32_t mask = (1UL << shift) - 1;
+  uint32_t code;
+  const int32_t* seg;
+
+  while (Count-- != 0)
+  {
+    code = *pSrc & 0x0FFF;
+    pSrc += Stride;
+    seg = &pTable[code >> shift];
+    *pDst++ = seg[0] + (((seg[1] - seg[0]) * (int32_t)(code & mask)) >> shift);
+  }
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,127 @@
+/**
+ * @file    nc_lin.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Compile-time sensor linearization tables
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_LIN_H
+#define NC_LIN_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_LIN_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define LIN_CODE_BITS                 12      /*!< Table domain is the 12-bit code, 0..4095 */
+#define LIN_MIN_BITS                  2
+#define LIN_MAX_BITS                  10      /*!< Up to 1024 segments */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Table of 2^BITS segments: 2^BITS + 1 int32_t break points */
+#define LIN_TABLE_BYTES(BITS)         (4 * ((1 << (BITS)) + 1))
+
+/* Largest segment count whose table fits BYTES of flash */
+#define LIN_BITS_FOR_BUDGET(BYTES)    (((BYTES) >= LIN_TABLE_BYTES(10)) ? 10 : ((BYTES) >= LIN_TABLE_BYTES(9)) ? 9 : \
+                                       ((BYTES) >= LIN_TABLE_BYTES(8)) ? 8 : ((BYTES) >= LIN_TABLE_BYTES(7)) ? 7 : \
+                                       ((BYTES) >= LIN_TABLE_BYTES(6)) ? 6 : ((BYTES) >= LIN_TABLE_BYTES(5)) ? 5 : \
+                                       ((BYTES) >= LIN_TABLE_BYTES(4)) ? 4 : ((BYTES) >= LIN_TABLE_BYTES(3)) ? 3 : 2)
+
+/* Code at segment boundary K of a BITS table */
+#define LIN_X(BITS, K)                ((double)(K) * (double)(1 << (LIN_CODE_BITS - (BITS))))
+/* Nearest integer, halves away from zero */
+#define LIN_ROUND(Y)                  ((int32_t)(((Y) >= 0.0) ? ((Y) + 0.5) : ((Y) - 0.5)))
+
+/* Break point K of a BITS table, as stored by LIN_TABLE_DEFINE() */
+#define LIN_POINT(CURVE, BITS, K)     LIN_ROUND(CURVE(LIN_X(BITS, K)))
+
+/* Item generator, expanded once per segment by LIN_REP_n */
+#define LIN_ITEM_POINT(CURVE, BITS, K)   LIN_POINT(CURVE, BITS, K),
+
+#define LIN_REP_0(M, C, B, K)         M(C, B, K)
+#define LIN_REP_1(M, C, B, K)         LIN_REP_0(M, C, B, K) LIN_REP_0(M, C, B, (K) + 1)
+#define LIN_REP_2(M, C, B, K)         LIN_REP_1(M, C, B, K) LIN_REP_1(M, C, B, (K) + 2)
+#define LIN_REP_3(M, C, B, K)         LIN_REP_2(M, C, B, K) LIN_REP_2(M, C, B, (K) + 4)
+#define LIN_REP_4(M, C, B, K)         LIN_REP_3(M, C, B, K) LIN_REP_3(M, C, B, (K) + 8)
+#define LIN_REP_5(M, C, B, K)         LIN_REP_4(M, C, B, K) LIN_REP_4(M, C, B, (K) + 16)
+#define LIN_REP_6(M, C, B, K)         LIN_REP_5(M, C, B, K) LIN_REP_5(M, C, B, (K) + 32)
+#define LIN_REP_7(M, C, B, K)         LIN_REP_6(M, C, B, K) LIN_REP_6(M, C, B, (K) + 64)
+#define LIN_REP_8(M, C, B, K)         LIN_REP_7(M, C, B, K) LIN_REP_7(M, C, B, (K) + 128)
+#define LIN_REP_9(M, C, B, K)         LIN_REP_8(M, C, B, K) LIN_REP_8(M, C, B, (K) + 256)
+#define LIN_REP_10(M, C, B, K)        LIN_REP_9(M, C, B, K) LIN_REP_9(M, C, B, (K) + 512)
+#define LIN_REP(BITS)                 LIN_REP_##BITS
+#define LIN_REP_X(BITS)               LIN_REP(BITS)
+
+/**
+  * @brief  Defines NAME, the break points of CURVE over 2^BITS equal segments.
+  * @note   CURVE(X) maps a code (double) to output units with a constant
+  *         expression. BITS must be a literal or a macro expanding to one.
+  */
+#define LIN_TABLE_DEFINE(NAME, CURVE, BITS) \
+  const int32_t NAME[(1 << (BITS)) + 1] = { LIN_REP_X(BITS)(LIN_ITEM_POINT, CURVE, BITS, 0) \
+                                            LIN_POINT(CURVE, BITS, 1 << (BITS)) }
+
+/**
+  * @brief  Fails to compile unless NAME uses the largest segment count that
+  *         fits BYTES of flash. An integer constant expression, so any C
+  *         compiler accepts it at file scope.
+  * @note   The interpolation error is not checked here: tools/nc_lin_check.c
+  *         evaluates LIN_LOOKUP() at all 4096 codes on the host and reports
+  *         the maximum deviation from CURVE per table.
+  */
+#define LIN_TABLE_CHECK(NAME, BITS, BYTES) \
+  typedef char NAME##_BudgetCheck[((BITS) == LIN_BITS_FOR_BUDGET(BYTES)) && (sizeof(NAME) <= (BYTES)) ? 1 : -1]
+
+/**
+  * @brief  Branch-free interpolated lookup of one 12-bit code.
+  * @note   CODE is evaluated several times: pass a plain variable, not an
+  *         expression with side effects such as *pSrc++.
+  */
+#define LIN_LOOKUP(TABLE, BITS, CODE) \
+  ((TABLE)[(CODE) >> (LIN_CODE_BITS - (BITS))] + \
+   ((((TABLE)[((CODE) >> (LIN_CODE_BITS - (BITS))) + 1] - (TABLE)[(CODE) >> (LIN_CODE_BITS - (BITS))]) * \
+     (int32_t)((CODE) & ((1 << (LIN_CODE_BITS - (BITS))) - 1))) >> (LIN_CODE_BITS - (BITS))))
+
+/* Exported functions ------------------------------------------------------- */
+void LIN_ConvertBlock(const int32_t* pTable, uint32_t Bits, const uint16_t* pSrc, int32_t* pDst, uint32_t Stride, uint32_t Count);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_LIN_H */
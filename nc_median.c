@@ -0,0 +1,337 @@
+/**
+ * @file    nc_median.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Sliding-window median spike filter
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_median.h"
+
+/** @defgroup MED
+  * @brief O(log w) running median in fixed arrays
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] One MED_FilterTypeDef per channel, MED_Init() with an odd window.
+    [..] MED_Push() returns the median of the last Window samples. The first
+         sample is replicated into the whole window, so the output starts
+         without a warm-up transient.
+    [..] MED_FilterBlock() runs a channel of a DMA block with a stride; pDst may
+         equal pSrc to filter the block in place.
+    [..] Windows 3 and 5 use a comparison network on the ring (3 and 6 compares).
+         Longer windows keep the two heaps: replacing the oldest sample is one
+         sift of at most log2(Window / 2) levels, against Window * log2(Window)
+         compares for sorting a copy of the window every sample.
+    [..] tools/sim/sim_median.c runs both on the simulator cycle clock. Against
+         an insertion sort of the window per sample, MED_Push() is 2.0 times
+         faster at window 3, 2.6 at 5, 4.8 at 15, 14 at 31 and 44 at 63.
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+#define MED_ITEM(M, I)                ((M)->Data[(M)->pHeap[I]])
+#define MED_MINCT(M)                  (((M)->Count - 1) / 2)  /*!< Entries in the min-heap */
+#define MED_MAXCT(M)                  ((M)->Count / 2)        /*!< Entries in the max-heap */
+#define MED_SWAP16(A, B)              do { uint16_t t_ = (A); (A) = (B); (B) = t_; } while (0)
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static int32_t MED_CmpExch(MED_FilterTypeDef* MEDx, int32_t i, int32_t j);
+static void MED_MinSortDown(MED_FilterTypeDef* MEDx, int32_t i);
+static void MED_MaxSortDown(MED_FilterTypeDef* MEDx, int32_t i);
+static int32_t MED_MinSortUp(MED_FilterTypeDef* MEDx, int32_t i);
+static int32_t MED_MaxSortUp(MED_FilterTypeDef* MEDx, int32_t i);
+static void MED_Insert(MED_FilterTypeDef* MEDx, uint16_t Sample);
+static uint16_t MED_Median5(uint16_t a, uint16_t b, uint16_t c, uint16_t d, uint16_t e);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Sets the window length and empties the window.
+  * @param  MEDx: pointer to the filter.
+  * @param  Window: odd length, 3 to MED_MAX_WINDOW.
+  * @retval 0 on success, -1 if Window is even or out of range.
+  */
+int32_t MED_Init(MED_FilterTypeDef* MEDx, uint8_t Window)
+{
+  int32_t n;
+
+  if ((Window < 3) || (Window > MED_MAX_WINDOW) || ((Window & 1) == 0))
+  {
+    return -1;
+  }
+  MEDx->Window = Window;
+  MEDx->Idx = 0;
+  MEDx->Count = 0;
+  MEDx->pHeap = &MEDx->HeapBuf[Window / 2];
+  /* Slots alternate 0, -1, 1, -2, 2 ... so either heap grows by one per insert */
+  for (n = Window - 1; n >= 0; n--)
+  {
+    MEDx->Pos[n] = (int8_t)(((n + 1) / 2) * ((n & 1) ? -1 : 1));
+    MEDx->pHeap[MEDx->Pos[n]] = (int8_t)n;
+  }
+  return 0;
+}
+
+/**
+  * @brief  Adds a sample and returns the median of the window.
+  * @param  MEDx: pointer to the filter.
+  * @param  Sample: new sample.
+  * @retval Median of the last Window samples.
+  */
+uint16_t MED_Push(MED_FilterTypeDef* MEDx, uint16_t Sample)
+{
+  uint16_t* d = MEDx->Data;
+  uint32_t n;
+
+  if (MEDx->Count == 0)
+  {
+    for (n = 0; n < MEDx->Window; n++)
+    {
+      MED_Insert(MEDx, Sample);
+    }
+    return Sample;
+  }
+  if (MEDx->Window == 3)
+  {
+    d[MEDx->Idx] = Sample;
+    MEDx->Idx = (MEDx->Idx == 2) ? 0 : MEDx->Idx + 1;
+    return (d[0] > d[1]) ? ((d[1] > d[2]) ? d[1] : (d[0] > d[2]) ? d[2] : d[0])
+                         : ((d[0] > d[2]) ? d[0] : (d[1] > d[2]) ? d[2] : d[1]);
+  }
+  if (MEDx->Window == 5)
+  {
+    d[MEDx->Idx] = Sample;
+    MEDx->Idx = (MEDx->Idx == 4) ? 0 : MEDx->Idx + 1;
+    return MED_Median5(d[0], d[1], d[2], d[3], d[4]);
+  }
+  MED_Insert(MEDx, Sample);
+  return MED_ITEM(MEDx, 0);
+}
+
+/**
+  * @brief  Filters one channel of a block.
+  * @param  MEDx: pointer to the filter.
+  * @param  pSrc: first sample of this channel.
+  * @param  pDst: output, same layout as pSrc; may equal pSrc.
+  * @param  Stride: distance between consecutive samples (1, or the scan length).
+  * @param  Count: number of samples of this channel.
+  * @retval None
+  */
+void MED_FilterBlock(MED_FilterTypeDef* MEDx, const uint16_t* pSrc, uint16_t* pDst, uint32_t Stride, uint32_t Count)
+{
+  while (Count-- != 0)
+  {
+    *pDst = MED_Push(MEDx, *pSrc);
+    pSrc += Stride;
+    pDst += Stride;
+  }
+}
+
+/**
+  * @brief  Swaps heap positions i and j if item i is below item j.
+  * @retval 1 if swapped.
+  */
+static int32_t MED_CmpExch(MED_FilterTypeDef* MEDx, int32_t i, int32_t j)
+{
+  int8_t* h = MEDx->pHeap;
+  int8_t t;
+
+  if (MED_ITEM(MEDx, i) >= MED_ITEM(MEDx, j))
+  {
+    return 0;
+  }
+  t = h[i];
+  h[i] = h[j];
+  h[j] = t;
+  MEDx->Pos[h[i]] = (int8_t)i;
+  MEDx->Pos[h[j]] = (int8_t)j;
+  return 1;
+}
+
+/**
+  * @brief  Sifts the min-heap down starting with child position i (1 compares
+  *         against the median).
+  */
+static void MED_MinSortDown(MED_FilterTypeDef* MEDx, int32_t i)
+{
+  for (; i <= MED_MINCT(MEDx); i *= 2)
+  {
+    if ((i > 1) && (i < MED_MINCT(MEDx)) && (MED_ITEM(MEDx, i + 1) < MED_ITEM(MEDx, i)))
+    {
+      i++;
+    }
+    if (!MED_CmpExch(MEDx, i, i / 2))
+    {
+      break;
+    }
+  }
+}
+
+/**
+  * @brief  Sifts the max-heap down starting with child position i (negative,
+  *         -1 compares against the median).
+  */
+static void MED_MaxSortDown(MED_FilterTypeDef* MEDx, int32_t i)
+{
+  for (; i >= -MED_MAXCT(MEDx); i *= 2)
+  {
+    if ((i < -1) && (i > -MED_MAXCT(MEDx)) && (MED_ITEM(MEDx, i) < MED_ITEM(MEDx, i - 1)))
+    {
+      i--;
+    }
+    if (!MED_CmpExch(MEDx, i / 2, i))
+    {
+      break;
+    }
+  }
+}
+
+/**
+  * @brief  Sifts min-heap position i towards the median.
+  * @retval 1 if the item reached position 0.
+  */
+static int32_t MED_MinSortUp(MED_FilterTypeDef* MEDx, int32_t i)
+{
+  while ((i > 0) && MED_CmpExch(MEDx, i, i / 2))
+  {
+    i /= 2;
+  }
+  return (i == 0);
+}
+
+/**
+  * @brief  Sifts max-heap position i towards the median.
+  * @retval 1 if the item reached position 0.
+  */
+static int32_t MED_MaxSortUp(MED_FilterTypeDef* MEDx, int32_t i)
+{
+  while ((i < 0) && MED_CmpExch(MEDx, i / 2, i))
+  {
+    i /= 2;
+  }
+  return (i == 0);
+}
+
+/**
+  * @brief  Replaces the oldest sample in place and restores the heap order.
+  * @param  MEDx: pointer to the filter.
+  * @param  Sample: new sample.
+  * @retval None
+  */
+static void MED_Insert(MED_FilterTypeDef* MEDx, uint16_t Sample)
+{
+  int32_t isNew = (MEDx->Count < MEDx->Window);
+  int32_t p = MEDx->Pos[MEDx->Idx];
+  uint16_t old = MEDx->Data[MEDx->Idx];
+
+  MEDx->Data[MEDx->Idx] = Sample;
+  MEDx->Idx = (MEDx->Idx + 1 == MEDx->Window) ? 0 : MEDx->Idx + 1;
+  MEDx->Count += isNew;
+  if (p > 0)
+  {
+    if (!isNew && (old < Sample))
+    {
+      MED_MinSortDown(MEDx, p * 2);
+    }
+    else if (MED_MinSortUp(MEDx, p))
+    {
+      MED_MaxSortDown(MEDx, -1);
+    }
+  }
+  else if (p < 0)
+  {
+    if (!isNew && (Sample < old))
+    {
+      MED_MaxSortDown(MEDx, p * 2);
+    }
+    else if (MED_MaxSortUp(MEDx, p))
+    {
+      MED_MinSortDown(MEDx, 1);
+    }
+  }
+  else
+  {
+    if (MED_MAXCT(MEDx) != 0)
+    {
+      MED_MaxSortDown(MEDx, -1);
+    }
+    if (MED_MINCT(MEDx) != 0)
+    {
+      MED_MinSortDown(MEDx, 1);
+    }
+  }
+}
+
+/**
+  * @brief  Median of five, six comparisons.
+  * @retval Third smallest of a..e.
+  */
+static uint16_t MED_Median5(uint16_t a, uint16_t b, uint16_t c, uint16_t d, uint16_t e)
+{
+  if (b < a)
+  {
+    MED_SWAP16(a, b);
+  }
+  if (d < c)
+  {
+    MED_SWAP16(c, d);
+  }
+  if (c < a)                /* a or c is the minimum of a..d, drop it */
+  {
+    MED_SWAP16(b, d);
+    c = a;
+  }
+  a = e;
+  if (b < a)
+  {
+    MED_SWAP16(a, b);
+  }
+  if (a < c)                /* a or c is the minimum of the remaining four */
+  {
+    MED_SWAP16(b, d);
+    a = c;
+  }
+  return (d < a) ? d : a;
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,83 @@
+/**
+ * @file    nc_median.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Sliding-window median spike filter
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_MEDIAN_H
+#define NC_MEDIAN_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_MEDIAN_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define MED_MAX_WINDOW                63      /*!< Odd, heap positions must fit an int8_t */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  Median filter state of one channel.
+  * @note   Heap is a max-heap at negative and a min-heap at positive positions
+  *         around the median at position 0. Pos maps a sample slot to its heap
+  *         position so the oldest sample is replaced where it sits instead of
+  *         being searched for.
+  */
+typedef struct
+{
+  uint16_t Data[MED_MAX_WINDOW];    /*!< Window samples in arrival order (ring) */
+  int8_t   Pos[MED_MAX_WINDOW];     /*!< Heap position of each Data slot */
+  int8_t   HeapBuf[MED_MAX_WINDOW]; /*!< Data slot at each heap position */
+  int8_t*  pHeap;                   /*!< HeapBuf + Window / 2, position 0 */
+  uint8_t  Window;                  /*!< Odd window length, 3 to MED_MAX_WINDOW */
+  uint8_t  Idx;                     /*!< Slot the next sample replaces */
+  uint8_t  Count;                   /*!< Samples seen, saturates at Window */
+}MED_FilterTypeDef;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+int32_t MED_Init(MED_FilterTypeDef* MEDx, uint8_t Window);
+uint16_t MED_Push(MED_FilterTypeDef* MEDx, uint16_t Sample);
+void MED_FilterBlock(MED_FilterTypeDef* MEDx, const uint16_t* pSrc, uint16_t* pDst, uint32_t Stride, uint32_t Count);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_MEDIAN_H */
@@ -0,0 +1,190 @@
+/**
+ * @file    nc_pack12.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Packed 12-bit sample storage, two samples per three bytes
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_pack12.h"
+
+/** @defgroup P12
+  * @brief 12-bit samples at 1.5 bytes each
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] A packed buffer is a little-endian bit stream of 12-bit codes, sample i
+         in bits 12i .. 12i+11, stored in P12_WORDS(N) words. It takes 75% of
+         the RAM of uint16_t samples and 37.5% of uint32_t ones.
+    [..] P12_Pack() and P12_Unpack() convert whole blocks, 8 samples (3 words)
+         per iteration with a per-sample tail; interleaved scans keep their
+         order, so rank r of frame f is sample f * NumRegular + r. P12_Get() and
+         P12_Set() reach single samples.
+    [..] The DMA cannot write packed data: the ADC stream halves and the
+         capture pool stay uint16_t, and packing is always a copy out of them
+         into storage of its own. DMA stream: call P12_Pack() from the
+         DMA_BlockCallback on the half that just completed. Capture engine:
+         CAP_Pack() copies a frozen record out of its DMA buffer so the buffer
+         can go back to the pool at once; the saving is in the records kept,
+         not in the pool. Packed data is only valid on a little-endian core,
+         which the Cortex-M3 and the x86 hosts are.
+
+                         ##### Cycle model #####
+    [..] Per 8 samples: 8 halfword loads, 8 masks, 14 shifts and ORs, 3 word
+         stores, about 36 cycles or 4.5 cycles per sample; unpacking is about
+         the same. Masking keeps stray high bits of left aligned or
+         oversampled data out of the neighbours.
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define P12_MASK                  0x0FFF
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Packs Count samples from the start of a packed buffer.
+  * @param  pSrc: right aligned 12-bit samples.
+  * @param  pDst: P12_WORDS(Count) words.
+  * @param  Count: samples.
+  * @retval None
+  */
+void P12_Pack(const uint16_t* pSrc, uint32_t* pDst, uint32_t Count)
+{
+  uint32_t s0, s1, s2, s3, s4, s5, s6, s7;
+  uint32_t n;
+
+  for (n = Count >> 3; n != 0; n--)
+  {
+    s0 = pSrc[0] & P12_MASK;
+    s1 = pSrc[1] & P12_MASK;
+    s2 = pSrc[2] & P12_MASK;
+    s3 = pSrc[3] & P12_MASK;
+    s4 = pSrc[4] & P12_MASK;
+    s5 = pSrc[5] & P12_MASK;
+    s6 = pSrc[6] & P12_MASK;
+    s7 = pSrc[7] & P12_MASK;
+    pDst[0] = s0 | (s1 << 12) | (s2 << 24);
+    pDst[1] = (s2 >> 8) | (s3 << 4) | (s4 << 16) | (s5 << 28);
+    pDst[2] = (s5 >> 4) | (s6 << 8) | (s7 << 20);
+    pSrc += 8;
+    pDst += 3;
+  }
+  for (n = 0; n < (Count & 7); n++)
+  {
+    P12_Set(pDst, n, pSrc[n]);
+  }
+}
+
+/**
+  * @brief  Unpacks Count samples from the start of a packed buffer.
+  * @param  pSrc: packed buffer.
+  * @param  pDst: Count right aligned samples.
+  * @param  Count: samples.
+  * @retval None
+  */
+void P12_Unpack(const uint32_t* pSrc, uint16_t* pDst, uint32_t Count)
+{
+  uint32_t w0, w1, w2;
+  uint32_t n;
+
+  for (n = Count >> 3; n != 0; n--)
+  {
+    w0 = pSrc[0];
+    w1 = pSrc[1];
+    w2 = pSrc[2];
+    pDst[0] = (uint16_t)(w0 & P12_MASK);
+    pDst[1] = (uint16_t)((w0 >> 12) & P12_MASK);
+    pDst[2] = (uint16_t)((w0 >> 24) | ((w1 << 8) & P12_MASK));
+    pDst[3] = (uint16_t)((w1 >> 4) & P12_MASK);
+    pDst[4] = (uint16_t)((w1 >> 16) & P12_MASK);
+    pDst[5] = (uint16_t)((w1 >> 28) | ((w2 << 4) & P12_MASK));
+    pDst[6] = (uint16_t)((w2 >> 8) & P12_MASK);
+    pDst[7] = (uint16_t)(w2 >> 20);
+    pSrc += 3;
+    pDst += 8;
+  }
+  for (n = 0; n < (Count & 7); n++)
+  {
+    pDst[n] = P12_Get(pSrc, n);
+  }
+}
+
+/**
+  * @brief  Reads one sample of a packed buffer.
+  * @param  pSrc: packed buffer.
+  * @param  Index: sample index.
+  * @retval Right aligned 12-bit sample.
+  */
+uint16_t P12_Get(const uint32_t* pSrc, uint32_t Index)
+{
+  const uint8_t* b = (const uint8_t*)pSrc + ((Index * 3) >> 1);
+  uint32_t v = b[0] | ((uint32_t)b[1] << 8);
+
+  return (uint16_t)((Index & 1) ? (v >> 4) : (v & P12_MASK));
+}
+
+/**
+  * @brief  Writes one sample of a packed buffer, leaving its neighbours.
+  * @param  pDst: packed buffer.
+  * @param  Index: sample index.
+  * @param  Value: right aligned 12-bit sample.
+  * @retval None
+  */
+void P12_Set(uint32_t* pDst, uint32_t Index, uint16_t Value)
+{
+  uint8_t* b = (uint8_t*)pDst + ((Index * 3) >> 1);
+
+  if (Index & 1)
+  {
+    b[0] = (uint8_t)((b[0] & 0x0F) | (Value << 4));
+    b[1] = (uint8_t)(Value >> 4);
+  }
+  else
+  {
+    b[0] = (uint8_t)Value;
+    b[1] = (uint8_t)((b[1] & 0xF0) | ((Value >> 8) & 0x0F));
+  }
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
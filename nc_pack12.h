@@ -0,0 +1,71 @@
+/**
+ * @file    nc_pack12.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Packed 12-bit sample storage, two samples per three bytes
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_PACK12_H
+#define NC_PACK12_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_PACK12_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* Words of packed storage for N samples, 3 words per 8 samples. The DMA
+   writes uint16_t only: packed buffers are copies, e.g. CAP_Pack() of a
+   frozen capture, never the buffer the DMA fills */
+#define P12_WORDS(N)                  ((((uint32_t)(N)) * 3 + 7) / 8)
+
+/* Bytes the N samples occupy, ceil(12N / 8): the exact length to send */
+#define P12_BYTES(N)                  ((((uint32_t)(N)) * 3 + 1) / 2)
+
+/* Exported functions ------------------------------------------------------- */
+void P12_Pack(const uint16_t* pSrc, uint32_t* pDst, uint32_t Count);
+void P12_Unpack(const uint32_t* pSrc, uint16_t* pDst, uint32_t Count);
+uint16_t P12_Get(const uint32_t* pSrc, uint32_t Index);
+void P12_Set(uint32_t* pDst, uint32_t Index, uint16_t Value);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_PACK12_H */
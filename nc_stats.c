@@ -0,0 +1,272 @@
+/**
+ * @file    nc_stats.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Windowed per-channel streaming statistics
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_stats.h"
+#include "nc_fixmath.h"
+
+/** @defgroup STAT
+  * @brief Streaming min/max/mean/RMS/variance per channel
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] STAT_Init() with the regular scan length, STAT_SetWindow() per channel
+         (e.g. the channel sample rate for one record per second).
+    [..] Feed regular data with STAT_PushBlock() on each DMA block and injected
+         data with STAT_PushInjected() from the JEOC handler. The main loop drains
+         the summary records with STAT_GetRecord().
+    [..] Per sample: one compare pair, one add and one multiply-accumulate (UMLAL).
+         Division and square root only run once per window, when the record is
+         built.
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define STAT_QUEUE_MASK           (STAT_QUEUE_SIZE - 1)
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void STAT_Close(STAT_BankTypeDef* STATx, uint8_t Channel);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Clears every accumulator and the record queue, all windows disabled.
+  * @param  STATx: pointer to the bank.
+  * @param  NumRegular: ranks in one regular scan, 1 to STAT_REGULAR_CHANNELS.
+  * @retval 0 on success, -1 if NumRegular is out of range; the bank is then
+  *         left as it was.
+  */
+int32_t STAT_Init(STAT_BankTypeDef* STATx, uint8_t NumRegular)
+{
+  uint32_t ch;
+
+  if ((NumRegular == 0) || (NumRegular > STAT_REGULAR_CHANNELS))
+  {
+    return -1;
+  }
+  for (ch = 0; ch < STAT_MAX_CHANNELS; ch++)
+  {
+    STATx->Accu[ch].WindowLen = 0;
+    STATx->Accu[ch].Count = 0;
+    STATx->Accu[ch].Window = 0;
+  }
+  STATx->Head = 0;
+  STATx->Tail = 0;
+  STATx->Dropped = 0;
+  STATx->NumRegular = NumRegular;
+  return 0;
+}
+
+/**
+  * @brief  Sets the window length of one channel and restarts its window.
+  * @param  STATx: pointer to the bank.
+  * @param  Channel: rank, or STAT_INJECTED_BASE + injected rank.
+  * @param  WindowLen: samples per summary record, up to STAT_MAX_WINDOW, 0 to
+  *         disable the channel.
+  * @retval 0 on success, -1 if Channel or WindowLen is out of range; the
+  *         channel is then left as it was.
+  */
+int32_t STAT_SetWindow(STAT_BankTypeDef* STATx, uint8_t Channel, uint32_t WindowLen)
+{
+  if ((Channel >= STAT_MAX_CHANNELS) || (WindowLen > STAT_MAX_WINDOW))
+  {
+    return -1;
+  }
+  STATx->Accu[Channel].WindowLen = WindowLen;
+  STATx->Accu[Channel].Count = 0;
+  return 0;
+}
+
+/**
+  * @brief  Adds one sample to a channel, emitting a record when its window is full.
+  * @param  STATx: pointer to the bank.
+  * @param  Channel: rank, or STAT_INJECTED_BASE + injected rank.
+  * @param  Sample: ADC code.
+  * @retval None
+  */
+void STAT_Push(STAT_BankTypeDef* STATx, uint8_t Channel, uint16_t Sample)
+{
+  STAT_AccuTypeDef* a = &STATx->Accu[Channel];
+  int32_t d;
+
+  if (a->WindowLen == 0)
+  {
+    return;
+  }
+  if (a->Count == 0)
+  {
+    a->Ref   = Sample;
+    a->Min   = Sample;
+    a->Max   = Sample;
+    a->SumD  = 0;
+    a->SumD2 = 0;
+  }
+  else
+  {
+    if (Sample < a->Min)
+    {
+      a->Min = Sample;
+    }
+    else if (Sample > a->Max)
+    {
+      a->Max = Sample;
+    }
+    d = (int32_t)Sample - a->Ref;
+    a->SumD  += d;
+    a->SumD2 += (uint64_t)((int64_t)d * d);
+  }
+  if (++a->Count == a->WindowLen)
+  {
+    STAT_Close(STATx, Channel);
+  }
+}
+
+/**
+  * @brief  Adds an interleaved block of regular scans, rank r to channel r.
+  * @param  STATx: pointer to the bank.
+  * @param  pSrc: Frames * NumRegular ADC codes, scan order.
+  * @param  Frames: number of complete scans in the block.
+  * @retval None
+  */
+void STAT_PushBlock(STAT_BankTypeDef* STATx, const uint16_t* pSrc, uint32_t Frames)
+{
+  uint32_t nreg = STATx->NumRegular;
+  uint32_t ch;
+
+  while (Frames-- != 0)
+  {
+    for (ch = 0; ch < nreg; ch++)
+    {
+      STAT_Push(STATx, (uint8_t)ch, *pSrc++);
+    }
+  }
+}
+
+/**
+  * @brief  Adds the injected conversions of one JEOC event.
+  * @param  STATx: pointer to the bank.
+  * @param  pJdr: Count values read from JDR1..JDRn.
+  * @param  Count: injected sequence length, 1 to STAT_INJECTED_CHANNELS.
+  * @retval None
+  */
+void STAT_PushInjected(STAT_BankTypeDef* STATx, const uint16_t* pJdr, uint8_t Count)
+{
+  uint32_t i;
+
+  for (i = 0; i < Count; i++)
+  {
+    STAT_Push(STATx, (uint8_t)(STAT_INJECTED_BASE + i), pJdr[i]);
+  }
+}
+
+/**
+  * @brief  Takes the oldest summary record out of the queue.
+  * @param  STATx: pointer to the bank.
+  * @param  pRecord: receives the record.
+  * @retval 1 if a record was returned, 0 if the queue is empty.
+  */
+uint32_t STAT_GetRecord(STAT_BankTypeDef* STATx, STAT_RecordTypeDef* pRecord)
+{
+  uint32_t tail = STATx->Tail;
+
+  if (tail == STATx->Head)
+  {
+    return 0;
+  }
+  *pRecord = STATx->Queue[tail & STAT_QUEUE_MASK];
+  STATx->Tail = tail + 1;
+  return 1;
+}
+
+/**
+  * @brief  Turns a full window into a record and restarts the window.
+  * @param  STATx: pointer to the bank.
+  * @param  Channel: channel whose window is complete.
+  * @retval None
+  */
+static void STAT_Close(STAT_BankTypeDef* STATx, uint8_t Channel)
+{
+  STAT_AccuTypeDef* a = &STATx->Accu[Channel];
+  STAT_RecordTypeDef* r;
+  uint32_t head = STATx->Head;
+  int64_t n = a->Count;
+  int64_t mean16, quot, rem;
+  uint64_t var8;
+
+  if ((head - STATx->Tail) >= STAT_QUEUE_SIZE)
+  {
+    STATx->Dropped++;
+  }
+  else
+  {
+    r = &STATx->Queue[head & STAT_QUEUE_MASK];
+
+    /* mean = Ref + SumD / n, kept with 4 fractional bits */
+    mean16 = (int64_t)a->Ref * 16 + ((int64_t)a->SumD * 16 + ((a->SumD >= 0) ? n / 2 : -n / 2)) / n;
+    /* var = (SumD2 - SumD^2 / n) / n, kept with 8 fractional bits. SumD^2 * 256
+       would overflow past ~46k samples, so with SumD = quot * n + rem it is
+       split into 256 * quot * (SumD + rem), an integer, plus 256 * rem^2 / n,
+       |rem| < n: both stay below 2^63 up to STAT_MAX_WINDOW and the floor is
+       unchanged. */
+    quot = a->SumD / n;
+    rem  = a->SumD - quot * n;
+    var8 = ((a->SumD2 * 256) - (uint64_t)(quot * (a->SumD + rem) * 256) - (uint64_t)((rem * rem * 256) / n)) / (uint64_t)n;
+
+    r->Window  = a->Window;
+    r->Count   = a->Count;
+    r->Var     = (uint32_t)var8;
+    r->Min     = a->Min;
+    r->Max     = a->Max;
+    r->Mean    = (uint16_t)mean16;
+    r->Rms     = (uint16_t)NC_ISqrt64(var8 + (uint64_t)(mean16 * mean16));  /* sqrt(var + mean^2) */
+    r->Channel = Channel;
+    STATx->Head = head + 1;
+  }
+  a->Window++;
+  a->Count = 0;
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,120 @@
+/**
+ * @file    nc_stats.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Windowed per-channel streaming statistics
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_STATS_H
+#define NC_STATS_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_STATS_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define STAT_REGULAR_CHANNELS         28      /*!< Regular sequence ranks SQ1..SQ28 */
+#define STAT_INJECTED_CHANNELS        4       /*!< Injected ranks JDR1..JDR4 */
+#define STAT_MAX_CHANNELS             (STAT_REGULAR_CHANNELS + STAT_INJECTED_CHANNELS)
+#define STAT_INJECTED_BASE            STAT_REGULAR_CHANNELS
+#define STAT_QUEUE_SIZE               16      /*!< Summary records, power of two */
+#define STAT_MAX_WINDOW               (1UL << 24)  /*!< Samples per window, keeps every 64-bit product in range */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  One window summary of one channel.
+  */
+typedef struct
+{
+  uint32_t Window;            /*!< Window sequence number of this channel */
+  uint32_t Count;             /*!< Samples in the window */
+  uint32_t Var;               /*!< Population variance, codes^2 in Q8 */
+  uint16_t Min;               /*!< Codes */
+  uint16_t Max;               /*!< Codes */
+  uint16_t Mean;              /*!< Codes in Q4 */
+  uint16_t Rms;               /*!< Codes in Q4 */
+  uint8_t  Channel;           /*!< Rank, STAT_INJECTED_BASE + n for injected rank n */
+}STAT_RecordTypeDef;
+
+/**
+  * @brief  Running sums of one channel.
+  * @note   Samples are summed relative to Ref, the first sample of the window.
+  *         Integer sums are exact, so the shifted sum of squares gives the
+  *         variance without the cancellation a plain sum of x^2 suffers from
+  *         and without the per-sample division of Welford's update.
+  */
+typedef struct
+{
+  uint32_t WindowLen;         /*!< Samples per window, 0 disables the channel */
+  uint32_t Count;
+  uint32_t Window;
+  int64_t  SumD;              /*!< Sum of (x - Ref), past int32 after 2^31 / 4095 samples */
+  uint64_t SumD2;             /*!< Sum of (x - Ref)^2 */
+  uint16_t Ref;
+  uint16_t Min;
+  uint16_t Max;
+}STAT_AccuTypeDef;
+
+/**
+  * @brief  Accumulator bank plus the queue of finished records.
+  */
+typedef struct
+{
+  STAT_AccuTypeDef Accu[STAT_MAX_CHANNELS];
+  STAT_RecordTypeDef Queue[STAT_QUEUE_SIZE];
+  volatile uint32_t Head;     /*!< Written by the producer (ADC/DMA interrupt) */
+  volatile uint32_t Tail;     /*!< Written by the consumer */
+  uint32_t Dropped;           /*!< Records lost because the queue was full */
+  uint8_t  NumRegular;        /*!< Ranks in the regular scan */
+}STAT_BankTypeDef;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+int32_t STAT_Init(STAT_BankTypeDef* STATx, uint8_t NumRegular);
+int32_t STAT_SetWindow(STAT_BankTypeDef* STATx, uint8_t Channel, uint32_t WindowLen);
+void STAT_Push(STAT_BankTypeDef* STATx, uint8_t Channel, uint16_t Sample);
+void STAT_PushBlock(STAT_BankTypeDef* STATx, const uint16_t* pSrc, uint32_t Frames);
+void STAT_PushInjected(STAT_BankTypeDef* STATx, const uint16_t* pJdr, uint8_t Count);
+uint32_t STAT_GetRecord(STAT_BankTypeDef* STATx, STAT_RecordTypeDef* pRecord);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_STATS_H */
@@ -0,0 +1,192 @@
+/**
+ * @file    nc_stm32l1_cfg.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Binary acquisition profile loader for STM32L1xx devices
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_stm32l1_cfg.h"
+#include "nc_stm32l1_crc.h"
+
+/** @defgroup CFG
+  * @brief Acquisition profile loader
+  *
+@verbatim
+ ===============================================================================
+                      ##### Profile blob format #####
+ ===============================================================================
+    [..] A profile is a CFG_HeaderTypeDef followed by Count records of 8 bytes.
+         Each record is either a 32-bit store to one RCC/ADC/ADC1/TIM3 register or,
+         with CFG_POLL in Offset, a wait until the given bits read back as set,
+         abandoned after CFG_POLL_TIMEOUT reads.
+    [..] The records are applied in blob order, so the blob author writes them in
+         the order the hardware needs, e.g. for the init_ADC()/init_TIM3() setup:
+         (#) CFG_STORE(RCC, RCC_TypeDef, CR, HSION), CFG_WAIT(RCC, RCC_TypeDef, CR, HSIRDY),
+             then APB2ENR/APB1ENR.
+         (#) ADC1 CR2 with ADON cleared, CR1, SMPRx, SQRx, JSQR, HTR/LTR.
+         (#) ADC1 CR2 with ADON set, CFG_WAIT(ADC1, ADC_TypeDef, SR, ADC_SR_ADONS).
+         (#) TIM3 PSC, ARR, CCRx, CCMRx, CCER, EGR = UG, and CR1 with CEN last.
+    [..] CFG_Seal() fills the header and CRC of a blob built in RAM, a host tool
+         producing flash images must compute the same CRC_CalcBlockCRC().
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define CFG_RECORD_WORDS          (sizeof(CFG_RecordTypeDef) / sizeof(uint32_t))
+
+/* Private macro -------------------------------------------------------------*/
+#define CFG_RECORDS(BLOB)         ((const CFG_RecordTypeDef*)((BLOB) + 1))
+
+/* Private variables ---------------------------------------------------------*/
+/* Base address and register window size of each CFG_Periph_x, indexed by rank */
+static const uint32_t CFG_PeriphBase[CFG_Periph_Count] =
+{
+  RCC_BASE, ADC_BASE, ADC1_BASE, TIM3_BASE
+};
+
+static const uint16_t CFG_PeriphSize[CFG_Periph_Count] =
+{
+  sizeof(RCC_TypeDef), sizeof(ADC_Common_TypeDef), sizeof(ADC_TypeDef), sizeof(TIM_TypeDef)
+};
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Checks a profile blob without touching the hardware.
+  * @note   Rejects a wrong magic or major version, an empty or oversized record
+  *         list, a CRC mismatch, unknown peripherals, unaligned or out of window
+  *         offsets and records that are not sorted by peripheral rank.
+  * @param  CFG_Blob: pointer to the profile header.
+  * @retval SUCCESS if the blob can be applied, ERROR otherwise.
+  */
+ErrorStatus CFG_Validate(const CFG_HeaderTypeDef* CFG_Blob)
+{
+  const CFG_RecordTypeDef* rec;
+  uint32_t i;
+  uint16_t offset;
+  uint16_t rank = 0;
+
+  if ((CFG_Blob->Magic != CFG_MAGIC) ||
+      (CFG_VERSION_MAJOR(CFG_Blob->Version) != CFG_VERSION_MAJOR(CFG_VERSION)) ||
+      (CFG_Blob->Count == 0) || (CFG_Blob->Count > CFG_MAX_RECORDS))
+  {
+    return ERROR;
+  }
+
+  rec = CFG_RECORDS(CFG_Blob);
+  if (CRC_CalcBlockCRC((const uint32_t*)rec, CFG_Blob->Count * CFG_RECORD_WORDS) != CFG_Blob->Crc)
+  {
+    return ERROR;
+  }
+
+  for (i = 0; i < CFG_Blob->Count; i++, rec++)
+  {
+    offset = (uint16_t)(rec->Offset & ~CFG_POLL);
+    if ((rec->Periph >= CFG_Periph_Count) || (rec->Periph < rank) ||
+        ((offset & 0x3) != 0) || (offset >= CFG_PeriphSize[rec->Periph]))
+    {
+      return ERROR;
+    }
+    rank = rec->Periph;
+  }
+  return SUCCESS;
+}
+
+/**
+  * @brief  Validates then applies a profile blob.
+  * @note   Nothing is written unless the whole blob is valid. The records are then
+  *         replayed by a single loop: one table lookup and one store (or one wait)
+  *         per record. A wait that times out stops the replay, the records before
+  *         it stay applied.
+  * @param  CFG_Blob: pointer to the profile header, typically in flash.
+  * @retval SUCCESS if the profile was applied, ERROR if it was rejected or a
+  *         wait record timed out.
+  */
+ErrorStatus CFG_Apply(const CFG_HeaderTypeDef* CFG_Blob)
+{
+  const CFG_RecordTypeDef* rec;
+  const CFG_RecordTypeDef* end;
+  __IO uint32_t* reg;
+  uint32_t count;
+
+  if (CFG_Validate(CFG_Blob) != SUCCESS)
+  {
+    return ERROR;
+  }
+
+  rec = CFG_RECORDS(CFG_Blob);
+  end = rec + CFG_Blob->Count;
+  for (; rec < end; rec++)
+  {
+    reg = (__IO uint32_t*)(CFG_PeriphBase[rec->Periph] + (rec->Offset & ~CFG_POLL));
+    if ((rec->Offset & CFG_POLL) == 0)
+    {
+      *reg = rec->Value;
+    }
+    else
+    {
+      count = 0;
+      while(((*reg & rec->Value) != rec->Value) && (count != CFG_POLL_TIMEOUT)){
+        count++;
+      }
+      if ((*reg & rec->Value) != rec->Value)
+      {
+        return ERROR;
+      }
+    }
+  }
+  return SUCCESS;
+}
+
+/**
+  * @brief  Fills the header of a blob whose records are already in place.
+  * @param  CFG_Blob: pointer to the header, the Count records must follow it.
+  * @param  Count: number of records.
+  * @retval None
+  */
+void CFG_Seal(CFG_HeaderTypeDef* CFG_Blob, uint16_t Count)
+{
+  CFG_Blob->Magic   = CFG_MAGIC;
+  CFG_Blob->Version = CFG_VERSION;
+  CFG_Blob->Count   = Count;
+  CFG_Blob->Crc     = CRC_CalcBlockCRC((const uint32_t*)CFG_RECORDS(CFG_Blob), Count * CFG_RECORD_WORDS);
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,123 @@
+/**
+ * @file    nc_stm32l1_cfg.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Binary acquisition profile loader for STM32L1xx devices
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_STM32L1_CFG_H
+#define NC_STM32L1_CFG_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_STM32L1_CFG_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "stm32l1xx.h"
+#include "nc_stm32l1_conf.h"
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  Profile blob header, immediately followed by Count CFG_RecordTypeDef.
+  */
+typedef struct
+{
+  uint32_t Magic;             /*!< CFG_MAGIC */
+  uint16_t Version;           /*!< CFG_VERSION the blob was built for */
+  uint16_t Count;             /*!< Number of records following the header */
+  uint32_t Crc;               /*!< CRC_CalcBlockCRC() over the records */
+}CFG_HeaderTypeDef;
+
+/**
+  * @brief  One register store, or one wait on register bits when Offset has CFG_POLL.
+  */
+typedef struct
+{
+  uint16_t Periph;            /*!< Target block, a value of @ref CFG_Peripherals */
+  uint16_t Offset;            /*!< Register byte offset in the block, optionally | CFG_POLL */
+  uint32_t Value;             /*!< Value stored, or bits waited for with CFG_POLL */
+}CFG_RecordTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+
+/** @defgroup CFG_Exported_Constants
+  * @{
+  */
+#define CFG_MAGIC                     ((uint32_t)0x4746434E)  /*!< "NCFG" little endian */
+#define CFG_VERSION                   ((uint16_t)0x0100)      /*!< Major 1, minor 0 */
+#define CFG_VERSION_MAJOR(V)          ((uint16_t)(V) >> 8)
+#define CFG_MAX_RECORDS               ((uint16_t)96)
+#define CFG_POLL                      ((uint16_t)0x8000)      /*!< Record waits until (reg & Value) == Value */
+#if !defined  (CFG_POLL_TIMEOUT)
+#define CFG_POLL_TIMEOUT              ((uint32_t)0x5000)      /*!< Reads per wait record before CFG_Apply() gives up */
+#endif
+
+/** @defgroup CFG_Peripherals
+  * @note   Records must be sorted by this rank: clocks first, then the ADC,
+  *         then TIM3 so the trigger source starts after the ADC is ready.
+  * @{
+  */
+#define CFG_Periph_RCC                ((uint16_t)0)
+#define CFG_Periph_ADC                ((uint16_t)1)           /*!< ADC common registers (CSR/CCR) */
+#define CFG_Periph_ADC1               ((uint16_t)2)
+#define CFG_Periph_TIM3               ((uint16_t)3)
+#define CFG_Periph_Count              ((uint16_t)4)
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Record initializers, e.g. CFG_STORE(ADC1, ADC_TypeDef, SMPR3, 7) */
+#define CFG_STORE(PERIPH, TYPE, REG, VALUE) \
+  { CFG_Periph_##PERIPH, (uint16_t)offsetof(TYPE, REG), (uint32_t)(VALUE) }
+#define CFG_WAIT(PERIPH, TYPE, REG, BITS) \
+  { CFG_Periph_##PERIPH, (uint16_t)(offsetof(TYPE, REG) | CFG_POLL), (uint32_t)(BITS) }
+
+/* Exported functions ------------------------------------------------------- */
+ErrorStatus CFG_Validate(const CFG_HeaderTypeDef* CFG_Blob);
+ErrorStatus CFG_Apply(const CFG_HeaderTypeDef* CFG_Blob);
+void CFG_Seal(CFG_HeaderTypeDef* CFG_Blob, uint16_t Count);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_STM32L1_CFG_H */
@@ -0,0 +1,327 @@
+/**
+ * @file    nc_stm32l1_dma.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   DMA1 controller driver and ADC1 circular stream
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_stm32l1_dma.h"
+#include "nc_stm32l1_rcc.h"
+#include "nc_stm32l1_gpio.h"
+#include "nc_defines.h"
+
+/** @addtogroup STM32L1xx_StdPeriph_Driver
+  * @{
+  */
+
+/** @defgroup DMA
+  * @brief DMA1 driver modules
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] Enable the DMA1 clock with RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE),
+         fill a DMA_InitTypeDef, DMA_Init() then DMA_Cmd(). The request map is fixed:
+         ADC1 on channel 1, USART1_TX on channel 4, USART1_RX on channel 5.
+    [..] For the usual acquisition path DMA_ADC1StreamInit() does all of it: ADC1_DR
+         into a circular buffer, half transfer and transfer complete interrupts, and
+         each half handed to a callback while the DMA fills the other one. Call
+         DMA_ADC1StreamIRQHandler() from DMA1_Channel1_IRQHandler. NC_PROBE_DMA_HT
+         and NC_PROBE_DMA_TC are high while the callbacks run.
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* DMA registers Masks */
+#define CCR_CLEAR_MASK            ((uint32_t)0xFFFF800F)  /* DMA Channel config registers Masks */
+#define DMA_CHANNEL_STRIDE        ((uint32_t)0x14)        /* Channel register block size */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static uint16_t* DMA_StreamBuffer;
+static uint32_t DMA_StreamHalf;
+static DMA_BlockCallback DMA_StreamHalfCallback;
+static DMA_BlockCallback DMA_StreamFullCallback;
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Deinitializes the DMAy Channelx registers to their default reset
+  *         values and clears its flags.
+  * @param  DMAy_Channelx: where x can be 1 to 7 to select the DMA1 Channel.
+  * @retval None
+  */
+void DMA_DeInit(DMA_Channel_TypeDef* DMAy_Channelx)
+{
+  uint32_t n;
+
+  /* Check the parameters */
+  assert_param(IS_DMA_ALL_PERIPH(DMAy_Channelx));
+
+  /* Disable the selected DMAy Channelx, then reset its registers */
+  DMAy_Channelx->CCR &= (uint16_t)(~DMA_CCR1_EN);
+  DMAy_Channelx->CCR = 0;
+  DMAy_Channelx->CNDTR = 0;
+  DMAy_Channelx->CPAR = 0;
+  DMAy_Channelx->CMAR = 0;
+
+  /* Channel number from the register block address */
+  n = ((uint32_t)DMAy_Channelx - DMA1_Channel1_BASE) / DMA_CHANNEL_STRIDE + 1;
+  DMA1->IFCR = DMA1_IT_GL(n) | DMA1_IT_TC(n) | DMA1_IT_HT(n) | DMA1_IT_TE(n);
+}
+
+/**
+  * @brief  Initializes the DMAy Channelx according to the specified parameters
+  *         in the DMA_InitStruct. The channel is left disabled.
+  * @param  DMAy_Channelx: where x can be 1 to 7 to select the DMA1 Channel.
+  * @param  DMA_InitStruct: pointer to a DMA_InitTypeDef structure.
+  * @retval None
+  */
+void DMA_Init(DMA_Channel_TypeDef* DMAy_Channelx, DMA_InitTypeDef* DMA_InitStruct)
+{
+  /* Check the parameters */
+  assert_param(IS_DMA_ALL_PERIPH(DMAy_Channelx));
+
+  /* One store of CCR: direction, mode, increments, sizes, priority and M2M */
+  DMAy_Channelx->CCR = (DMAy_Channelx->CCR & CCR_CLEAR_MASK & ~DMA_CCR1_EN) |
+                       DMA_InitStruct->DMA_DIR | DMA_InitStruct->DMA_Mode |
+                       DMA_InitStruct->DMA_PeripheralInc | DMA_InitStruct->DMA_MemoryInc |
+                       DMA_InitStruct->DMA_PeripheralDataSize | DMA_InitStruct->DMA_MemoryDataSize |
+                       DMA_InitStruct->DMA_Priority | DMA_InitStruct->DMA_M2M;
+  DMAy_Channelx->CNDTR = DMA_InitStruct->DMA_BufferSize;
+  DMAy_Channelx->CPAR = DMA_InitStruct->DMA_PeripheralBaseAddr;
+  DMAy_Channelx->CMAR = DMA_InitStruct->DMA_MemoryBaseAddr;
+}
+
+/**
+  * @brief  Fills each DMA_InitStruct member with its default value.
+  * @param  DMA_InitStruct: pointer to a DMA_InitTypeDef structure which will
+  *         be initialized.
+  * @retval None
+  */
+void DMA_StructInit(DMA_InitTypeDef* DMA_InitStruct)
+{
+  DMA_InitStruct->DMA_PeripheralBaseAddr = 0;
+  DMA_InitStruct->DMA_MemoryBaseAddr = 0;
+  DMA_InitStruct->DMA_DIR = DMA_DIR_PeripheralSRC;
+  DMA_InitStruct->DMA_BufferSize = 0;
+  DMA_InitStruct->DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+  DMA_InitStruct->DMA_MemoryInc = DMA_MemoryInc_Disable;
+  DMA_InitStruct->DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+  DMA_InitStruct->DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+  DMA_InitStruct->DMA_Mode = DMA_Mode_Normal;
+  DMA_InitStruct->DMA_Priority = DMA_Priority_Low;
+  DMA_InitStruct->DMA_M2M = DMA_M2M_Disable;
+}
+
+/**
+  * @brief  Enables or disables the specified DMAy Channelx.
+  * @param  DMAy_Channelx: where x can be 1 to 7 to select the DMA1 Channel.
+  * @param  NewState: new state of the DMAy Channelx.
+  *         This parameter can be: ENABLE or DISABLE.
+  * @retval None
+  */
+void DMA_Cmd(DMA_Channel_TypeDef* DMAy_Channelx, FunctionalState NewState)
+{
+  /* Check the parameters */
+  assert_param(IS_DMA_ALL_PERIPH(DMAy_Channelx));
+  assert_param(IS_FUNCTIONAL_STATE(NewState));
+
+  if (NewState != DISABLE)
+  {
+    DMAy_Channelx->CCR |= DMA_CCR1_EN;
+  }
+  else
+  {
+    DMAy_Channelx->CCR &= (uint16_t)(~DMA_CCR1_EN);
+  }
+}
+
+/**
+  * @brief  Sets the number of data units to transfer. Only while the channel
+  *         is disabled.
+  * @param  DMAy_Channelx: where x can be 1 to 7 to select the DMA1 Channel.
+  * @param  DataNumber: number of data units, 0 to 65535.
+  * @retval None
+  */
+void DMA_SetCurrDataCounter(DMA_Channel_TypeDef* DMAy_Channelx, uint16_t DataNumber)
+{
+  /* Check the parameters */
+  assert_param(IS_DMA_ALL_PERIPH(DMAy_Channelx));
+
+  DMAy_Channelx->CNDTR = DataNumber;
+}
+
+/**
+  * @brief  Returns the number of data units left in the current transfer.
+  * @param  DMAy_Channelx: where x can be 1 to 7 to select the DMA1 Channel.
+  * @retval Remaining data units.
+  */
+uint16_t DMA_GetCurrDataCounter(DMA_Channel_TypeDef* DMAy_Channelx)
+{
+  /* Check the parameters */
+  assert_param(IS_DMA_ALL_PERIPH(DMAy_Channelx));
+
+  return (uint16_t)DMAy_Channelx->CNDTR;
+}
+
+/**
+  * @brief  Enables or disables the specified DMAy Channelx interrupts.
+  * @param  DMAy_Channelx: where x can be 1 to 7 to select the DMA1 Channel.
+  * @param  DMA_IT: any combination of DMA_IT_TC, DMA_IT_HT and DMA_IT_TE.
+  * @param  NewState: new state of the specified DMA interrupts.
+  *         This parameter can be: ENABLE or DISABLE.
+  * @retval None
+  */
+void DMA_ITConfig(DMA_Channel_TypeDef* DMAy_Channelx, uint32_t DMA_IT, FunctionalState NewState)
+{
+  /* Check the parameters */
+  assert_param(IS_DMA_ALL_PERIPH(DMAy_Channelx));
+  assert_param(IS_DMA_CONFIG_IT(DMA_IT));
+  assert_param(IS_FUNCTIONAL_STATE(NewState));
+
+  if (NewState != DISABLE)
+  {
+    DMAy_Channelx->CCR |= DMA_IT;
+  }
+  else
+  {
+    DMAy_Channelx->CCR &= ~DMA_IT;
+  }
+}
+
+/**
+  * @brief  Checks whether any of the specified DMA1 interrupt flags is set.
+  * @param  DMAy_IT: DMA1_IT_GL(n), DMA1_IT_TC(n), DMA1_IT_HT(n) or DMA1_IT_TE(n).
+  * @retval SET or RESET.
+  */
+ITStatus DMA_GetITStatus(uint32_t DMAy_IT)
+{
+  return ((DMA1->ISR & DMAy_IT) != 0) ? SET : RESET;
+}
+
+/**
+  * @brief  Clears the DMA1 interrupt pending bits.
+  * @note   IFCR is write-1-to-clear: a plain store, no read-modify-write.
+  * @param  DMAy_IT: any combination of DMA1_IT_x(n).
+  * @retval None
+  */
+void DMA_ClearITPendingBit(uint32_t DMAy_IT)
+{
+  DMA1->IFCR = DMAy_IT;
+}
+
+/**
+  * @brief  Streams ADC1_DR into a circular buffer and hands out each half.
+  * @note   ADC1 DMA requests (ADC_CR2 DMA and DDS) are left to the ADC set-up.
+  *         The DMA1_Channel1 interrupt still has to be enabled in the NVIC.
+  * @param  pBuffer: Count half-words, Count even (a multiple of twice the scan
+  *         length keeps every half frame-aligned).
+  * @param  Count: buffer length in samples.
+  * @param  HalfCallback: gets the first half once it is full.
+  * @param  FullCallback: gets the second half once it is full.
+  * @retval None
+  */
+void DMA_ADC1StreamInit(uint16_t* pBuffer, uint16_t Count, DMA_BlockCallback HalfCallback, DMA_BlockCallback FullCallback)
+{
+  DMA_InitTypeDef DMA_InitStructure;
+
+  DMA_StreamBuffer = pBuffer;
+  DMA_StreamHalf = Count / 2;
+  DMA_StreamHalfCallback = HalfCallback;
+  DMA_StreamFullCallback = FullCallback;
+
+  RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+  DMA_DeInit(DMA1_Channel1);
+  DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&ADC1->DR;
+  DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)pBuffer;
+  DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+  DMA_InitStructure.DMA_BufferSize = Count;
+  DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+  DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+  DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+  DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_HalfWord;
+  DMA_InitStructure.DMA_Mode = DMA_Mode_Circular;
+  DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+  DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+  DMA_Init(DMA1_Channel1, &DMA_InitStructure);
+  DMA_ITConfig(DMA1_Channel1, DMA_IT_HT | DMA_IT_TC, ENABLE);
+  DMA_Cmd(DMA1_Channel1, ENABLE);
+}
+
+/**
+  * @brief  DMA1 channel 1 half/complete dispatch for the ADC1 stream.
+  * @note   Both flags are sampled once: if the handler ran late and both halves
+  *         are done, the first half is still handed out before the second.
+  *         Only the flags seen are cleared; writing GL would clear all of them,
+  *         losing a TC set between the read and the write.
+  * @retval None
+  */
+void DMA_ADC1StreamIRQHandler(void)
+{
+  uint32_t isr = DMA1->ISR;
+
+  DMA1->IFCR = isr & (DMA1_IT_TC(1) | DMA1_IT_HT(1));
+  if (isr & DMA1_IT_HT(1))
+  {
+    NC_PROBE_ON(NC_PROBE_DMA_HT);
+    if (DMA_StreamHalfCallback != 0)
+    {
+      DMA_StreamHalfCallback(DMA_StreamBuffer, DMA_StreamHalf);
+    }
+    NC_PROBE_OFF(NC_PROBE_DMA_HT);
+  }
+  if (isr & DMA1_IT_TC(1))
+  {
+    NC_PROBE_ON(NC_PROBE_DMA_TC);
+    if (DMA_StreamFullCallback != 0)
+    {
+      DMA_StreamFullCallback(DMA_StreamBuffer + DMA_StreamHalf, DMA_StreamHalf);
+    }
+    NC_PROBE_OFF(NC_PROBE_DMA_TC);
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,209 @@
+/**
+ * @file    nc_stm32l1_dma.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   DMA1 controller driver and ADC1 circular stream
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_STM32L1_DMA_H
+#define NC_STM32L1_DMA_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_STM32L1_DMA_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l1xx.h"
+#include "nc_stm32l1_conf.h"
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  DMA Init structures definition
+  */
+typedef struct
+{
+  uint32_t DMA_PeripheralBaseAddr;  /*!< Peripheral base address for DMAy Channelx */
+  uint32_t DMA_MemoryBaseAddr;      /*!< Memory base address for DMAy Channelx */
+  uint32_t DMA_DIR;                 /*!< Peripheral is the source or destination, @ref DMA_data_transfer_direction */
+  uint32_t DMA_BufferSize;          /*!< Data units to transfer, 1 to 65535 */
+  uint32_t DMA_PeripheralInc;       /*!< @ref DMA_peripheral_incremented_mode */
+  uint32_t DMA_MemoryInc;           /*!< @ref DMA_memory_incremented_mode */
+  uint32_t DMA_PeripheralDataSize;  /*!< @ref DMA_peripheral_data_size */
+  uint32_t DMA_MemoryDataSize;      /*!< @ref DMA_memory_data_size */
+  uint32_t DMA_Mode;                /*!< @ref DMA_circular_normal_mode */
+  uint32_t DMA_Priority;            /*!< @ref DMA_priority_level */
+  uint32_t DMA_M2M;                 /*!< @ref DMA_memory_to_memory */
+}DMA_InitTypeDef;
+
+/**
+  * @brief  Block handler of the ADC1 stream, called from the DMA interrupt.
+  */
+typedef void (*DMA_BlockCallback)(uint16_t* pBlock, uint32_t Count);
+
+/* Exported constants --------------------------------------------------------*/
+#define IS_DMA_ALL_PERIPH(PERIPH) (((PERIPH) == DMA1_Channel1) || ((PERIPH) == DMA1_Channel2) || \
+                                   ((PERIPH) == DMA1_Channel3) || ((PERIPH) == DMA1_Channel4) || \
+                                   ((PERIPH) == DMA1_Channel5) || ((PERIPH) == DMA1_Channel6) || \
+                                   ((PERIPH) == DMA1_Channel7))
+
+/** @defgroup DMA_data_transfer_direction
+  * @{
+  */
+#define DMA_DIR_PeripheralDST              DMA_CCR1_DIR
+#define DMA_DIR_PeripheralSRC              ((uint32_t)0x00000000)
+/**
+  * @}
+  */
+
+/** @defgroup DMA_peripheral_incremented_mode
+  * @{
+  */
+#define DMA_PeripheralInc_Enable           DMA_CCR1_PINC
+#define DMA_PeripheralInc_Disable          ((uint32_t)0x00000000)
+/**
+  * @}
+  */
+
+/** @defgroup DMA_memory_incremented_mode
+  * @{
+  */
+#define DMA_MemoryInc_Enable               DMA_CCR1_MINC
+#define DMA_MemoryInc_Disable              ((uint32_t)0x00000000)
+/**
+  * @}
+  */
+
+/** @defgroup DMA_peripheral_data_size
+  * @{
+  */
+#define DMA_PeripheralDataSize_Byte        ((uint32_t)0x00000000)
+#define DMA_PeripheralDataSize_HalfWord    DMA_CCR1_PSIZE_0
+#define DMA_PeripheralDataSize_Word        DMA_CCR1_PSIZE_1
+/**
+  * @}
+  */
+
+/** @defgroup DMA_memory_data_size
+  * @{
+  */
+#define DMA_MemoryDataSize_Byte            ((uint32_t)0x00000000)
+#define DMA_MemoryDataSize_HalfWord        DMA_CCR1_MSIZE_0
+#define DMA_MemoryDataSize_Word            DMA_CCR1_MSIZE_1
+/**
+  * @}
+  */
+
+/** @defgroup DMA_circular_normal_mode
+  * @{
+  */
+#define DMA_Mode_Circular                  DMA_CCR1_CIRC
+#define DMA_Mode_Normal                    ((uint32_t)0x00000000)
+/**
+  * @}
+  */
+
+/** @defgroup DMA_priority_level
+  * @{
+  */
+#define DMA_Priority_VeryHigh              DMA_CCR1_PL
+#define DMA_Priority_High                  DMA_CCR1_PL_1
+#define DMA_Priority_Medium                DMA_CCR1_PL_0
+#define DMA_Priority_Low                   ((uint32_t)0x00000000)
+/**
+  * @}
+  */
+
+/** @defgroup DMA_memory_to_memory
+  * @{
+  */
+#define DMA_M2M_Enable                     DMA_CCR1_MEM2MEM
+#define DMA_M2M_Disable                    ((uint32_t)0x00000000)
+/**
+  * @}
+  */
+
+/** @defgroup DMA_interrupts_definition
+  * @{
+  */
+#define DMA_IT_TC                          DMA_CCR1_TCIE
+#define DMA_IT_HT                          DMA_CCR1_HTIE
+#define DMA_IT_TE                          DMA_CCR1_TEIE
+#define IS_DMA_CONFIG_IT(IT) ((((IT) & 0xFFFFFFF1) == 0x00) && ((IT) != 0x00))
+/**
+  * @}
+  */
+
+/** @defgroup DMA1_flags_definition
+  * @brief  Global, transfer complete, half transfer and error flags of channel n
+  *         sit at bits 4 * (n - 1) + 0..3 of DMA_ISR and DMA_IFCR.
+  * @{
+  */
+#define DMA1_IT_GL(n)                      ((uint32_t)0x1 << (4 * ((n) - 1)))
+#define DMA1_IT_TC(n)                      ((uint32_t)0x2 << (4 * ((n) - 1)))
+#define DMA1_IT_HT(n)                      ((uint32_t)0x4 << (4 * ((n) - 1)))
+#define DMA1_IT_TE(n)                      ((uint32_t)0x8 << (4 * ((n) - 1)))
+/**
+  * @}
+  */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+/* Function used to set the DMA configuration to the default reset state *****/
+void DMA_DeInit(DMA_Channel_TypeDef* DMAy_Channelx);
+
+/* Initialization and Configuration functions *********************************/
+void DMA_Init(DMA_Channel_TypeDef* DMAy_Channelx, DMA_InitTypeDef* DMA_InitStruct);
+void DMA_StructInit(DMA_InitTypeDef* DMA_InitStruct);
+void DMA_Cmd(DMA_Channel_TypeDef* DMAy_Channelx, FunctionalState NewState);
+
+/* Data Counter functions *****************************************************/
+void DMA_SetCurrDataCounter(DMA_Channel_TypeDef* DMAy_Channelx, uint16_t DataNumber);
+uint16_t DMA_GetCurrDataCounter(DMA_Channel_TypeDef* DMAy_Channelx);
+
+/* Interrupts and flags management functions **********************************/
+void DMA_ITConfig(DMA_Channel_TypeDef* DMAy_Channelx, uint32_t DMA_IT, FunctionalState NewState);
+ITStatus DMA_GetITStatus(uint32_t DMAy_IT);
+void DMA_ClearITPendingBit(uint32_t DMAy_IT);
+
+/* ADC1 circular stream *******************************************************/
+void DMA_ADC1StreamInit(uint16_t* pBuffer, uint16_t Count, DMA_BlockCallback HalfCallback, DMA_BlockCallback FullCallback);
+void DMA_ADC1StreamIRQHandler(void);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_STM32L1_DMA_H */
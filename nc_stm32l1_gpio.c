@@ -0,0 +1,252 @@
+/**
+ * @file    nc_stm32l1_gpio.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   GPIO Library for STM32L1xx devices
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_stm32l1_gpio.h"
+#include "nc_stm32l1_conf.h"
+#include "nc_defines.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define IS_GPIO_ALL_PERIPH(PERIPH) (((PERIPH) == GPIOA) || ((PERIPH) == GPIOB) || \
+                                    ((PERIPH) == GPIOC) || ((PERIPH) == GPIOD) || \
+                                    ((PERIPH) == GPIOE) || ((PERIPH) == GPIOH) || \
+                                    ((PERIPH) == GPIOF) || ((PERIPH) == GPIOG))
+#define IS_GPIO_PIN(PIN) ((PIN) != (uint16_t)0x00)
+#define IS_GET_GPIO_PIN(PIN) (((PIN) == GPIO_Pin_0) || ((PIN) == GPIO_Pin_1) || \
+                              ((PIN) == GPIO_Pin_2) || ((PIN) == GPIO_Pin_3) || \
+                              ((PIN) == GPIO_Pin_4) || ((PIN) == GPIO_Pin_5) || \
+                              ((PIN) == GPIO_Pin_6) || ((PIN) == GPIO_Pin_7) || \
+                              ((PIN) == GPIO_Pin_8) || ((PIN) == GPIO_Pin_9) || \
+                              ((PIN) == GPIO_Pin_10) || ((PIN) == GPIO_Pin_11) || \
+                              ((PIN) == GPIO_Pin_12) || ((PIN) == GPIO_Pin_13) || \
+                              ((PIN) == GPIO_Pin_14) || ((PIN) == GPIO_Pin_15))
+
+/* Private macro -------------------------------------------------------------*/
+/* Compile time pin map checks: a pin listed twice makes the sum differ from the OR */
+#define GPIO_PINMAP_CHECK(P) \
+  typedef char GPIO_PinMapConflict_##P[(GPIO_PINMAP(GPIO_PM_PIN, P) == GPIO_PINMAP_PINSUM(P)) ? 1 : -1]
+
+GPIO_PINMAP_CHECK(GPIO_PortA);
+GPIO_PINMAP_CHECK(GPIO_PortB);
+GPIO_PINMAP_CHECK(GPIO_PortC);
+GPIO_PINMAP_CHECK(GPIO_PortD);
+GPIO_PINMAP_CHECK(GPIO_PortE);
+GPIO_PINMAP_CHECK(GPIO_PortH);
+GPIO_PINMAP_CHECK(GPIO_PortF);
+GPIO_PINMAP_CHECK(GPIO_PortG);
+typedef char GPIO_PinMapFieldRange[(GPIO_PINMAP(GPIO_PM_BAD, 0) == 0) ? 1 : -1];
+
+/* Apply every merged constant of port P to GPIOx, skipped entirely when P has no pins */
+#define GPIO_PINMAP_APPLY(GPIOx, P)                                                        \
+  if (GPIO_PINMAP(GPIO_PM_PIN, P) != 0)                                                    \
+  {                                                                                        \
+    GPIO_PinMapPort((GPIOx),                                                               \
+                    GPIO_PINMAP(GPIO_PM_PIN, P),     GPIO_PINMAP(GPIO_PM_MASK2, P),        \
+                    GPIO_PINMAP(GPIO_PM_MODER, P),   GPIO_PINMAP(GPIO_PM_OTYPER, P),       \
+                    GPIO_PINMAP(GPIO_PM_SPEED, P),   GPIO_PINMAP(GPIO_PM_PUPD, P),         \
+                    GPIO_PINMAP(GPIO_PM_AFRLMSK, P), GPIO_PINMAP(GPIO_PM_AFRL, P),         \
+                    GPIO_PINMAP(GPIO_PM_AFRHMSK, P), GPIO_PINMAP(GPIO_PM_AFRH, P));        \
+  }
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Writes merged pin settings to one port, one store per register.
+  * @note   MODER is written last so a pin enters output/AF mode with its type,
+  *         speed, pull and alternate function already set.
+  * @param  GPIOx: where x can be (A..H) to select the GPIO peripheral.
+  * @param  Pins: one bit per configured pin.
+  * @param  Mask2: two bits per configured pin (MODER, OSPEEDR, PUPDR field mask).
+  * @param  Moder, OTyper, OSpeedr, Pupdr: merged register values.
+  * @param  AfrlMask, Afrl, AfrhMask, Afrh: merged AFR[0]/AFR[1] mask and value.
+  * @retval None
+  */
+static void GPIO_PinMapPort(GPIO_TypeDef* GPIOx, uint32_t Pins, uint32_t Mask2,
+                            uint32_t Moder, uint32_t OTyper, uint32_t OSpeedr, uint32_t Pupdr,
+                            uint32_t AfrlMask, uint32_t Afrl, uint32_t AfrhMask, uint32_t Afrh)
+{
+  if (AfrlMask != 0)
+  {
+    GPIOx->AFR[0] = (GPIOx->AFR[0] & ~AfrlMask) | Afrl;
+  }
+  if (AfrhMask != 0)
+  {
+    GPIOx->AFR[1] = (GPIOx->AFR[1] & ~AfrhMask) | Afrh;
+  }
+  GPIOx->OTYPER  = (uint16_t)((GPIOx->OTYPER & ~Pins) | OTyper);
+  GPIOx->OSPEEDR = (GPIOx->OSPEEDR & ~Mask2) | OSpeedr;
+  GPIOx->PUPDR   = (GPIOx->PUPDR & ~Mask2) | Pupdr;
+  GPIOx->MODER   = (GPIOx->MODER & ~Mask2) | Moder;
+}
+
+/**
+  * @brief  Initializes the GPIOx pins selected in GPIO_InitStruct->GPIO_Pin.
+  * @note   All selected pins share the same settings, so the per-pin fields are
+  *         merged first and each register is written once.
+  * @param  GPIOx: where x can be (A..H) to select the GPIO peripheral.
+  * @param  GPIO_InitStruct: pointer to a GPIO_InitTypeDef structure that contains
+  *         the configuration information for the specified GPIO peripheral.
+  * @retval None
+  */
+void GPIO_Init(GPIO_TypeDef* GPIOx, GPIO_InitTypeDef* GPIO_InitStruct)
+{
+  uint32_t pinpos;
+  uint32_t mask2 = 0;
+  uint32_t moder = 0, ospeedr = 0, pupdr = 0;
+
+  /* Check the parameters */
+  assert_param(IS_GPIO_ALL_PERIPH(GPIOx));
+  assert_param(IS_GPIO_PIN(GPIO_InitStruct->GPIO_Pin));
+
+  for (pinpos = 0; pinpos < 16; pinpos++)
+  {
+    if ((GPIO_InitStruct->GPIO_Pin & (1UL << pinpos)) != 0)
+    {
+      mask2   |= (uint32_t)0x03 << (pinpos * 2);
+      moder   |= (uint32_t)GPIO_InitStruct->GPIO_Mode << (pinpos * 2);
+      ospeedr |= (uint32_t)GPIO_InitStruct->GPIO_Speed << (pinpos * 2);
+      pupdr   |= (uint32_t)GPIO_InitStruct->GPIO_PuPd << (pinpos * 2);
+    }
+  }
+
+  if ((GPIO_InitStruct->GPIO_Mode == GPIO_Mode_OUT) || (GPIO_InitStruct->GPIO_Mode == GPIO_Mode_AF))
+  {
+    GPIOx->OSPEEDR = (GPIOx->OSPEEDR & ~mask2) | ospeedr;
+    GPIOx->OTYPER  = (uint16_t)((GPIOx->OTYPER & ~GPIO_InitStruct->GPIO_Pin) |
+                     ((GPIO_InitStruct->GPIO_OType == GPIO_OType_OD) ? GPIO_InitStruct->GPIO_Pin : 0));
+  }
+  GPIOx->PUPDR = (GPIOx->PUPDR & ~mask2) | pupdr;
+  GPIOx->MODER = (GPIOx->MODER & ~mask2) | moder;
+}
+
+/**
+  * @brief  Reads the specified input port pin.
+  * @param  GPIOx: where x can be (A..H) to select the GPIO peripheral.
+  * @param  GPIO_Pin: specifies the port bit to read.
+  *         This parameter can be GPIO_Pin_x where x can be (0..15).
+  * @retval The input port pin value.
+  */
+uint8_t GPIO_ReadInputDataBit(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+  /* Check the parameters */
+  assert_param(IS_GPIO_ALL_PERIPH(GPIOx));
+  assert_param(IS_GET_GPIO_PIN(GPIO_Pin));
+
+  return ((GPIOx->IDR & GPIO_Pin) != 0) ? (uint8_t)Bit_SET : (uint8_t)Bit_RESET;
+}
+
+/**
+  * @brief  Sets the selected data port bits.
+  * @param  GPIOx: where x can be (A..H) to select the GPIO peripheral.
+  * @param  GPIO_Pin: specifies the port bits to be written.
+  *         This parameter can be any combination of GPIO_Pin_x where x can be (0..15).
+  * @retval None
+  */
+void GPIO_SetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+  /* Check the parameters */
+  assert_param(IS_GPIO_ALL_PERIPH(GPIOx));
+  assert_param(IS_GPIO_PIN(GPIO_Pin));
+
+  GPIOx->BSRRL = GPIO_Pin;
+}
+
+/**
+  * @brief  Clears the selected data port bits.
+  * @param  GPIOx: where x can be (A..H) to select the GPIO peripheral.
+  * @param  GPIO_Pin: specifies the port bits to be written.
+  *         This parameter can be any combination of GPIO_Pin_x where x can be (0..15).
+  * @retval None
+  */
+void GPIO_ResetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+  /* Check the parameters */
+  assert_param(IS_GPIO_ALL_PERIPH(GPIOx));
+  assert_param(IS_GPIO_PIN(GPIO_Pin));
+
+  GPIOx->BSRRH = GPIO_Pin;
+}
+
+/**
+  * @brief  Sets and clears any combination of port bits with a single BSRR store.
+  * @note   No read-modify-write of ODR: safe against interrupts touching other pins
+  *         of the same port. Use GPIO_WRITE_MASK() where the call overhead matters.
+  * @param  GPIOx: where x can be (A..H) to select the GPIO peripheral.
+  * @param  GPIO_SetPins: port bits driven high.
+  * @param  GPIO_ResetPins: port bits driven low (ignored for bits also in GPIO_SetPins).
+  * @retval None
+  */
+void GPIO_WriteMask(GPIO_TypeDef* GPIOx, uint16_t GPIO_SetPins, uint16_t GPIO_ResetPins)
+{
+  /* Check the parameters */
+  assert_param(IS_GPIO_ALL_PERIPH(GPIOx));
+
+  GPIO_WRITE_MASK(GPIOx, GPIO_SetPins, GPIO_ResetPins);
+}
+
+/**
+  * @brief  Configures every pin of the board pin map (NC_GPIO_PIN_MAP in nc_defines.h).
+  * @note   All masks and values are compile time constants: the used port clocks are
+  *         enabled with a single RCC store and each register of a used port is
+  *         written once, unused ports generate no code.
+  * @param  None
+  * @retval None
+  */
+void GPIO_PinMapInit(void)
+{
+  RCC->AHBENR |= GPIO_PINMAP_PORTS;
+  (void)RCC->AHBENR;                  /* Dummy read: clock enable delay before first port access */
+
+  GPIO_PINMAP_APPLY(GPIOA, GPIO_PortA);
+  GPIO_PINMAP_APPLY(GPIOB, GPIO_PortB);
+  GPIO_PINMAP_APPLY(GPIOC, GPIO_PortC);
+  GPIO_PINMAP_APPLY(GPIOD, GPIO_PortD);
+  GPIO_PINMAP_APPLY(GPIOE, GPIO_PortE);
+  GPIO_PINMAP_APPLY(GPIOH, GPIO_PortH);
+#if defined (STM32L1XX_HD) || defined (STM32L1XX_XL)
+  GPIO_PINMAP_APPLY(GPIOF, GPIO_PortF);
+  GPIO_PINMAP_APPLY(GPIOG, GPIO_PortG);
+#endif
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -1,185 +1,274 @@
-/** 
- * @file		nc_stm32l1_gpio.h
- * @author  Noel Cruz   
- * @email   noel_s_cruz@yahoo.com
- * @github  https://github.com/noey2020
- * @version v1.0
- * @ide     Keil uVision
- * @license GNU GPL v3
- * @brief   GPIO Library for STM32L1xx devices
- *
-@verbatim
-----------------------------------------------------------------------
-Copyright (C) 2020, Noel Cruz
-
-Permission is hereby granted, free of charge, to any person
-obtaining a copy of this software and associated documentation
-files (the "Software"), to deal in the Software without restriction,
-including without limitation the rights to use, copy, modify, merge,
-publish, distribute, sublicense, and/or sell copies of the Software, 
-and to permit persons to whom the Software is furnished to do so, 
-subject to the following conditions:
-
-The above copyright notice and this permission notice shall be
-included in all copies or substantial portions of the Software.
-
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
-EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
-OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
-AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
-HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
-WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
-FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
-OTHER DEALINGS IN THE SOFTWARE.
-----------------------------------------------------------------------
-@endverbatim
- */
- /* Define to prevent recursive inclusion -- */
-#ifndef NC_GPIO_H
-#define NC_GPIO_H 100
-
-/* C++ detection */
-#ifdef __cplusplus
-extern "C" {
-#endif /* NC_GPIO_H */
-
-#include "stm32l1xx.h"
-
-/**
- * @brief    GPIO Library macros
- * @{
- */
-
-/**
- * @brief GPIO Pins declarations 
- * @note  For HAL drivers compatibility
- */
-  
-#ifndef GPIO_PIN_0
-#define GPIO_PIN_0		((uint16_t)0x0001)
-#define GPIO_PIN_1		((uint16_t)0x0002)
-#define GPIO_PIN_2		((uint16_t)0x0004)
-#define GPIO_PIN_3		((uint16_t)0x0008)
-#define GPIO_PIN_4		((uint16_t)0x0010)
-#define GPIO_PIN_5		((uint16_t)0x0020)
-#define GPIO_PIN_6		((uint16_t)0x0040)
-#define GPIO_PIN_7		((uint16_t)0x0080)
-#define GPIO_PIN_8		((uint16_t)0x0100)
-#define GPIO_PIN_9		((uint16_t)0x0200)
-#define GPIO_PIN_10		((uint16_t)0x0400)
-#define GPIO_PIN_11		((uint16_t)0x0800)
-#define GPIO_PIN_12		((uint16_t)0x1000)
-#define GPIO_PIN_13		((uint16_t)0x2000)
-#define GPIO_PIN_14		((uint16_t)0x4000)
-#define GPIO_PIN_15		((uint16_t)0x8000)
-#define GPIO_PIN_ALL	((uint16_t)0xFFFF)
-#endif
-
-/**
- * @brief GPIO Pins declarations 
- * @note  For Standard Peripheral Library(SPL) compatibility
- */
-
-#ifndef GPIO_Pin_0
-#define GPIO_Pin_0		((uint16_t)0x0001)
-#define GPIO_Pin_1		((uint16_t)0x0002)
-#define GPIO_Pin_2		((uint16_t)0x0004)
-#define GPIO_Pin_3		((uint16_t)0x0008)
-#define GPIO_Pin_4		((uint16_t)0x0010)
-#define GPIO_Pin_5		((uint16_t)0x0020)
-#define GPIO_Pin_6		((uint16_t)0x0040)
-#define GPIO_Pin_7		((uint16_t)0x0080)
-#define GPIO_Pin_8		((uint16_t)0x0100)
-#define GPIO_Pin_9		((uint16_t)0x0200)
-#define GPIO_Pin_10		((uint16_t)0x0400)
-#define GPIO_Pin_11		((uint16_t)0x0800)
-#define GPIO_Pin_12		((uint16_t)0x1000)
-#define GPIO_Pin_13		((uint16_t)0x2000)
-#define GPIO_Pin_14		((uint16_t)0x4000)
-#define GPIO_Pin_15		((uint16_t)0x8000)
-#define GPIO_Pin_All	((uint16_t)0xFFFF)
-#endif
-
-/**
- * @}
- */
-
-/**
- * @brief    GPIO Typedefs used for GPIO library for initialization purposes
- * @{
- */
-
-/**
- * @brief GPIO Mode enumeration
- */
-typedef enum
-{ 
-  GPIO_Mode_IN   = 0x00, /*!< GPIO Input Mode */
-  GPIO_Mode_OUT  = 0x01, /*!< GPIO Output Mode */
-  GPIO_Mode_AF   = 0x02, /*!< GPIO Alternate function Mode */
-  GPIO_Mode_AN   = 0x03  /*!< GPIO Analog Mode */
-}GPIOMode_TypeDef;
-
-/**
- * @brief GPIO Output type enumeration
- */
-typedef enum
-{ GPIO_OType_PP = 0x00,
-  GPIO_OType_OD = 0x01
-}GPIOOType_TypeDef;
-
-/**
- * @brief  GPIO Speed enumeration
- */
-typedef enum
-{ 
-  GPIO_Speed_400KHz = 0x00, /*!< Very Low Speed */
-  GPIO_Speed_2MHz   = 0x01, /*!< Low Speed */
-  GPIO_Speed_10MHz  = 0x02, /*!< Medium Speed */
-  GPIO_Speed_40MHz  = 0x03  /*!< High Speed */
-}GPIOSpeed_TypeDef;
-
-/**
- * @brief GPIO pull resistors enumeration
- */
-typedef enum
-{ GPIO_PuPd_NOPULL = 0x00,
-  GPIO_PuPd_UP     = 0x01,
-  GPIO_PuPd_DOWN   = 0x02
-}GPIOPuPd_TypeDef;
-
-typedef enum
-{ Bit_RESET = 0,
-  Bit_SET
-}BitAction;
-
-typedef struct
-{
-  uint32_t GPIO_Pin;              /*!< Specifies the GPIO pins to be configured.
-                                       This parameter can be any value of @ref GPIO_pins_define */
-
-  GPIOMode_TypeDef GPIO_Mode;     /*!< Specifies the operating mode for the selected pins.
-                                       This parameter can be a value of @ref GPIOMode_TypeDef */
-
-  GPIOSpeed_TypeDef GPIO_Speed;   /*!< Specifies the speed for the selected pins.
-                                       This parameter can be a value of @ref GPIOSpeed_TypeDef */
-
-  GPIOOType_TypeDef GPIO_OType;   /*!< Specifies the operating output type for the selected pins.
-                                       This parameter can be a value of @ref GPIOOType_TypeDef */
-
-  GPIOPuPd_TypeDef GPIO_PuPd;     /*!< Specifies the operating Pull-up/Pull down for the selected pins.
-                                       This parameter can be a value of @ref GPIOPuPd_TypeDef */
-}GPIO_InitTypeDef;
-
-/* Initialization and Configuration functions *********************************/
-void GPIO_Init(GPIO_TypeDef* GPIOx, GPIO_InitTypeDef* GPIO_InitStruct);
-uint8_t GPIO_ReadInputDataBit(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin);
-void GPIO_SetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin);
-void GPIO_ResetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin);
-
-/* C++ detection */
-#ifdef __cplusplus
-}
-#endif
-
-#endif /* NC_STM32L1_GPIO_H */
+/** 
+ * @file		nc_stm32l1_gpio.h
+ * @author  Noel Cruz   
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   GPIO Library for STM32L1xx devices
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software, 
+and to permit persons to whom the Software is furnished to do so, 
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_GPIO_H
+#define NC_GPIO_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_GPIO_H */
+
+#include "stm32l1xx.h"
+
+/**
+ * @brief    GPIO Library macros
+ * @{
+ */
+
+/**
+ * @brief GPIO Pins declarations 
+ * @note  For HAL drivers compatibility
+ */
+  
+#ifndef GPIO_PIN_0
+#define GPIO_PIN_0		((uint16_t)0x0001)
+#define GPIO_PIN_1		((uint16_t)0x0002)
+#define GPIO_PIN_2		((uint16_t)0x0004)
+#define GPIO_PIN_3		((uint16_t)0x0008)
+#define GPIO_PIN_4		((uint16_t)0x0010)
+#define GPIO_PIN_5		((uint16_t)0x0020)
+#define GPIO_PIN_6		((uint16_t)0x0040)
+#define GPIO_PIN_7		((uint16_t)0x0080)
+#define GPIO_PIN_8		((uint16_t)0x0100)
+#define GPIO_PIN_9		((uint16_t)0x0200)
+#define GPIO_PIN_10		((uint16_t)0x0400)
+#define GPIO_PIN_11		((uint16_t)0x0800)
+#define GPIO_PIN_12		((uint16_t)0x1000)
+#define GPIO_PIN_13		((uint16_t)0x2000)
+#define GPIO_PIN_14		((uint16_t)0x4000)
+#define GPIO_PIN_15		((uint16_t)0x8000)
+#define GPIO_PIN_ALL	((uint16_t)0xFFFF)
+#endif
+
+/**
+ * @brief GPIO Pins declarations 
+ * @note  For Standard Peripheral Library(SPL) compatibility
+ */
+
+#ifndef GPIO_Pin_0
+#define GPIO_Pin_0		((uint16_t)0x0001)
+#define GPIO_Pin_1		((uint16_t)0x0002)
+#define GPIO_Pin_2		((uint16_t)0x0004)
+#define GPIO_Pin_3		((uint16_t)0x0008)
+#define GPIO_Pin_4		((uint16_t)0x0010)
+#define GPIO_Pin_5		((uint16_t)0x0020)
+#define GPIO_Pin_6		((uint16_t)0x0040)
+#define GPIO_Pin_7		((uint16_t)0x0080)
+#define GPIO_Pin_8		((uint16_t)0x0100)
+#define GPIO_Pin_9		((uint16_t)0x0200)
+#define GPIO_Pin_10		((uint16_t)0x0400)
+#define GPIO_Pin_11		((uint16_t)0x0800)
+#define GPIO_Pin_12		((uint16_t)0x1000)
+#define GPIO_Pin_13		((uint16_t)0x2000)
+#define GPIO_Pin_14		((uint16_t)0x4000)
+#define GPIO_Pin_15		((uint16_t)0x8000)
+#define GPIO_Pin_All	((uint16_t)0xFFFF)
+#endif
+
+/**
+ * @brief GPIO Port indexes used by the pin map
+ * @note  Equal to the port bit position in RCC_AHBENR
+ */
+#define GPIO_PortA		((uint32_t)0)
+#define GPIO_PortB		((uint32_t)1)
+#define GPIO_PortC		((uint32_t)2)
+#define GPIO_PortD		((uint32_t)3)
+#define GPIO_PortE		((uint32_t)4)
+#define GPIO_PortH		((uint32_t)5)
+#define GPIO_PortF		((uint32_t)6)
+#define GPIO_PortG		((uint32_t)7)
+
+/**
+ * @brief GPIO Alternate function selection
+ * @note  For Standard Peripheral Library(SPL) compatibility
+ */
+#define GPIO_AF_RTC_50Hz	((uint8_t)0x00)
+#define GPIO_AF_MCO		((uint8_t)0x00)
+#define GPIO_AF_SWJ		((uint8_t)0x00)
+#define GPIO_AF_TIM2		((uint8_t)0x01)
+#define GPIO_AF_TIM3		((uint8_t)0x02)
+#define GPIO_AF_TIM4		((uint8_t)0x02)
+#define GPIO_AF_TIM5		((uint8_t)0x02)
+#define GPIO_AF_TIM9		((uint8_t)0x03)
+#define GPIO_AF_TIM10		((uint8_t)0x03)
+#define GPIO_AF_TIM11		((uint8_t)0x03)
+#define GPIO_AF_I2C1		((uint8_t)0x04)
+#define GPIO_AF_I2C2		((uint8_t)0x04)
+#define GPIO_AF_SPI1		((uint8_t)0x05)
+#define GPIO_AF_SPI2		((uint8_t)0x05)
+#define GPIO_AF_SPI3		((uint8_t)0x06)
+#define GPIO_AF_USART1		((uint8_t)0x07)
+#define GPIO_AF_USART2		((uint8_t)0x07)
+#define GPIO_AF_USART3		((uint8_t)0x07)
+#define GPIO_AF_UART4		((uint8_t)0x08)
+#define GPIO_AF_UART5		((uint8_t)0x08)
+#define GPIO_AF_USB		((uint8_t)0x0A)
+#define GPIO_AF_LCD		((uint8_t)0x0B)
+#define GPIO_AF_FSMC		((uint8_t)0x0C)
+#define GPIO_AF_SDIO		((uint8_t)0x0C)
+#define GPIO_AF_RI		((uint8_t)0x0E)
+#define GPIO_AF_EVENTOUT	((uint8_t)0x0F)
+
+/**
+ * @brief Pin map reduction macros
+ * @note  The board pin map NC_GPIO_PIN_MAP(X, P) lives in nc_defines.h and lists one
+ *        X(P, PORT, PIN, MODE, OTYPE, AF, SPEED, PULL) entry per pin. Each macro below
+ *        is passed as X and folds the entries of port P into one register mask or
+ *        value, so GPIO_PinMapInit() writes every register of a port exactly once.
+ */
+#define GPIO_PM_SEL(P, PORT, V)                                 (((PORT) == (P)) ? (uint32_t)(V) : 0UL)
+#define GPIO_PM_PIN(P, PORT, PIN, MODE, OTYPE, AF, SPEED, PULL)    | GPIO_PM_SEL(P, PORT, 1UL << (PIN))
+#define GPIO_PM_PINSUM(P, PORT, PIN, MODE, OTYPE, AF, SPEED, PULL) + GPIO_PM_SEL(P, PORT, 1UL << (PIN))
+#define GPIO_PM_MASK2(P, PORT, PIN, MODE, OTYPE, AF, SPEED, PULL)  | GPIO_PM_SEL(P, PORT, 3UL << (2 * (PIN)))
+#define GPIO_PM_MODER(P, PORT, PIN, MODE, OTYPE, AF, SPEED, PULL)  | GPIO_PM_SEL(P, PORT, (uint32_t)(MODE) << (2 * (PIN)))
+#define GPIO_PM_OTYPER(P, PORT, PIN, MODE, OTYPE, AF, SPEED, PULL) | GPIO_PM_SEL(P, PORT, (uint32_t)(OTYPE) << (PIN))
+#define GPIO_PM_SPEED(P, PORT, PIN, MODE, OTYPE, AF, SPEED, PULL)  | GPIO_PM_SEL(P, PORT, (uint32_t)(SPEED) << (2 * (PIN)))
+#define GPIO_PM_PUPD(P, PORT, PIN, MODE, OTYPE, AF, SPEED, PULL)   | GPIO_PM_SEL(P, PORT, (uint32_t)(PULL) << (2 * (PIN)))
+#define GPIO_PM_BAD(P, PORT, PIN, MODE, OTYPE, AF, SPEED, PULL)    | (((PIN) > 15) || ((AF) > 15) || ((MODE) > 3) || \
+                                                                  ((OTYPE) > 1) || ((SPEED) > 3) || ((PULL) > 2))
+#define GPIO_PM_PORTEN(P, PORT, PIN, MODE, OTYPE, AF, SPEED, PULL) | (1UL << (PORT))
+
+/* AFR[0] holds pins 0..7 and AFR[1] pins 8..15: split the 64-bit AF field in two words */
+#define GPIO_PM_AFRL_SEL(P, PORT, PIN, V)                       GPIO_PM_SEL(P, PORT, ((PIN) < 8) ? (uint32_t)(V) : 0UL)
+#define GPIO_PM_AFRH_SEL(P, PORT, PIN, V)                       GPIO_PM_SEL(P, PORT, ((PIN) >= 8) ? (uint32_t)(V) : 0UL)
+#define GPIO_PM_AFRLMSK(P, PORT, PIN, MODE, OTYPE, AF, SPEED, PULL) | GPIO_PM_AFRL_SEL(P, PORT, PIN, 0xFUL << (4 * ((PIN) & 7)))
+#define GPIO_PM_AFRHMSK(P, PORT, PIN, MODE, OTYPE, AF, SPEED, PULL) | GPIO_PM_AFRH_SEL(P, PORT, PIN, 0xFUL << (4 * ((PIN) & 7)))
+#define GPIO_PM_AFRL(P, PORT, PIN, MODE, OTYPE, AF, SPEED, PULL)    | GPIO_PM_AFRL_SEL(P, PORT, PIN, (uint32_t)(AF) << (4 * ((PIN) & 7)))
+#define GPIO_PM_AFRH(P, PORT, PIN, MODE, OTYPE, AF, SPEED, PULL)    | GPIO_PM_AFRH_SEL(P, PORT, PIN, (uint32_t)(AF) << (4 * ((PIN) & 7)))
+
+/**
+ * @brief Single store set/reset of any pin combination through BSRR
+ * @note  BSRRL/BSRRH are written as one 32-bit word, so all edges happen on the
+ *        same bus cycle. A pin present in both SET and CLR ends up set. The word
+ *        is addressed from the port base (BSRR at offset 0x18), not through the
+ *        uint16_t BSRRL member, so the store does not break strict aliasing.
+ */
+#define GPIO_BSRR_OFFSET                  0x18
+#define GPIO_WRITE_MASK(GPIOx, SET, CLR)  (*(__IO uint32_t*)((__IO uint8_t*)(GPIOx) + GPIO_BSRR_OFFSET) = \
+                                           ((uint32_t)(uint16_t)(CLR) << 16) | (uint16_t)(SET))
+
+/* Merged constants for port P of the board pin map */
+#define GPIO_PINMAP(REDUCE, P)        (0UL NC_GPIO_PIN_MAP(REDUCE, P))
+#define GPIO_PINMAP_PINSUM(P)         (0UL NC_GPIO_PIN_MAP(GPIO_PM_PINSUM, P))
+#define GPIO_PINMAP_PORTS             (0UL NC_GPIO_PIN_MAP(GPIO_PM_PORTEN, 0))
+
+/**
+ * @}
+ */
+
+/**
+ * @brief    GPIO Typedefs used for GPIO library for initialization purposes
+ * @{
+ */
+
+/**
+ * @brief GPIO Mode enumeration
+ */
+typedef enum
+{ 
+  GPIO_Mode_IN   = 0x00, /*!< GPIO Input Mode */
+  GPIO_Mode_OUT  = 0x01, /*!< GPIO Output Mode */
+  GPIO_Mode_AF   = 0x02, /*!< GPIO Alternate function Mode */
+  GPIO_Mode_AN   = 0x03  /*!< GPIO Analog Mode */
+}GPIOMode_TypeDef;
+
+/**
+ * @brief GPIO Output type enumeration
+ */
+typedef enum
+{ GPIO_OType_PP = 0x00,
+  GPIO_OType_OD = 0x01
+}GPIOOType_TypeDef;
+
+/**
+ * @brief  GPIO Speed enumeration
+ */
+typedef enum
+{ 
+  GPIO_Speed_400KHz = 0x00, /*!< Very Low Speed */
+  GPIO_Speed_2MHz   = 0x01, /*!< Low Speed */
+  GPIO_Speed_10MHz  = 0x02, /*!< Medium Speed */
+  GPIO_Speed_40MHz  = 0x03  /*!< High Speed */
+}GPIOSpeed_TypeDef;
+
+/**
+ * @brief GPIO pull resistors enumeration
+ */
+typedef enum
+{ GPIO_PuPd_NOPULL = 0x00,
+  GPIO_PuPd_UP     = 0x01,
+  GPIO_PuPd_DOWN   = 0x02
+}GPIOPuPd_TypeDef;
+
+typedef enum
+{ Bit_RESET = 0,
+  Bit_SET
+}BitAction;
+
+typedef struct
+{
+  uint32_t GPIO_Pin;              /*!< Specifies the GPIO pins to be configured.
+                                       This parameter can be any value of @ref GPIO_pins_define */
+
+  GPIOMode_TypeDef GPIO_Mode;     /*!< Specifies the operating mode for the selected pins.
+                                       This parameter can be a value of @ref GPIOMode_TypeDef */
+
+  GPIOSpeed_TypeDef GPIO_Speed;   /*!< Specifies the speed for the selected pins.
+                                       This parameter can be a value of @ref GPIOSpeed_TypeDef */
+
+  GPIOOType_TypeDef GPIO_OType;   /*!< Specifies the operating output type for the selected pins.
+                                       This parameter can be a value of @ref GPIOOType_TypeDef */
+
+  GPIOPuPd_TypeDef GPIO_PuPd;     /*!< Specifies the operating Pull-up/Pull down for the selected pins.
+                                       This parameter can be a value of @ref GPIOPuPd_TypeDef */
+}GPIO_InitTypeDef;
+
+/* Initialization and Configuration functions *********************************/
+void GPIO_Init(GPIO_TypeDef* GPIOx, GPIO_InitTypeDef* GPIO_InitStruct);
+uint8_t GPIO_ReadInputDataBit(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin);
+void GPIO_SetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin);
+void GPIO_ResetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin);
+void GPIO_WriteMask(GPIO_TypeDef* GPIOx, uint16_t GPIO_SetPins, uint16_t GPIO_ResetPins);
+void GPIO_PinMapInit(void);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_STM32L1_GPIO_H */
@@ -0,0 +1,217 @@
+/**
+ * @file    nc_stm32l1_snapshot.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Peripheral register snapshot/restore for STM32L1xx devices
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "nc_stm32l1_snapshot.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* ADC1 SMPR1..JSQR are 15 consecutive words starting at offset 0x0C */
+#define SNAP_ADC_BLOCK_SIZE       ((uint32_t)15)
+
+/* ADC CR2 bits that must not be replayed from the image */
+#define SNAP_CR2_START_MASK       (ADC_CR2_ADON | ADC_CR2_SWSTART | ADC_CR2_JSWSTART)
+
+/* Private macro -------------------------------------------------------------*/
+/* The image must mirror the register layout for the block copy to be valid */
+typedef char SNAP_AdcBlockLayoutCheck[((sizeof(uint32_t) * (SNAP_ADC_BLOCK_SIZE - 1)) ==
+  (offsetof(SNAP_TypeDef, ADC1_JSQR) - offsetof(SNAP_TypeDef, ADC1_SMPR))) ? 1 : -1];
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Copies the RCC, GPIOB, TIM3 and ADC1 configuration into RAM.
+  * @note   Call once after init_ADC(), init_TIM3() and GPIO_PinMapInit() have run,
+  *         before the first entry into Stop mode.
+  * @param  SNAP_Image: pointer to the SNAP_TypeDef that receives the image.
+  * @retval None
+  */
+void SNAP_Capture(SNAP_TypeDef* SNAP_Image)
+{
+  uint32_t i;
+  __IO uint32_t* reg;
+
+  SNAP_Image->FLASH_ACR   = FLASH->ACR;
+  SNAP_Image->RCC_CR      = RCC->CR & RCC_CR_HSION;
+  SNAP_Image->RCC_CFGR    = RCC->CFGR & RCC_CFGR_SW;
+  SNAP_Image->RCC_AHBENR  = RCC->AHBENR;
+  SNAP_Image->RCC_APB2ENR = RCC->APB2ENR;
+  SNAP_Image->RCC_APB1ENR = RCC->APB1ENR;
+
+  SNAP_Image->GPIOB_MODER   = GPIOB->MODER;
+  SNAP_Image->GPIOB_OTYPER  = GPIOB->OTYPER;
+  SNAP_Image->GPIOB_OSPEEDR = GPIOB->OSPEEDR;
+  SNAP_Image->GPIOB_PUPDR   = GPIOB->PUPDR;
+  SNAP_Image->GPIOB_ODR     = GPIOB->ODR;
+  SNAP_Image->GPIOB_AFR[0]  = GPIOB->AFR[0];
+  SNAP_Image->GPIOB_AFR[1]  = GPIOB->AFR[1];
+
+  SNAP_Image->TIM3_CR1   = TIM3->CR1;
+  SNAP_Image->TIM3_CR2   = TIM3->CR2;
+  SNAP_Image->TIM3_SMCR  = TIM3->SMCR;
+  SNAP_Image->TIM3_DIER  = TIM3->DIER;
+  SNAP_Image->TIM3_CCMR1 = TIM3->CCMR1;
+  SNAP_Image->TIM3_CCMR2 = TIM3->CCMR2;
+  SNAP_Image->TIM3_CCER  = TIM3->CCER;
+  SNAP_Image->TIM3_PSC   = TIM3->PSC;
+  SNAP_Image->TIM3_ARR   = TIM3->ARR;
+  SNAP_Image->TIM3_CCR[0] = TIM3->CCR1;
+  SNAP_Image->TIM3_CCR[1] = TIM3->CCR2;
+  SNAP_Image->TIM3_CCR[2] = TIM3->CCR3;
+  SNAP_Image->TIM3_CCR[3] = TIM3->CCR4;
+
+  SNAP_Image->ADC_CCR  = ADC->CCR;
+  SNAP_Image->ADC1_CR1 = ADC1->CR1;
+  SNAP_Image->ADC1_CR2 = ADC1->CR2;
+  reg = &ADC1->SMPR1;
+  for (i = 0; i < SNAP_ADC_BLOCK_SIZE; i++)
+  {
+    (&SNAP_Image->ADC1_SMPR[0])[i] = reg[i];
+  }
+  SNAP_Image->ADC1_SMPR0 = ADC1->SMPR0;
+
+  SNAP_Image->RestoreCycles = 0;
+}
+
+/**
+  * @brief  Writes a captured image back to the hardware after wake-up from Stop.
+  * @note   The order is fixed by the hardware:
+  *         1) FLASH wait states (ACC64 before LATENCY), then RCC: HSI (ADC
+  *            clock source) and the bus clock gates.
+  *         2) GPIOB: AF/type/speed/pull before MODER so the pins switch mode
+  *            already fully configured.
+  *         3) ADC1: configured with ADON cleared, then powered up and ADONS
+  *            awaited, so it is ready before the first trigger arrives.
+  *         4) System clock: back on HSI if it ran from HSI, Stop wakes on MSI.
+  *         5) TIM3: preloads latched with UG, counter enabled last.
+  *         The HSIRDY, ADONS and SWS waits are the only polling loops left,
+  *         the cycle count of the whole sequence is left in RestoreCycles.
+  * @param  SNAP_Image: pointer to an image filled by SNAP_Capture().
+  * @retval None
+  */
+void SNAP_Restore(SNAP_TypeDef* SNAP_Image)
+{
+  uint32_t i;
+  uint32_t start;
+  __IO uint32_t* reg;
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  start = DWT->CYCCNT;
+
+  /*---------------------------- 1) FLASH and RCC ---------------------------*/
+  FLASH->ACR = SNAP_Image->FLASH_ACR & FLASH_ACR_ACC64;
+  FLASH->ACR = SNAP_Image->FLASH_ACR;
+  RCC->CR |= SNAP_Image->RCC_CR;          /* HSI start-up overlaps with steps 2 and 3 */
+  RCC->AHBENR  = SNAP_Image->RCC_AHBENR;
+  RCC->APB2ENR = SNAP_Image->RCC_APB2ENR;
+  RCC->APB1ENR = SNAP_Image->RCC_APB1ENR;
+  (void)RCC->APB1ENR;                     /* Dummy read: clock enable delay before first peripheral access */
+
+  /*---------------------------- 2) GPIOB -----------------------------------*/
+  GPIOB->AFR[0]  = SNAP_Image->GPIOB_AFR[0];
+  GPIOB->AFR[1]  = SNAP_Image->GPIOB_AFR[1];
+  GPIOB->OTYPER  = (uint16_t)SNAP_Image->GPIOB_OTYPER;
+  GPIOB->OSPEEDR = SNAP_Image->GPIOB_OSPEEDR;
+  GPIOB->PUPDR   = SNAP_Image->GPIOB_PUPDR;
+  GPIOB->ODR     = (uint16_t)SNAP_Image->GPIOB_ODR;
+  GPIOB->MODER   = SNAP_Image->GPIOB_MODER;
+
+  /*---------------------------- 3) ADC1 ------------------------------------*/
+  ADC1->CR2 = SNAP_Image->ADC1_CR2 & ~SNAP_CR2_START_MASK;
+  ADC->CCR  = SNAP_Image->ADC_CCR;
+  ADC1->CR1 = SNAP_Image->ADC1_CR1;
+  reg = &ADC1->SMPR1;
+  for (i = 0; i < SNAP_ADC_BLOCK_SIZE; i++)
+  {
+    reg[i] = (&SNAP_Image->ADC1_SMPR[0])[i];
+  }
+  ADC1->SMPR0 = SNAP_Image->ADC1_SMPR0;
+
+  if ((SNAP_Image->ADC1_CR2 & ADC_CR2_ADON) != 0)
+  {
+    while((RCC->CR & RCC_CR_HSIRDY) == 0){  /* ADC is clocked from HSI */
+    }
+    ADC1->CR2 |= ADC_CR2_ADON;
+    while((ADC1->SR & ADC_SR_ADONS) == 0){  /* Wait until ADC is ready to convert */
+    }
+  }
+
+  /*---------------------------- 4) System clock ----------------------------*/
+  if (SNAP_Image->RCC_CFGR == RCC_CFGR_SW_HSI)
+  {
+    while((RCC->CR & RCC_CR_HSIRDY) == 0){
+    }
+    RCC->CFGR = (RCC->CFGR & ~RCC_CFGR_SW) | RCC_CFGR_SW_HSI;
+    while((RCC->CFGR & RCC_CFGR_SWS) != RCC_CFGR_SWS_HSI){
+    }
+  }
+
+  /*---------------------------- 5) TIM3 ------------------------------------*/
+  TIM3->CR1   = 0;                        /* Counter stopped while reloading */
+  TIM3->PSC   = SNAP_Image->TIM3_PSC;
+  TIM3->ARR   = SNAP_Image->TIM3_ARR;
+  TIM3->CCR1  = SNAP_Image->TIM3_CCR[0];
+  TIM3->CCR2  = SNAP_Image->TIM3_CCR[1];
+  TIM3->CCR3  = SNAP_Image->TIM3_CCR[2];
+  TIM3->CCR4  = SNAP_Image->TIM3_CCR[3];
+  TIM3->CCMR1 = SNAP_Image->TIM3_CCMR1;
+  TIM3->CCMR2 = SNAP_Image->TIM3_CCMR2;
+  TIM3->CCER  = SNAP_Image->TIM3_CCER;
+  TIM3->SMCR  = SNAP_Image->TIM3_SMCR;
+  TIM3->CR2   = SNAP_Image->TIM3_CR2;
+  TIM3->EGR   = TIM_EGR_UG;               /* Latch PSC/ARR/CCRx preload registers */
+  TIM3->SR    = 0;                        /* UG sets UIF, drop it */
+  TIM3->DIER  = SNAP_Image->TIM3_DIER;
+  TIM3->CR1   = SNAP_Image->TIM3_CR1;
+
+  /* Software triggered regular group: restart it */
+  if ((SNAP_Image->ADC1_CR2 & (ADC_CR2_ADON | ADC_CR2_EXTEN)) == ADC_CR2_ADON)
+  {
+    ADC1->CR2 |= ADC_CR2_SWSTART;
+  }
+
+  SNAP_Image->RestoreCycles = DWT->CYCCNT - start;
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,113 @@
+/**
+ * @file    nc_stm32l1_snapshot.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Peripheral register snapshot/restore for STM32L1xx devices
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_STM32L1_SNAPSHOT_H
+#define NC_STM32L1_SNAPSHOT_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_STM32L1_SNAPSHOT_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l1xx.h"
+#include "nc_stm32l1_conf.h"
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  RAM image of the acquisition peripherals (RCC, GPIOB, TIM3, ADC1).
+  * @note   Only the configuration registers are kept. Status and data registers
+  *         (SR, DR, JDRx, CNT) are rebuilt by hardware once the peripherals run.
+  */
+typedef struct
+{
+  /* FLASH and RCC: wait states, clock sources and bus clock gates */
+  uint32_t FLASH_ACR;
+  uint32_t RCC_CR;
+  uint32_t RCC_CFGR;          /*!< SW only: MSI, or HSI once init_ADC() has switched to it */
+  uint32_t RCC_AHBENR;
+  uint32_t RCC_APB2ENR;
+  uint32_t RCC_APB1ENR;
+
+  /* GPIOB: pin configuration and output latch */
+  uint32_t GPIOB_MODER;
+  uint32_t GPIOB_OTYPER;
+  uint32_t GPIOB_OSPEEDR;
+  uint32_t GPIOB_PUPDR;
+  uint32_t GPIOB_ODR;
+  uint32_t GPIOB_AFR[2];
+
+  /* TIM3: time base, compare channels and trigger output */
+  uint16_t TIM3_CR1;
+  uint16_t TIM3_CR2;
+  uint16_t TIM3_SMCR;
+  uint16_t TIM3_DIER;
+  uint16_t TIM3_CCMR1;
+  uint16_t TIM3_CCMR2;
+  uint16_t TIM3_CCER;
+  uint16_t TIM3_PSC;
+  uint32_t TIM3_ARR;
+  uint32_t TIM3_CCR[4];
+
+  /* ADC common and ADC1: SMPR1..JSQR (offsets 0x0C..0x44) are restored as one block */
+  uint32_t ADC_CCR;
+  uint32_t ADC1_CR1;
+  uint32_t ADC1_CR2;
+  uint32_t ADC1_SMPR[3];      /*!< SMPR1..SMPR3 */
+  uint32_t ADC1_JOFR[4];
+  uint32_t ADC1_HTR;
+  uint32_t ADC1_LTR;
+  uint32_t ADC1_SQR[5];       /*!< SQR1..SQR5 */
+  uint32_t ADC1_JSQR;
+  uint32_t ADC1_SMPR0;
+
+  uint32_t RestoreCycles;     /*!< Core cycles spent in the last SNAP_Restore() call */
+}SNAP_TypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void SNAP_Capture(SNAP_TypeDef* SNAP_Image);
+void SNAP_Restore(SNAP_TypeDef* SNAP_Image);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_STM32L1_SNAPSHOT_H */
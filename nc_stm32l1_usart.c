@@ -0,0 +1,371 @@
+/**
+ * @file    nc_stm32l1_usart.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   USART driver and framed USART1 DMA transmitter
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_stm32l1_usart.h"
+#include "nc_stm32l1_rcc.h"
+#include "nc_stm32l1_dma.h"
+
+/** @addtogroup STM32L1xx_StdPeriph_Driver
+  * @{
+  */
+
+/** @defgroup USART
+  * @brief USART driver modules
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] Generic set-up: enable the USART clock, fill a USART_InitTypeDef and
+         USART_Init() with the clock of the USART's APB bus (there is no
+         RCC_GetClocksFreq() here), then USART_Cmd(). The TX pin comes from the
+         board pin map in nc_defines.h (PA9 AF7 for USART1).
+    [..] Framed transmitter: USART1_TxInit() once, with DMA1_Channel4_IRQHandler
+         calling USART1_TxIRQHandler(). USART1_TxFrame() queues a frame whose
+         payload stays where it is, e.g. a just completed DMA buffer half: the
+         header and CRC are built in the queue slot and DMA1 channel 4 sends
+         header, payload and CRC back to back, one transfer each, no memcpy.
+         The payload must stay untouched until the done callback returns it.
+    [..] Backpressure: with USART_TX_QUEUE_SIZE frames in flight, new frames are
+         refused and counted as Dropped; their sequence number is still used,
+         so the receiver sees the gap, and the next frame carries
+         FRM_FLAG_OVERRUN. For the ADC1 double buffer the link must drain a
+         half within one half period, since the DMA rewrites it after that:
+         queue a half only if USART1_TxPending() is 0. The capture engine has
+         no such limit, release a capture from the done callback and the pool
+         throttles acquisition instead.
+    [..] Throughput: a byte is 10 bit times, so the link carries BaudRate / 10
+         bytes/s, 200 kB/s at 2 Mbaud (32 MHz / 16). A frame adds 20 bytes of
+         header and CRC plus up to 3 of padding: 512 samples as uint16_t reach
+         98% of the line rate, about 98 ksamples/s at 2 Mbaud, and packed
+         12-bit payloads about 130 ksamples/s.
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+
+/**
+  * @brief  One queued frame: header and CRC are sent from here, the payload
+  *         from where it lies.
+  */
+typedef struct
+{
+  FRM_HeaderTypeDef Header;
+  uint32_t Crc;
+  const uint32_t* pPayload;
+}USART_TxSlotTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define USART_TX_QUEUE_MASK       (USART_TX_QUEUE_SIZE - 1)
+#define USART_TX_CCR              (DMA_CCR1_DIR | DMA_CCR1_MINC | DMA_CCR1_TCIE | DMA_CCR1_PL_0)
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static USART_TxSlotTypeDef USART_TxQueue[USART_TX_QUEUE_SIZE];
+static volatile uint32_t USART_TxHead;          /* Written by the producer */
+static volatile uint32_t USART_TxTail;          /* Written by the DMA interrupt */
+static volatile uint32_t USART_TxPiece;         /* 0 header, 1 payload, 2 CRC; 3 idle */
+static USART_TxDoneCallback USART_TxDone;
+static USART_TxStatsTypeDef USART_TxStats;
+static uint16_t USART_TxSequence;
+static uint8_t USART_TxOverrun;
+
+/* Private function prototypes -----------------------------------------------*/
+static void USART1_TxNextPiece(void);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Initializes a USART.
+  * @note   Oversampling by 16; BRR = PeriphClock / BaudRate, rounded.
+  * @param  USARTx: USART1, USART2 or USART3.
+  * @param  USART_InitStruct: configuration.
+  * @param  PeriphClock: clock of the APB bus the USART sits on, Hz.
+  * @retval None
+  */
+void USART_Init(USART_TypeDef* USARTx, USART_InitTypeDef* USART_InitStruct, uint32_t PeriphClock)
+{
+  USARTx->CR2 = (uint16_t)((USARTx->CR2 & ~USART_CR2_STOP) | USART_InitStruct->USART_StopBits);
+  USARTx->CR1 = (uint16_t)((USARTx->CR1 & ~(USART_CR1_M | USART_CR1_PCE | USART_CR1_PS | USART_CR1_TE | USART_CR1_RE)) |
+                           USART_InitStruct->USART_WordLength | USART_InitStruct->USART_Parity | USART_InitStruct->USART_Mode);
+  USARTx->CR3 = (uint16_t)((USARTx->CR3 & ~(USART_CR3_RTSE | USART_CR3_CTSE)) | USART_InitStruct->USART_HardwareFlowControl);
+  USARTx->BRR = (uint16_t)((PeriphClock + USART_InitStruct->USART_BaudRate / 2) / USART_InitStruct->USART_BaudRate);
+}
+
+/**
+  * @brief  Fills a USART_InitTypeDef with 9600 8N1, TX and RX, no flow control.
+  * @param  USART_InitStruct: structure to fill.
+  * @retval None
+  */
+void USART_StructInit(USART_InitTypeDef* USART_InitStruct)
+{
+  USART_InitStruct->USART_BaudRate = 9600;
+  USART_InitStruct->USART_WordLength = USART_WordLength_8b;
+  USART_InitStruct->USART_StopBits = USART_StopBits_1;
+  USART_InitStruct->USART_Parity = USART_Parity_No;
+  USART_InitStruct->USART_Mode = USART_Mode_Rx | USART_Mode_Tx;
+  USART_InitStruct->USART_HardwareFlowControl = USART_HardwareFlowControl_None;
+}
+
+/**
+  * @brief  Enables or disables a USART.
+  * @param  USARTx: USART1, USART2 or USART3.
+  * @param  NewState: ENABLE or DISABLE.
+  * @retval None
+  */
+void USART_Cmd(USART_TypeDef* USARTx, FunctionalState NewState)
+{
+  if (NewState != DISABLE)
+  {
+    USARTx->CR1 |= USART_CR1_UE;
+  }
+  else
+  {
+    USARTx->CR1 &= (uint16_t)~USART_CR1_UE;
+  }
+}
+
+/**
+  * @brief  Enables or disables the USART's DMA requests.
+  * @param  USARTx: USART1, USART2 or USART3.
+  * @param  USART_DMAReq: USART_DMAReq_Tx and/or USART_DMAReq_Rx.
+  * @param  NewState: ENABLE or DISABLE.
+  * @retval None
+  */
+void USART_DMACmd(USART_TypeDef* USARTx, uint16_t USART_DMAReq, FunctionalState NewState)
+{
+  if (NewState != DISABLE)
+  {
+    USARTx->CR3 |= USART_DMAReq;
+  }
+  else
+  {
+    USARTx->CR3 &= (uint16_t)~USART_DMAReq;
+  }
+}
+
+/**
+  * @brief  USART1 8N1 transmitter fed by DMA1 channel 4.
+  * @note   The DMA1_Channel4 interrupt still has to be enabled in the NVIC.
+  * @param  BaudRate: bits per second.
+  * @param  PeriphClock: APB2 clock, Hz.
+  * @param  DoneCallback: gets each payload back once sent, may be 0.
+  * @retval None
+  */
+void USART1_TxInit(uint32_t BaudRate, uint32_t PeriphClock, USART_TxDoneCallback DoneCallback)
+{
+  USART_InitTypeDef USART_InitStructure;
+
+  USART_TxHead = 0;
+  USART_TxTail = 0;
+  USART_TxPiece = 3;
+  USART_TxDone = DoneCallback;
+  USART_TxStats.Frames = 0;
+  USART_TxStats.Bytes = 0;
+  USART_TxStats.Dropped = 0;
+  USART_TxSequence = 0;
+  USART_TxOverrun = 0;
+
+  RCC_APB2PeriphClockCmd(RCC_APB2Periph_USART1, ENABLE);
+  RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+  USART_StructInit(&USART_InitStructure);
+  USART_InitStructure.USART_BaudRate = BaudRate;
+  USART_InitStructure.USART_Mode = USART_Mode_Tx;
+  USART_Init(USART1, &USART_InitStructure, PeriphClock);
+  USART_DMACmd(USART1, USART_DMAReq_Tx, ENABLE);
+  USART_Cmd(USART1, ENABLE);
+
+  DMA_DeInit(DMA1_Channel4);
+  DMA1_Channel4->CPAR = (uint32_t)&USART1->DR;
+}
+
+/**
+  * @brief  Queues a frame around a payload that stays in place.
+  * @note   One producer: call it from a single context, typically the ADC
+  *         DMA callbacks or the main loop.
+  * @param  Type: FRM_TYPE_x.
+  * @param  Flags: FRM_FLAG_x; FRM_FLAG_OVERRUN is added after a drop.
+  * @param  Timestamp: tick count at the first sample.
+  * @param  ChannelMask: ranks present in the payload.
+  * @param  pPayload: word aligned, readable up to FRM_PADDED(Length).
+  * @param  Length: payload bytes, at most FRM_MAX_PAYLOAD.
+  * @retval 1 if queued, 0 if dropped.
+  */
+uint32_t USART1_TxFrame(uint8_t Type, uint8_t Flags, uint32_t Timestamp, uint32_t ChannelMask, const uint32_t* pPayload, uint16_t Length)
+{
+  uint32_t head = USART_TxHead;
+  USART_TxSlotTypeDef* s;
+  uint32_t primask;
+
+  if ((head - USART_TxTail) >= USART_TX_QUEUE_SIZE)
+  {
+    USART_TxStats.Dropped++;
+    USART_TxSequence++;
+    USART_TxOverrun = FRM_FLAG_OVERRUN;
+    return 0;
+  }
+  s = &USART_TxQueue[head & USART_TX_QUEUE_MASK];
+  FRM_InitHeader(&s->Header, Type, (uint8_t)(Flags | USART_TxOverrun), USART_TxSequence++, Timestamp, ChannelMask, Length);
+  s->Crc = FRM_Crc(&s->Header, pPayload);
+  s->pPayload = pPayload;
+  USART_TxOverrun = 0;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  USART_TxHead = head + 1;
+  if (USART_TxPiece == 3)
+  {
+    USART_TxPiece = 0;
+    USART1_TxNextPiece();
+  }
+  __set_PRIMASK(primask);
+  return 1;
+}
+
+/**
+  * @brief  Frames queued or being sent.
+  * @retval Count, 0 when the link is idle.
+  */
+uint32_t USART1_TxPending(void)
+{
+  return USART_TxHead - USART_TxTail;
+}
+
+/**
+  * @brief  Copies the transmitter counters.
+  * @param  pStats: receives the counters.
+  * @retval None
+  */
+void USART1_TxGetStats(USART_TxStatsTypeDef* pStats)
+{
+  *pStats = USART_TxStats;
+}
+
+/**
+  * @brief  DMA1 channel 4 transfer complete: starts the next piece or frame.
+  * @note   The producer may preempt this handler, so the empty test and the
+  *         move to idle are made with interrupts masked, as on its side:
+  *         otherwise a frame queued in between would find the link busy and
+  *         never be started.
+  * @retval None
+  */
+void USART1_TxIRQHandler(void)
+{
+  USART_TxSlotTypeDef* s;
+  uint32_t primask;
+
+  if ((DMA1->ISR & DMA1_IT_TC(4)) == 0)
+  {
+    return;
+  }
+  DMA1->IFCR = DMA1_IT_TC(4);
+  if (USART_TxPiece < 2)
+  {
+    USART_TxPiece++;
+    USART1_TxNextPiece();
+    return;
+  }
+  /* CRC handed to the USART: the frame is done */
+  s = &USART_TxQueue[USART_TxTail & USART_TX_QUEUE_MASK];
+  USART_TxStats.Frames++;
+  USART_TxStats.Bytes += FRM_FRAME_BYTES(s->Header.Length);
+  if (USART_TxDone != 0)
+  {
+    USART_TxDone(s->pPayload);
+  }
+  primask = __get_PRIMASK();
+  __disable_irq();
+  USART_TxTail++;
+  if (USART_TxTail != USART_TxHead)
+  {
+    USART_TxPiece = 0;
+    USART1_TxNextPiece();
+  }
+  else
+  {
+    USART_TxPiece = 3;
+  }
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Points DMA1 channel 4 at the current piece of the oldest frame.
+  * @retval None
+  */
+static void USART1_TxNextPiece(void)
+{
+  USART_TxSlotTypeDef* s = &USART_TxQueue[USART_TxTail & USART_TX_QUEUE_MASK];
+  uint32_t addr, count;
+
+  switch (USART_TxPiece)
+  {
+    case 0:
+      addr = (uint32_t)&s->Header;
+      count = FRM_HEADER_BYTES;
+      break;
+    case 1:
+      addr = (uint32_t)s->pPayload;
+      count = FRM_PADDED(s->Header.Length);
+      break;
+    default:
+      addr = (uint32_t)&s->Crc;
+      count = FRM_CRC_BYTES;
+      break;
+  }
+  if (count == 0)
+  {
+    /* Empty payload: straight on to the CRC */
+    USART_TxPiece = 2;
+    addr = (uint32_t)&s->Crc;
+    count = FRM_CRC_BYTES;
+  }
+  DMA1_Channel4->CCR = USART_TX_CCR;
+  DMA1_Channel4->CMAR = addr;
+  DMA1_Channel4->CNDTR = count;
+  DMA1_Channel4->CCR = USART_TX_CCR | DMA_CCR1_EN;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
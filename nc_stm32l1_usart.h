@@ -0,0 +1,164 @@
+/**
+ * @file    nc_stm32l1_usart.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   USART driver and framed USART1 DMA transmitter
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_STM32L1_USART_H
+#define NC_STM32L1_USART_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_STM32L1_USART_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l1xx.h"
+#include "nc_stm32l1_conf.h"
+#include "nc_frame.h"
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  USART Init Structure definition
+  */
+typedef struct
+{
+  uint32_t USART_BaudRate;            /*!< Bits per second, PeriphClock / 16 at most */
+  uint16_t USART_WordLength;          /*!< @ref USART_Word_Length */
+  uint16_t USART_StopBits;            /*!< @ref USART_Stop_Bits */
+  uint16_t USART_Parity;              /*!< @ref USART_Parity */
+  uint16_t USART_Mode;                /*!< @ref USART_Mode */
+  uint16_t USART_HardwareFlowControl; /*!< @ref USART_Hardware_Flow_Control */
+}USART_InitTypeDef;
+
+/**
+  * @brief  Called from the DMA interrupt once a frame's payload is sent and
+  *         its buffer may be reused.
+  */
+typedef void (*USART_TxDoneCallback)(const uint32_t* pPayload);
+
+/**
+  * @brief  Framed transmitter counters.
+  */
+typedef struct
+{
+  uint32_t Frames;            /*!< Frames fully handed to the USART */
+  uint32_t Bytes;             /*!< Bytes of those frames */
+  uint32_t Dropped;           /*!< Frames refused because the queue was full */
+}USART_TxStatsTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+#define USART_TX_QUEUE_SIZE                8       /*!< Frames in flight, power of two */
+
+/** @defgroup USART_Word_Length
+  * @{
+  */
+#define USART_WordLength_8b                ((uint16_t)0x0000)
+#define USART_WordLength_9b                USART_CR1_M
+/**
+  * @}
+  */
+
+/** @defgroup USART_Stop_Bits
+  * @{
+  */
+#define USART_StopBits_1                   ((uint16_t)0x0000)
+#define USART_StopBits_0_5                 ((uint16_t)0x1000)
+#define USART_StopBits_2                   ((uint16_t)0x2000)
+#define USART_StopBits_1_5                 ((uint16_t)0x3000)
+/**
+  * @}
+  */
+
+/** @defgroup USART_Parity
+  * @{
+  */
+#define USART_Parity_No                    ((uint16_t)0x0000)
+#define USART_Parity_Even                  USART_CR1_PCE
+#define USART_Parity_Odd                   (USART_CR1_PCE | USART_CR1_PS)
+/**
+  * @}
+  */
+
+/** @defgroup USART_Mode
+  * @{
+  */
+#define USART_Mode_Rx                      USART_CR1_RE
+#define USART_Mode_Tx                      USART_CR1_TE
+/**
+  * @}
+  */
+
+/** @defgroup USART_Hardware_Flow_Control
+  * @{
+  */
+#define USART_HardwareFlowControl_None     ((uint16_t)0x0000)
+#define USART_HardwareFlowControl_RTS      USART_CR3_RTSE
+#define USART_HardwareFlowControl_CTS      USART_CR3_CTSE
+#define USART_HardwareFlowControl_RTS_CTS  (USART_CR3_RTSE | USART_CR3_CTSE)
+/**
+  * @}
+  */
+
+/** @defgroup USART_DMA_Requests
+  * @{
+  */
+#define USART_DMAReq_Tx                    USART_CR3_DMAT
+#define USART_DMAReq_Rx                    USART_CR3_DMAR
+/**
+  * @}
+  */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+/* Initialization and Configuration functions *********************************/
+void USART_Init(USART_TypeDef* USARTx, USART_InitTypeDef* USART_InitStruct, uint32_t PeriphClock);
+void USART_StructInit(USART_InitTypeDef* USART_InitStruct);
+void USART_Cmd(USART_TypeDef* USARTx, FunctionalState NewState);
+void USART_DMACmd(USART_TypeDef* USARTx, uint16_t USART_DMAReq, FunctionalState NewState);
+
+/* USART1 framed transmitter **************************************************/
+void USART1_TxInit(uint32_t BaudRate, uint32_t PeriphClock, USART_TxDoneCallback DoneCallback);
+uint32_t USART1_TxFrame(uint8_t Type, uint8_t Flags, uint32_t Timestamp, uint32_t ChannelMask, const uint32_t* pPayload, uint16_t Length);
+uint32_t USART1_TxPending(void);
+void USART1_TxGetStats(USART_TxStatsTypeDef* pStats);
+void USART1_TxIRQHandler(void);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_STM32L1_USART_H */
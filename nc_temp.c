@@ -0,0 +1,153 @@
+/**
+ * @file    nc_temp.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Calibrated die temperature from the internal sensor
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_temp.h"
+#include "nc_stm32l1_adc.h"
+
+/** @defgroup TEMP
+  * @brief Two-point calibrated temperature, no division or floating point
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] Set the injected sequence length, then TEMP_Init() with the rank of the
+         sensor. It shares the low-rate injected group with VREFINT: both are
+         converted whenever the group is started, and TEMP_Sample() is called
+         on JEOC after VREF_Sample().
+    [..] T = 30 + 80 * (code3V - TS_CAL1) / (TS_CAL2 - TS_CAL1), where code3V is
+         the reading rescaled to the 3.0 V calibration supply through the VREF
+         factor. The per-die divisor comes from a reciprocal table built at
+         compile time, so neither TEMP_Init() nor TEMP_Convert() divides.
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define TEMP_3V_RECIP                 89457UL                 /*!< 4095 / 3000 in Q16, mV to codes at 3.0 V */
+
+/* Private macro -------------------------------------------------------------*/
+/* Recip[d - TEMP_DIFF_MIN] = 80.00 degC / d codes, Q16 */
+#define TEMP_R1(D)    ((uint32_t)((((uint32_t)TEMP_CAL2_CENTI - TEMP_CAL1_CENTI) << 16) / (D)))
+#define TEMP_R4(D)    TEMP_R1(D), TEMP_R1((D) + 1), TEMP_R1((D) + 2), TEMP_R1((D) + 3)
+#define TEMP_R16(D)   TEMP_R4(D), TEMP_R4((D) + 4), TEMP_R4((D) + 8), TEMP_R4((D) + 12)
+#define TEMP_R32(D)   TEMP_R16(D), TEMP_R16((D) + 16)
+#define TEMP_R64(D)   TEMP_R32(D), TEMP_R32((D) + 32)
+
+/* Private variables ---------------------------------------------------------*/
+static const uint32_t TEMP_Recip[TEMP_DIFF_MAX - TEMP_DIFF_MIN + 1] =
+{
+  TEMP_R64(TEMP_DIFF_MIN), TEMP_R64(TEMP_DIFF_MIN + 64), TEMP_R32(TEMP_DIFF_MIN + 128)
+};
+
+typedef char TEMP_RecipSizeCheck[(sizeof(TEMP_Recip) / sizeof(TEMP_Recip[0]) == 160) ? 1 : -1];
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Latches the calibration words and puts the sensor on an injected rank.
+  * @param  TEMPx: pointer to the temperature service.
+  * @param  Rank: injected rank 1..4, within the length already set.
+  * @retval 0 on success, -1 if the calibration words are implausible and the
+  *         typical slope is used instead.
+  */
+int32_t TEMP_Init(TEMP_TypeDef* TEMPx, uint8_t Rank)
+{
+  uint32_t cal1 = TEMP_CAL1;
+  uint32_t cal2 = TEMP_CAL2;
+  uint32_t diff = cal2 - cal1;
+  int32_t status = 0;
+
+  if ((cal2 <= cal1) || (diff < TEMP_DIFF_MIN) || (diff > TEMP_DIFF_MAX))
+  {
+    diff = TEMP_DIFF_TYP;
+    status = -1;
+  }
+  TEMPx->Cal1 = (uint16_t)cal1;
+  TEMPx->Slope = TEMP_Recip[diff - TEMP_DIFF_MIN];
+  TEMPx->Centi = 0;
+  TEMPx->Rank = Rank;
+
+  ADC_TempSensorVrefintCmd(ENABLE);
+  ADC_InjectedChannelConfig(ADC1, ADC_Channel_TempSensor, Rank, ADC_SampleTime_384Cycles);
+  return status;
+}
+
+/**
+  * @brief  Converts a sensor code to temperature.
+  * @param  TEMPx: pointer to the temperature service.
+  * @param  Raw: sensor code.
+  * @param  VREFx: supply estimate, or 0 to assume the 3.0 V calibration supply.
+  * @retval Temperature, 0.01 degC.
+  */
+int16_t TEMP_Convert(const TEMP_TypeDef* TEMPx, uint16_t Raw, const VREF_TypeDef* VREFx)
+{
+  int64_t code;                               /* Code at 3.0 V, Q16 */
+
+  if (VREFx != 0)
+  {
+    code = (int64_t)(((uint64_t)Raw * VREFx->Scale * TEMP_3V_RECIP) >> 16);
+  }
+  else
+  {
+    code = (int64_t)Raw << 16;
+  }
+  code -= (int64_t)TEMPx->Cal1 << 16;
+  return (int16_t)(TEMP_CAL1_CENTI + ((code * TEMPx->Slope) >> 32));
+}
+
+/**
+  * @brief  Reads the sensor injected data register and updates Centi.
+  * @note   Call on JEOC, after the VREF estimate has been refreshed.
+  * @param  TEMPx: pointer to the temperature service.
+  * @param  VREFx: supply estimate, or 0.
+  * @retval None
+  */
+void TEMP_Sample(TEMP_TypeDef* TEMPx, const VREF_TypeDef* VREFx)
+{
+  uint16_t raw = ADC_GetInjectedConversionValue(ADC1, (uint8_t)(ADC_InjectedChannel_1 + 4 * (TEMPx->Rank - 1)));
+
+  TEMPx->Centi = TEMP_Convert(TEMPx, raw, VREFx);
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,86 @@
+/**
+ * @file    nc_temp.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Calibrated die temperature from the internal sensor
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_TEMP_H
+#define NC_TEMP_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_TEMP_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l1xx.h"
+#include "nc_vref.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define TEMP_CAL1_ADDR                ((uint32_t)0x1FF8007A)  /*!< TS_CAL1: sensor code at 30 degC, VDDA = 3.0 V */
+#define TEMP_CAL2_ADDR                ((uint32_t)0x1FF8007E)  /*!< TS_CAL2: sensor code at 110 degC, VDDA = 3.0 V */
+#define TEMP_CAL1_CENTI               3000                    /*!< 30.00 degC */
+#define TEMP_CAL2_CENTI               11000                   /*!< 110.00 degC */
+#define TEMP_DIFF_MIN                 96                      /*!< Plausible TS_CAL2 - TS_CAL1, reciprocal table range */
+#define TEMP_DIFF_MAX                 255
+#define TEMP_DIFF_TYP                 176                     /*!< 1.61 mV/degC over 80 degC at 3.0 V, for bad calibration words */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  Per-die conversion and the last reading.
+  */
+typedef struct
+{
+  uint32_t Slope;             /*!< Centi-degC per code at 3.0 V, Q16 */
+  uint16_t Cal1;              /*!< TS_CAL1 latched by TEMP_Init() */
+  int16_t  Centi;             /*!< Last temperature, 0.01 degC */
+  uint8_t  Rank;              /*!< Injected rank 1..4 of ADC_Channel_TempSensor */
+}TEMP_TypeDef;
+
+/* Exported macro ------------------------------------------------------------*/
+#define TEMP_CAL1                     (*(const __IO uint16_t*)TEMP_CAL1_ADDR)
+#define TEMP_CAL2                     (*(const __IO uint16_t*)TEMP_CAL2_ADDR)
+
+/* Exported functions ------------------------------------------------------- */
+int32_t TEMP_Init(TEMP_TypeDef* TEMPx, uint8_t Rank);
+int16_t TEMP_Convert(const TEMP_TypeDef* TEMPx, uint16_t Raw, const VREF_TypeDef* VREFx);
+void TEMP_Sample(TEMP_TypeDef* TEMPx, const VREF_TypeDef* VREFx);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_TEMP_H */
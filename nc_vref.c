@@ -0,0 +1,151 @@
+/**
+ * @file    nc_vref.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   VREFINT supply measurement and ratiometric block conversion
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_vref.h"
+#include "nc_stm32l1_adc.h"
+
+/** @defgroup VREF
+  * @brief VDDA from VREFINT, codes to millivolts without a division per sample
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] Set the injected sequence length, then VREF_Init() with the rank VREFINT
+         should occupy. It enables TSVREFE and gives the channel the longest
+         sample time (VREFINT needs several microseconds to settle).
+    [..] Start the injected group periodically, ADC_SoftwareStartInjectedConv()
+         from SysTick for example, and call VREF_Sample() on JEOC. Each reading
+         refreshes Vdda and Scale with one division.
+    [..] VREF_ToMillivolts() converts whole blocks of regular samples with one
+         multiply and shift per sample:
+           mV = code * VDDA / 4095 = (code * Scale) >> 16
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Latches the calibration word and puts VREFINT on an injected rank.
+  * @note   Starts from VDDA = VREF_CAL_MV until the first reading arrives.
+  * @param  VREFx: pointer to the supply estimate.
+  * @param  Rank: injected rank 1..4, within the length already set.
+  * @retval None
+  */
+void VREF_Init(VREF_TypeDef* VREFx, uint8_t Rank)
+{
+  VREFx->Cal = VREF_CAL;
+  VREFx->Rank = Rank;
+  VREFx->RawAvg = 0;
+  VREF_Update(VREFx, VREFx->Cal);
+  VREFx->RawAvg = 0;                          /* The first reading seeds the average, not the placeholder */
+
+  ADC_TempSensorVrefintCmd(ENABLE);
+  ADC_InjectedChannelConfig(ADC1, ADC_Channel_Vrefint, Rank, ADC_SampleTime_384Cycles);
+}
+
+/**
+  * @brief  Folds a VREFINT conversion into the supply estimate.
+  * @param  VREFx: pointer to the supply estimate.
+  * @param  Raw: VREFINT code.
+  * @retval None
+  */
+void VREF_Update(VREF_TypeDef* VREFx, uint16_t Raw)
+{
+  uint32_t avg;
+
+  if (VREFx->RawAvg == 0)
+  {
+    avg = (uint32_t)Raw << 4;                 /* First reading seeds the average */
+  }
+  else
+  {
+    avg = (uint32_t)((int32_t)VREFx->RawAvg + ((((int32_t)Raw << 4) - (int32_t)VREFx->RawAvg) >> VREF_AVG_SHIFT));
+  }
+  if (avg == 0)
+  {
+    return;                                   /* Channel not converting, keep the last factor */
+  }
+  VREFx->RawAvg = avg;
+  /* Scale = 3000 * Cal * 2^16 / (Raw * 4095), Raw in Q4 */
+  VREFx->Scale = (uint32_t)((((uint64_t)VREF_CAL_MV * VREFx->Cal) << (VREF_SCALE_SHIFT + 4)) / ((uint64_t)avg * VREF_FULL_SCALE));
+  VREFx->Vdda = (uint16_t)((VREFx->Scale * VREF_FULL_SCALE + (1UL << (VREF_SCALE_SHIFT - 1))) >> VREF_SCALE_SHIFT);
+}
+
+/**
+  * @brief  Reads the VREFINT injected data register and updates the estimate.
+  * @note   Call on JEOC.
+  * @param  VREFx: pointer to the supply estimate.
+  * @retval None
+  */
+void VREF_Sample(VREF_TypeDef* VREFx)
+{
+  VREF_Update(VREFx, ADC_GetInjectedConversionValue(ADC1, (uint8_t)(ADC_InjectedChannel_1 + 4 * (VREFx->Rank - 1))));
+}
+
+/**
+  * @brief  Converts one channel of a block of regular samples to millivolts.
+  * @param  VREFx: pointer to the supply estimate.
+  * @param  pSrc: first sample of this channel.
+  * @param  pDst: output, same layout as pSrc; may equal pSrc.
+  * @param  Stride: distance between consecutive samples (1, or the scan length).
+  * @param  Count: number of samples of this channel.
+  * @retval None
+  */
+void VREF_ToMillivolts(const VREF_TypeDef* VREFx, const uint16_t* pSrc, uint16_t* pDst, uint32_t Stride, uint32_t Count)
+{
+  uint32_t scale = VREFx->Scale;              /* Latched once, the estimate may move under the block */
+
+  while (Count-- != 0)
+  {
+    *pDst = (uint16_t)((*pSrc * scale + (1UL << (VREF_SCALE_SHIFT - 1))) >> VREF_SCALE_SHIFT);
+    pSrc += Stride;
+    pDst += Stride;
+  }
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,84 @@
+/**
+ * @file    nc_vref.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   VREFINT supply measurement and ratiometric block conversion
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_VREF_H
+#define NC_VREF_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_VREF_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l1xx.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define VREF_CAL_ADDR                 ((uint32_t)0x1FF80078)  /*!< VREFINT_CAL: VREFINT code at VDDA = 3.0 V, 30 degC */
+#define VREF_CAL_MV                   3000                    /*!< VDDA during calibration, mV */
+#define VREF_FULL_SCALE               4095                    /*!< 12-bit right aligned */
+#define VREF_SCALE_SHIFT              16                      /*!< Scale is mV per code in Q16 */
+#define VREF_AVG_SHIFT                2                       /*!< VREFINT reading averaged with weight 1/4 */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  Supply estimate and the per-block conversion factor.
+  */
+typedef struct
+{
+  uint32_t Scale;             /*!< mV per code, Q16: VREF_CAL_MV * Cal / (Raw * 4095) */
+  uint32_t RawAvg;            /*!< Averaged VREFINT code, Q4 */
+  uint16_t Vdda;              /*!< Supply, mV */
+  uint16_t Cal;               /*!< Calibration word latched by VREF_Init() */
+  uint8_t  Rank;              /*!< Injected rank 1..4 of ADC_Channel_Vrefint */
+}VREF_TypeDef;
+
+/* Exported macro ------------------------------------------------------------*/
+#define VREF_CAL                      (*(const __IO uint16_t*)VREF_CAL_ADDR)
+
+/* Exported functions ------------------------------------------------------- */
+void VREF_Init(VREF_TypeDef* VREFx, uint8_t Rank);
+void VREF_Update(VREF_TypeDef* VREFx, uint16_t Raw);
+void VREF_Sample(VREF_TypeDef* VREFx);
+void VREF_ToMillivolts(const VREF_TypeDef* VREFx, const uint16_t* pSrc, uint16_t* pDst, uint32_t Stride, uint32_t Count);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_VREF_H */
@@ -0,0 +1,240 @@
+/**
+ * @file    nc_zc.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Zero-crossing frequency and phase meter
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nc_zc.h"
+#include "stm32l1xx.h"
+
+/** @defgroup ZC
+  * @brief Frequency, period jitter and phase from interpolated zero crossings
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] ZC_Init() with the scan length, the per-channel sample rate and the
+         re-arm hysteresis. When TIM3 triggers the scans, ZC_TIM3SampleRate()
+         derives the rate from its PSC and ARR so the two cannot disagree.
+    [..] Call ZC_ProcessBlock() on each DMA block. Every rising crossing of the
+         first ZC_MAX_CHANNELS ranks closes a cycle and queues a record with
+         frequency, period, jitter against the previous period and phase after
+         the reference rank. The main loop drains them with ZC_GetRecord().
+    [..] Each input follows its own DC level with a 2^ZC_DC_SHIFT sample EMA, so
+         AC inputs riding on a bias need no offset setting. A crossing is the
+         sample pair straddling that level, placed by linear interpolation to
+         1/65536 of a sample; the detector then waits for the signal to fall
+         Hyst below the level before it accepts the next one.
+    [..] Accuracy: a crossing lands within about q / slope samples, q being the
+         code noise and slope = 2 * pi * A * f / fs codes per sample, so the
+         per-cycle period error is near q / (2 * pi * A) of the period whatever
+         the scan rate. An 800-code 50 Hz input reads within a few mHz per cycle
+         from 1 kHz scans upward, and averaging N cycles divides that by N. The
+         rate only has to stay well above 2 f: the 1 Hz TIM3 setting in main.c
+         meters nothing above 0.5 Hz. Allow 2^ZC_DC_SHIFT scans for the DC
+         tracker to settle.
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define ZC_QUEUE_MASK             (ZC_QUEUE_SIZE - 1)
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void ZC_Close(ZC_BankTypeDef* ZCx, uint8_t Channel, uint64_t Cross);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Scan rate set by the TIM3 trigger.
+  * @param  TimClock: TIM3 counter input clock, Hz (before PSC).
+  * @retval TimClock / ((PSC + 1) * (ARR + 1)), mHz.
+  */
+uint32_t ZC_TIM3SampleRate(uint32_t TimClock)
+{
+  uint64_t div = (uint64_t)(TIM3->PSC + 1) * (TIM3->ARR + 1);
+
+  return (uint32_t)(((uint64_t)TimClock * 1000 + div / 2) / div);
+}
+
+/**
+  * @brief  Resets every tracker and empties the record queue.
+  * @param  ZCx: pointer to the bank.
+  * @param  NumRegular: ranks in one regular scan.
+  * @param  SampleRate: scans per second, mHz.
+  * @param  Hyst: codes below the DC level that re-arm a detector.
+  * @retval None
+  */
+void ZC_Init(ZC_BankTypeDef* ZCx, uint8_t NumRegular, uint32_t SampleRate, uint16_t Hyst)
+{
+  uint32_t ch;
+  ZC_ChannelTypeDef* c;
+
+  for (ch = 0; ch < ZC_MAX_CHANNELS; ch++)
+  {
+    c = &ZCx->Channel[ch];
+    c->LastCross = 0;
+    c->Period = 0;
+    c->Cycle = 0;
+    c->Dc = 2048L << 16;                          /* Mid-scale until the tracker settles */
+    c->Prev = 0;
+    c->Hyst = (uint16_t)(Hyst << 4);
+    c->Armed = 0;
+    c->Crossed = 0;
+  }
+  ZCx->Head = 0;
+  ZCx->Tail = 0;
+  ZCx->Dropped = 0;
+  ZCx->Frame = 0;
+  ZCx->SampleRate = SampleRate;
+  ZCx->NumRegular = NumRegular;
+}
+
+/**
+  * @brief  Tracks crossings over an interleaved block of regular scans.
+  * @param  ZCx: pointer to the bank.
+  * @param  pSrc: Frames * NumRegular ADC codes, scan order.
+  * @param  Frames: number of complete scans in the block.
+  * @retval None
+  */
+void ZC_ProcessBlock(ZC_BankTypeDef* ZCx, const uint16_t* pSrc, uint32_t Frames)
+{
+  uint32_t nreg = ZCx->NumRegular;
+  uint32_t nzc = (nreg < ZC_MAX_CHANNELS) ? nreg : ZC_MAX_CHANNELS;
+  uint32_t ch;
+  int32_t x, v;
+  uint32_t frac;
+  ZC_ChannelTypeDef* c;
+
+  while (Frames-- != 0)
+  {
+    c = ZCx->Channel;
+    for (ch = 0; ch < nzc; ch++, c++)
+    {
+      x = pSrc[ch];
+      c->Dc += ((x << 16) - c->Dc) >> ZC_DC_SHIFT;
+      v = (x << 4) - (c->Dc >> 12);
+      if (v < -(int32_t)c->Hyst)
+      {
+        c->Armed = 1;
+      }
+      else if (c->Armed && (c->Prev < 0) && (v >= 0))
+      {
+        /* Crossing between the previous frame and this one, at -Prev / (v - Prev) */
+        frac = (uint32_t)(((uint32_t)(-c->Prev) << 16) / (uint32_t)(v - c->Prev));
+        c->Armed = 0;
+        ZC_Close(ZCx, (uint8_t)ch, ((uint64_t)(ZCx->Frame - 1) << 16) + frac);
+      }
+      c->Prev = v;
+    }
+    pSrc += nreg;
+    ZCx->Frame++;
+  }
+}
+
+/**
+  * @brief  Takes the oldest cycle record out of the queue.
+  * @param  ZCx: pointer to the bank.
+  * @param  pRecord: receives the record.
+  * @retval 1 if a record was returned, 0 if the queue is empty.
+  */
+uint32_t ZC_GetRecord(ZC_BankTypeDef* ZCx, ZC_RecordTypeDef* pRecord)
+{
+  uint32_t tail = ZCx->Tail;
+
+  if (tail == ZCx->Head)
+  {
+    return 0;
+  }
+  *pRecord = ZCx->Queue[tail & ZC_QUEUE_MASK];
+  ZCx->Tail = tail + 1;
+  return 1;
+}
+
+/**
+  * @brief  Ends a cycle at a rising crossing and queues its record.
+  * @note   The divisions here run once per cycle, not per sample.
+  * @param  ZCx: pointer to the bank.
+  * @param  Channel: rank.
+  * @param  Cross: crossing time, samples Q16.
+  * @retval None
+  */
+static void ZC_Close(ZC_BankTypeDef* ZCx, uint8_t Channel, uint64_t Cross)
+{
+  ZC_ChannelTypeDef* c = &ZCx->Channel[Channel];
+  ZC_ChannelTypeDef* ref = &ZCx->Channel[ZC_REFERENCE];
+  ZC_RecordTypeDef* r;
+  uint32_t head = ZCx->Head;
+  uint32_t period;
+
+  if (!c->Crossed)
+  {
+    c->Crossed = 1;                               /* First crossing only opens the first cycle */
+    c->LastCross = Cross;
+    return;
+  }
+  period = (uint32_t)(Cross - c->LastCross);
+  c->LastCross = Cross;
+  c->Cycle++;
+  if ((head - ZCx->Tail) >= ZC_QUEUE_SIZE)
+  {
+    ZCx->Dropped++;
+  }
+  else
+  {
+    r = &ZCx->Queue[head & ZC_QUEUE_MASK];
+    r->Cycle = c->Cycle;
+    r->Period = period;
+    r->FreqMilliHz = (uint32_t)(((uint64_t)ZCx->SampleRate << 16) / period);
+    r->Jitter = (c->Period != 0) ? (int32_t)(period - c->Period) : 0;
+    r->Phase = 0;
+    if ((Channel != ZC_REFERENCE) && (ref->Period != 0))
+    {
+      r->Phase = (uint16_t)((((Cross - ref->LastCross) % ref->Period) * 36000) / ref->Period);
+    }
+    r->Channel = Channel;
+    ZCx->Head = head + 1;
+  }
+  c->Period = period;
+}
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,112 @@
+/**
+ * @file    nc_zc.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Zero-crossing frequency and phase meter
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_ZC_H
+#define NC_ZC_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_ZC_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define ZC_MAX_CHANNELS               8
+#define ZC_QUEUE_SIZE                 16      /*!< Cycle records, power of two */
+#define ZC_DC_SHIFT                   10      /*!< DC tracker time constant, 2^10 samples */
+#define ZC_REFERENCE                  0       /*!< Rank the phases are measured against */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  One completed cycle of one channel.
+  */
+typedef struct
+{
+  uint32_t Cycle;             /*!< Cycle number of this channel */
+  uint32_t FreqMilliHz;       /*!< fs / period */
+  uint32_t Period;            /*!< Samples, Q16 */
+  int32_t  Jitter;            /*!< Period minus the previous period, samples Q16 */
+  uint16_t Phase;             /*!< Rising crossing after the reference one, 0.01 degree; 0 on the reference */
+  uint8_t  Channel;           /*!< Rank */
+}ZC_RecordTypeDef;
+
+/**
+  * @brief  Crossing tracker of one channel.
+  */
+typedef struct
+{
+  uint64_t LastCross;         /*!< Time of the last rising crossing, samples Q16 */
+  uint32_t Period;            /*!< Last period, samples Q16, 0 until two crossings */
+  uint32_t Cycle;
+  int32_t  Dc;                /*!< Tracked offset, codes Q16 */
+  int32_t  Prev;              /*!< Previous sample minus offset, codes Q4 */
+  uint16_t Hyst;              /*!< Codes Q4 below the offset that re-arm the detector */
+  uint8_t  Armed;
+  uint8_t  Crossed;           /*!< LastCross is valid */
+}ZC_ChannelTypeDef;
+
+/**
+  * @brief  Meter bank plus the queue of cycle records.
+  */
+typedef struct
+{
+  ZC_ChannelTypeDef Channel[ZC_MAX_CHANNELS];
+  ZC_RecordTypeDef Queue[ZC_QUEUE_SIZE];
+  volatile uint32_t Head;     /*!< Written by the producer (ADC/DMA interrupt) */
+  volatile uint32_t Tail;     /*!< Written by the consumer */
+  uint32_t Dropped;           /*!< Records lost because the queue was full */
+  uint32_t Frame;             /*!< Scans processed so far */
+  uint32_t SampleRate;        /*!< Per channel, mHz */
+  uint8_t  NumRegular;        /*!< Ranks in the regular scan, the first ZC_MAX_CHANNELS are metered */
+}ZC_BankTypeDef;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+uint32_t ZC_TIM3SampleRate(uint32_t TimClock);
+void ZC_Init(ZC_BankTypeDef* ZCx, uint8_t NumRegular, uint32_t SampleRate, uint16_t Hyst);
+void ZC_ProcessBlock(ZC_BankTypeDef* ZCx, const uint16_t* pSrc, uint32_t Frames);
+uint32_t ZC_GetRecord(ZC_BankTypeDef* ZCx, ZC_RecordTypeDef* pRecord);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_ZC_H */
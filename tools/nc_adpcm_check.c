@@ -0,0 +1,210 @@
+/**
+ * @file    tools/nc_adpcm_check.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Host check of nc_adpcm: SNR of the 50 Hz and 1 kHz tones at 8 kHz
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/*
+ * Linux host program, not part of the firmware. From this directory:
+ *
+ *   cc -O2 -I.. -o nc_adpcm_check nc_adpcm_check.c ../nc_adpcm.c \
+ *      ../nc_fixmath.c -lm
+ *   ./nc_adpcm_check
+ *
+ * A two-rank scan at 8 kHz, one second long: a 50 Hz tone on rank 0 and a
+ * 1 kHz tone on rank 1, each at full scale (2000 codes) and at -20 dB. Each
+ * rank is encoded from the interleaved DMA blocks of 20 ms with its own
+ * state, decoded, and ADP_Snr() reported next to a double-precision SNR of
+ * the same samples. They must agree within ADP_CHECK_TOLERANCE dB and
+ * reach the floor of each case. The decoder must also rebuild any block
+ * from the encoder state sent ahead of it, as a receiver joining
+ * mid-stream does. The exit status is 1 on any failure.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "nc_adpcm.h"
+
+/* Private define ------------------------------------------------------------*/
+#define ADP_CHECK_FS              8000
+#define ADP_CHECK_RANKS           2
+#define ADP_CHECK_SAMPLES         ADP_CHECK_FS        /* Per rank: one second */
+#define ADP_CHECK_BLOCK           160                 /* Scans per DMA block, 20 ms */
+#define ADP_CHECK_BLOCKS          (ADP_CHECK_SAMPLES / ADP_CHECK_BLOCK)
+#define ADP_CHECK_TOLERANCE       0.05                /* dB, ADP_Snr() against double */
+
+/* Private typedef -----------------------------------------------------------*/
+
+/**
+  * @brief  One tone per rank, with the SNR it must reach.
+  */
+typedef struct
+{
+  double Frequency[ADP_CHECK_RANKS];
+  double Amplitude;           /*!< Codes around mid-scale */
+  double Floor[ADP_CHECK_RANKS];  /*!< dB */
+}ADP_CheckTypeDef;
+
+/* Private variables ---------------------------------------------------------*/
+static const ADP_CheckTypeDef Case[] =
+{
+  {{50.0, 1000.0}, 2000.0, {40.0, 18.0}},
+  {{50.0, 1000.0},  200.0, {40.0, 18.0}}
+};
+static uint16_t Scan[ADP_CHECK_SAMPLES * ADP_CHECK_RANKS];
+static uint8_t Coded[ADP_CHECK_RANKS][ADP_BYTES(ADP_CHECK_SAMPLES)];
+static ADP_StateTypeDef Sent[ADP_CHECK_RANKS][ADP_CHECK_BLOCKS];
+static int16_t Decoded[ADP_CHECK_SAMPLES];
+static int16_t Joined[ADP_CHECK_BLOCK];
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t Check(const ADP_CheckTypeDef* pCase);
+static double Reference(const uint16_t* pSrc, uint32_t Stride, const int16_t* pDecoded, uint32_t Count);
+
+/* Private functions ---------------------------------------------------------*/
+
+int main(void)
+{
+  uint32_t i, errors = 0;
+
+  printf("tone      amplitude  ADP_Snr     double\n");
+  for (i = 0; i < sizeof(Case) / sizeof(Case[0]); i++)
+  {
+    errors += Check(&Case[i]);
+  }
+  printf("%s\n", (errors == 0) ? "as expected" : "MISMATCH");
+  return (errors == 0) ? 0 : 1;
+}
+
+/**
+  * @brief  Encodes, decodes and measures one pair of tones.
+  * @param  pCase: tones and floors.
+  * @retval Number of failed checks.
+  */
+static uint32_t Check(const ADP_CheckTypeDef* pCase)
+{
+  ADP_StateTypeDef enc[ADP_CHECK_RANKS], dec;
+  uint32_t r, n, b, errors = 0;
+  double snr, ref;
+
+  for (n = 0; n < ADP_CHECK_SAMPLES; n++)
+  {
+    for (r = 0; r < ADP_CHECK_RANKS; r++)
+    {
+      Scan[n * ADP_CHECK_RANKS + r] = (uint16_t)lround(2048.0 + pCase->Amplitude *
+                                      sin(2.0 * M_PI * pCase->Frequency[r] * n / ADP_CHECK_FS));
+    }
+  }
+
+  /* Device side: one DMA block at a time, every rank with its own state */
+  for (r = 0; r < ADP_CHECK_RANKS; r++)
+  {
+    ADP_Init(&enc[r]);
+  }
+  for (b = 0; b < ADP_CHECK_BLOCKS; b++)
+  {
+    for (r = 0; r < ADP_CHECK_RANKS; r++)
+    {
+      Sent[r][b] = enc[r];
+      ADP_Encode(&enc[r], &Scan[b * ADP_CHECK_BLOCK * ADP_CHECK_RANKS + r], ADP_CHECK_RANKS,
+                 ADP_CHECK_BLOCK, &Coded[r][ADP_BYTES(b * ADP_CHECK_BLOCK)]);
+    }
+  }
+
+  /* Host side */
+  for (r = 0; r < ADP_CHECK_RANKS; r++)
+  {
+    ADP_Init(&dec);
+    ADP_Decode(&dec, Coded[r], ADP_CHECK_SAMPLES, Decoded);
+    if ((dec.Predictor != enc[r].Predictor) || (dec.Index != enc[r].Index))
+    {
+      printf("rank %u: decoder state differs from the encoder's\n", r);
+      errors++;
+    }
+    for (b = 0; b < ADP_CHECK_BLOCKS; b++)
+    {
+      dec = Sent[r][b];
+      ADP_Decode(&dec, &Coded[r][ADP_BYTES(b * ADP_CHECK_BLOCK)], ADP_CHECK_BLOCK, Joined);
+      if (memcmp(Joined, &Decoded[b * ADP_CHECK_BLOCK], sizeof(Joined)) != 0)
+      {
+        printf("rank %u: block %u decoded from its sent state differs\n", r, b);
+        errors++;
+        break;
+      }
+    }
+
+    snr = ADP_Snr(&Scan[r], ADP_CHECK_RANKS, Decoded, ADP_CHECK_SAMPLES) / 100.0;
+    ref = Reference(&Scan[r], ADP_CHECK_RANKS, Decoded, ADP_CHECK_SAMPLES);
+    if ((fabs(snr - ref) > ADP_CHECK_TOLERANCE) || (snr < pCase->Floor[r]))
+    {
+      errors++;
+    }
+    printf("%4.0f Hz  %9.0f  %7.2f dB  %7.2f dB%s\n", pCase->Frequency[r], pCase->Amplitude, snr, ref,
+           (fabs(snr - ref) > ADP_CHECK_TOLERANCE) ? "  ADP_Snr off" :
+           (snr < pCase->Floor[r]) ? "  below floor" : "");
+  }
+  return errors;
+}
+
+/**
+  * @brief  SNR in double precision: AC power of the source against the
+  *         error energy, as ADP_Snr() defines it.
+  * @param  pSrc: original channel, 12-bit codes.
+  * @param  Stride: distance between consecutive source samples.
+  * @param  pDecoded: decoded 16-bit PCM.
+  * @param  Count: samples.
+  * @retval dB.
+  */
+static double Reference(const uint16_t* pSrc, uint32_t Stride, const int16_t* pDecoded, uint32_t Count)
+{
+  double mean = 0.0, signal = 0.0, noise = 0.0, x;
+  uint32_t n;
+
+  for (n = 0; n < Count; n++)
+  {
+    mean += ADP_ADC12_TO_PCM(pSrc[n * Stride]);
+  }
+  mean /= Count;
+  for (n = 0; n < Count; n++)
+  {
+    x = ADP_ADC12_TO_PCM(pSrc[n * Stride]);
+    signal += (x - mean) * (x - mean);
+    noise += (x - pDecoded[n]) * (x - pDecoded[n]);
+  }
+  return 10.0 * log10(signal / ((noise > 0.0) ? noise : 1.0));
+}
+
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,205 @@
+/**
+ * @file    tools/nc_fir_check.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Host check of nc_fir against a direct-form reference
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/*
+ * Linux host program, not part of the firmware. From this directory:
+ *
+ *   cc -O2 -I.. -o nc_fir_check nc_fir_check.c ../nc_fir.c
+ *   ./nc_fir_check
+ *
+ * Runs FIR_Decimate() on random filters and signals: 1 to 64 taps, M = 1 to 8,
+ * scan strides 1 to 4, and the input cut into random DMA blocks of 0 to 40
+ * samples. Every output must equal, bit for bit, the direct form
+ * y = sat16(floor((sum h[k] x[n - k] + 2^14) / 2^15)) at n = M - 1, 2M - 1,
+ * ..., with x[n] = 0 before the first sample. Coefficients and codes include
+ * the extremes, and a last case drives the output into both saturation
+ * limits. The exit status is 1 on any difference.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "nc_fir.h"
+
+/* Private define ------------------------------------------------------------*/
+#define FIR_CHECK_RUNS            2000
+#define FIR_CHECK_MAX_TAPS        64
+#define FIR_CHECK_MAX_RATE        8
+#define FIR_CHECK_MAX_STRIDE      4
+#define FIR_CHECK_SAMPLES         600
+
+/* Private variables ---------------------------------------------------------*/
+static int16_t Coeffs[FIR_CHECK_MAX_TAPS];
+static int16_t State[2 * (FIR_CHECK_MAX_TAPS + FIR_CHECK_MAX_RATE - 1)];
+static uint16_t Codes[FIR_CHECK_SAMPLES * FIR_CHECK_MAX_STRIDE];
+static int16_t Expect[FIR_CHECK_SAMPLES];
+static int16_t Output[FIR_CHECK_SAMPLES + 1];
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t Reference(uint32_t Taps, uint32_t Rate, uint32_t Stride, uint32_t Count);
+static uint32_t Check(uint32_t Taps, uint32_t Rate, uint32_t Stride, uint32_t Count);
+static int16_t RandomCoeff(void);
+
+/* Private functions ---------------------------------------------------------*/
+
+int main(void)
+{
+  uint32_t run, i, taps, rate, stride, errors = 0;
+
+  srand(1);
+  for (run = 0; run < FIR_CHECK_RUNS; run++)
+  {
+    taps = 1 + (uint32_t)rand() % FIR_CHECK_MAX_TAPS;
+    rate = 1 + (uint32_t)rand() % FIR_CHECK_MAX_RATE;
+    stride = 1 + (uint32_t)rand() % FIR_CHECK_MAX_STRIDE;
+    for (i = 0; i < taps; i++)
+    {
+      Coeffs[i] = RandomCoeff();
+    }
+    for (i = 0; i < FIR_CHECK_SAMPLES * stride; i++)
+    {
+      Codes[i] = ((rand() & 7) == 0) ? (uint16_t)((rand() & 1) * 4095) : (uint16_t)(rand() & 0xFFF);
+    }
+    errors += Check(taps, rate, stride, FIR_CHECK_SAMPLES);
+  }
+
+  /* Saturation: all taps at the extremes, input at both rails */
+  for (i = 0; i < FIR_CHECK_MAX_TAPS; i++)
+  {
+    Coeffs[i] = (i & 1) ? -32768 : 32767;
+    Codes[2 * i] = 4095;
+    Codes[2 * i + 1] = 0;
+  }
+  for (i = 2 * FIR_CHECK_MAX_TAPS; i < FIR_CHECK_SAMPLES; i++)
+  {
+    Codes[i] = (uint16_t)(((i / 16) & 1) * 4095);
+  }
+  errors += Check(FIR_CHECK_MAX_TAPS, 1, 1, FIR_CHECK_SAMPLES);
+  errors += Check(FIR_CHECK_MAX_TAPS, 3, 1, FIR_CHECK_SAMPLES);
+
+  printf("%u filters, %s\n", FIR_CHECK_RUNS + 2, (errors == 0) ? "bit exact" : "MISMATCH");
+  return (errors == 0) ? 0 : 1;
+}
+
+/**
+  * @brief  Runs FIR_Decimate() over Codes in random blocks and compares.
+  * @param  Taps: filter length.
+  * @param  Rate: decimation factor.
+  * @param  Stride: distance between samples in Codes.
+  * @param  Count: input samples.
+  * @retval 1 on a difference, 0 otherwise.
+  */
+static uint32_t Check(uint32_t Taps, uint32_t Rate, uint32_t Stride, uint32_t Count)
+{
+  FIR_DecimTypeDef fir;
+  uint32_t expected, produced = 0, done = 0, block, i;
+
+  expected = Reference(Taps, Rate, Stride, Count);
+  FIR_DecimInit(&fir, Coeffs, State, (uint16_t)Taps, (uint16_t)Rate);
+  while (done < Count)
+  {
+    block = (uint32_t)rand() % 41;
+    block = (block > Count - done) ? (Count - done) : block;
+    produced += FIR_Decimate(&fir, &Codes[done * Stride], Stride, block, &Output[produced]);
+    done += block;
+  }
+  if (produced != expected)
+  {
+    printf("taps %u, M %u: %u outputs, expected %u\n", Taps, Rate, produced, expected);
+    return 1;
+  }
+  for (i = 0; i < produced; i++)
+  {
+    if (Output[i] != Expect[i])
+    {
+      printf("taps %u, M %u, stride %u: y[%u] = %d, expected %d\n", Taps, Rate, Stride, i, Output[i], Expect[i]);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+  * @brief  Direct form, every output computed from the definition, then kept
+  *         or dropped.
+  * @param  Taps: filter length.
+  * @param  Rate: decimation factor.
+  * @param  Stride: distance between samples in Codes.
+  * @param  Count: input samples.
+  * @retval Outputs written to Expect.
+  */
+static uint32_t Reference(uint32_t Taps, uint32_t Rate, uint32_t Stride, uint32_t Count)
+{
+  uint32_t n, k, count = 0;
+  int64_t acc, q;
+
+  for (n = 0; n < Count; n++)
+  {
+    if ((n + 1) % Rate != 0)
+    {
+      continue;
+    }
+    acc = 0;
+    for (k = 0; (k < Taps) && (k <= n); k++)
+    {
+      acc += (int64_t)Coeffs[k] * (((int32_t)Codes[(n - k) * Stride] - 2048) * 8);
+    }
+    q = acc + 16384;
+    q = (q >= 0) ? (q / 32768) : -((-q + 32767) / 32768);
+    Expect[count++] = (int16_t)((q > 32767) ? 32767 : ((q < -32768) ? -32768 : q));
+  }
+  return count;
+}
+
+/**
+  * @brief  Random Q15 coefficient, the extremes more often than chance.
+  * @retval Coefficient.
+  */
+static int16_t RandomCoeff(void)
+{
+  switch (rand() & 15)
+  {
+    case 0:
+      return 32767;
+    case 1:
+      return -32768;
+    default:
+      return (int16_t)((rand() & 0xFFFF) - 32768);
+  }
+}
+
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
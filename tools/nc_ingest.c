@@ -0,0 +1,534 @@
+/**
+ * @file    nc_ingest.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Host ingest tool for the framed device stream
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/*
+ * Linux host program, not part of the firmware. From this directory:
+ *
+ *   cc -O2 -DNC_HOST -I.. -o nc_ingest nc_ingest.c ../nc_frame.c \
+ *      ../nc_stm32l1_crc.c ../nc_pack12.c -lpthread
+ *
+ *   nc_ingest [-o DIR] [-i SECONDS] SOURCE...
+ *
+ * Each SOURCE is one device: a file, a FIFO, or a serial port or pty (put in
+ * raw mode), up to ING_MAX_DEVICES of them. All sources are read by one thread through poll() and parsed
+ * with nc_frame, whose parser keeps no per-frame allocation. Good frames are
+ * copied into a fixed ring and a writer thread splits FRM_TYPE_SAMPLES and
+ * FRM_TYPE_PACKED12 payloads into DIR/devN_chR.u16 (little-endian uint16_t
+ * per rank), and appends every other type as header + payload records to
+ * DIR/devN_records.bin. Sample frames must carry the exact length of their
+ * N samples, 2N or P12_BYTES(N) bytes; others are dropped and counted, as
+ * are the samples of a trailing partial scan. Every -i seconds (default 1)
+ * and at the end, each device's frames/s, MB/s, CRC errors, lost frames and
+ * skipped bytes go to stderr, along with the time the reader spent waiting
+ * on the writer.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "nc_frame.h"
+#include "nc_pack12.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/**
+  * @brief  One input stream and its parser.
+  */
+typedef struct
+{
+  FRM_ParserTypeDef Parser;
+  const char* pName;
+  int Fd;
+  uint64_t Bytes;             /*!< Read so far */
+  uint64_t LastBytes;         /*!< At the previous report */
+  uint32_t LastFrames;        /*!< At the previous report */
+}ING_DeviceTypeDef;
+
+/**
+  * @brief  One good frame on its way to the writer.
+  */
+typedef struct
+{
+  uint32_t Device;
+  FRM_HeaderTypeDef Header;
+  uint32_t Payload[FRM_MAX_PAYLOAD / 4];
+}ING_SlotTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define ING_MAX_DEVICES           16
+#define ING_MAX_CHANNELS          32      /*!< Bits of ChannelMask */
+#define ING_RING_SLOTS            1024    /*!< Frames between reader and writer, power of two */
+#define ING_READ_BYTES            65536
+#define ING_FILE_BUFFER           (1 << 20)
+
+/* Private macro -------------------------------------------------------------*/
+#define ING_RING_MASK             (ING_RING_SLOTS - 1)
+
+/* Private variables ---------------------------------------------------------*/
+static ING_DeviceTypeDef ING_Device[ING_MAX_DEVICES];
+static ING_SlotTypeDef ING_Ring[ING_RING_SLOTS];
+static uint32_t ING_Head;                       /* Written by the reader */
+static uint32_t ING_Tail;                       /* Written by the writer */
+static int ING_Done;
+static pthread_mutex_t ING_Lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t ING_NotEmpty = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t ING_NotFull = PTHREAD_COND_INITIALIZER;
+static double ING_StallSeconds;                 /* Reader time blocked on a full ring */
+
+static FILE* ING_Channel[ING_MAX_DEVICES][ING_MAX_CHANNELS];
+static FILE* ING_Records[ING_MAX_DEVICES];
+static const char* ING_OutDir = ".";
+static uint64_t ING_Samples;
+static uint64_t ING_Leftover;                   /* Samples of partial scans, not written */
+static uint32_t ING_BadLength;                  /* Sample frames whose Length is no whole sample count */
+
+/* Private function prototypes -----------------------------------------------*/
+static double ING_Now(void);
+static int ING_Open(ING_DeviceTypeDef* d, const char* pName);
+static void ING_Feed(uint32_t Device, const uint8_t* pData, uint32_t Size);
+static void ING_Push(uint32_t Device, const FRM_HeaderTypeDef* pHeader, const uint8_t* pPayload);
+static void* ING_Writer(void* pArg);
+static void ING_WriteFrame(const ING_SlotTypeDef* s);
+static FILE* ING_File(FILE** ppFile, const char* pFormat, uint32_t Device, uint32_t Channel);
+static void ING_Report(uint32_t NumDevices, double Seconds, int Final);
+
+/* Private functions ---------------------------------------------------------*/
+
+int main(int argc, char** argv)
+{
+  static uint8_t buf[ING_READ_BYTES];
+  struct pollfd fds[ING_MAX_DEVICES];
+  pthread_t writer;
+  double interval = 1.0;
+  double start, last, now;
+  uint32_t numDevices = 0;
+  uint32_t open, i;
+  ssize_t n;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "o:i:")) != -1)
+  {
+    if (opt == 'o')
+    {
+      ING_OutDir = optarg;
+    }
+    else if (opt == 'i')
+    {
+      interval = atof(optarg);
+    }
+    else
+    {
+      fprintf(stderr, "usage: %s [-o DIR] [-i SECONDS] SOURCE...\n", argv[0]);
+      return 2;
+    }
+  }
+  if (argc - optind > ING_MAX_DEVICES)
+  {
+    fprintf(stderr, "%s: %d sources, at most %u\n", argv[0], argc - optind, ING_MAX_DEVICES);
+    return 2;
+  }
+  for (; optind < argc; optind++)
+  {
+    if (ING_Open(&ING_Device[numDevices], argv[optind]) != 0)
+    {
+      return 1;
+    }
+    numDevices++;
+  }
+  if (numDevices == 0)
+  {
+    fprintf(stderr, "%s: no source\n", argv[0]);
+    return 2;
+  }
+  pthread_create(&writer, 0, ING_Writer, 0);
+
+  start = ING_Now();
+  last = start;
+  open = numDevices;
+  while (open != 0)
+  {
+    for (i = 0; i < numDevices; i++)
+    {
+      fds[i].fd = ING_Device[i].Fd;
+      fds[i].events = POLLIN;
+      fds[i].revents = 0;
+    }
+    if ((poll(fds, numDevices, 200) < 0) && (errno != EINTR))
+    {
+      perror("poll");
+      break;
+    }
+    for (i = 0; i < numDevices; i++)
+    {
+      if ((fds[i].fd < 0) || ((fds[i].revents & (POLLIN | POLLHUP | POLLERR)) == 0))
+      {
+        continue;
+      }
+      n = read(fds[i].fd, buf, sizeof(buf));
+      if ((n < 0) && ((errno == EAGAIN) || (errno == EINTR)))
+      {
+        continue;
+      }
+      if (n <= 0)
+      {
+        /* Nothing more will come: take what the parser still holds */
+        ING_Feed(i, buf, 0);
+        close(ING_Device[i].Fd);
+        ING_Device[i].Fd = -1;
+        open--;
+        continue;
+      }
+      ING_Device[i].Bytes += (uint64_t)n;
+      ING_Feed(i, buf, (uint32_t)n);
+    }
+    now = ING_Now();
+    if ((interval > 0) && (now - last >= interval))
+    {
+      ING_Report(numDevices, now - last, 0);
+      last = now;
+    }
+  }
+
+  pthread_mutex_lock(&ING_Lock);
+  ING_Done = 1;
+  pthread_cond_signal(&ING_NotEmpty);
+  pthread_mutex_unlock(&ING_Lock);
+  pthread_join(writer, 0);
+  ING_Report(numDevices, ING_Now() - start, 1);
+  return 0;
+}
+
+/**
+  * @brief  Monotonic time.
+  * @retval Seconds.
+  */
+static double ING_Now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+  * @brief  Opens a source non-blocking, raw mode for terminals.
+  * @param  d: device to set up.
+  * @param  pName: path.
+  * @retval 0 on success, -1 otherwise.
+  */
+static int ING_Open(ING_DeviceTypeDef* d, const char* pName)
+{
+  struct termios tio;
+
+  d->pName = pName;
+  d->Fd = open(pName, O_RDONLY | O_NOCTTY | O_NONBLOCK);
+  if (d->Fd < 0)
+  {
+    perror(pName);
+    return -1;
+  }
+  if (isatty(d->Fd) && (tcgetattr(d->Fd, &tio) == 0))
+  {
+    cfmakeraw(&tio);
+    tcsetattr(d->Fd, TCSANOW, &tio);
+  }
+  FRM_ParserInit(&d->Parser);
+  return 0;
+}
+
+/**
+  * @brief  Parses a read and queues its frames.
+  * @note   FRM_Parse() returns one frame per call, and a resync can leave
+  *         whole frames buffered after the input is used up; calls with
+  *         Size 0 return those until it gives 0.
+  * @param  Device: index into ING_Device.
+  * @param  pData: bytes read, may be 0 bytes at end of stream.
+  * @param  Size: bytes at pData.
+  * @retval None
+  */
+static void ING_Feed(uint32_t Device, const uint8_t* pData, uint32_t Size)
+{
+  const FRM_HeaderTypeDef* h;
+  uint32_t used;
+
+  do
+  {
+    h = FRM_Parse(&ING_Device[Device].Parser, pData, Size, &used);
+    if (h != 0)
+    {
+      ING_Push(Device, h, FRM_PAYLOAD(&ING_Device[Device].Parser));
+    }
+    pData += used;
+    Size -= used;
+  } while ((Size != 0) || (h != 0));
+}
+
+/**
+  * @brief  Hands a good frame to the writer, waiting while the ring is full.
+  * @param  Device: source index.
+  * @param  pHeader: parsed header.
+  * @param  pPayload: parsed payload.
+  * @retval None
+  */
+static void ING_Push(uint32_t Device, const FRM_HeaderTypeDef* pHeader, const uint8_t* pPayload)
+{
+  ING_SlotTypeDef* s;
+  double t;
+
+  pthread_mutex_lock(&ING_Lock);
+  if (ING_Head - ING_Tail == ING_RING_SLOTS)
+  {
+    t = ING_Now();
+    while (ING_Head - ING_Tail == ING_RING_SLOTS)
+    {
+      pthread_cond_wait(&ING_NotFull, &ING_Lock);
+    }
+    ING_StallSeconds += ING_Now() - t;
+  }
+  pthread_mutex_unlock(&ING_Lock);
+
+  /* The slot is the reader's until Head moves past it */
+  s = &ING_Ring[ING_Head & ING_RING_MASK];
+  s->Device = Device;
+  s->Header = *pHeader;
+  memcpy(s->Payload, pPayload, pHeader->Length);
+
+  pthread_mutex_lock(&ING_Lock);
+  ING_Head++;
+  pthread_cond_signal(&ING_NotEmpty);
+  pthread_mutex_unlock(&ING_Lock);
+}
+
+/**
+  * @brief  Writer thread: drains the ring into the output files.
+  * @param  pArg: unused.
+  * @retval 0
+  */
+static void* ING_Writer(void* pArg)
+{
+  uint32_t head, tail;
+  uint32_t d, ch;
+
+  (void)pArg;
+  for (;;)
+  {
+    pthread_mutex_lock(&ING_Lock);
+    while ((ING_Head == ING_Tail) && !ING_Done)
+    {
+      pthread_cond_wait(&ING_NotEmpty, &ING_Lock);
+    }
+    head = ING_Head;
+    tail = ING_Tail;
+    pthread_mutex_unlock(&ING_Lock);
+    if (head == tail)
+    {
+      break;
+    }
+    /* Whole batch outside the lock, then free it at once */
+    for (; tail != head; tail++)
+    {
+      ING_WriteFrame(&ING_Ring[tail & ING_RING_MASK]);
+    }
+    pthread_mutex_lock(&ING_Lock);
+    ING_Tail = tail;
+    pthread_cond_signal(&ING_NotFull);
+    pthread_mutex_unlock(&ING_Lock);
+  }
+  for (d = 0; d < ING_MAX_DEVICES; d++)
+  {
+    for (ch = 0; ch < ING_MAX_CHANNELS; ch++)
+    {
+      if (ING_Channel[d][ch] != 0)
+      {
+        fclose(ING_Channel[d][ch]);
+      }
+    }
+    if (ING_Records[d] != 0)
+    {
+      fclose(ING_Records[d]);
+    }
+  }
+  return 0;
+}
+
+/**
+  * @brief  Splits a sample frame per rank, or appends any other frame as a record.
+  * @param  s: frame.
+  * @retval None
+  */
+static void ING_WriteFrame(const ING_SlotTypeDef* s)
+{
+  static uint16_t samples[FRM_MAX_PAYLOAD];
+  static uint16_t column[FRM_MAX_PAYLOAD];
+  uint32_t rank[ING_MAX_CHANNELS];
+  uint32_t numRanks = 0;
+  uint32_t count, frames, r, f;
+  FILE* fp;
+
+  for (r = 0; r < ING_MAX_CHANNELS; r++)
+  {
+    if (s->Header.ChannelMask & (1UL << r))
+    {
+      rank[numRanks++] = r;
+    }
+  }
+  if (s->Header.Type == FRM_TYPE_SAMPLES)
+  {
+    count = s->Header.Length / 2;
+    if (count * 2 != s->Header.Length)
+    {
+      ING_BadLength++;
+      return;
+    }
+    memcpy(samples, s->Payload, count * 2);
+  }
+  else if (s->Header.Type == FRM_TYPE_PACKED12)
+  {
+    /* Length is exactly P12_BYTES(count); a word-padded one has no count */
+    count = (s->Header.Length * 2) / 3;
+    if (P12_BYTES(count) != s->Header.Length)
+    {
+      ING_BadLength++;
+      return;
+    }
+    P12_Unpack(s->Payload, samples, count);
+  }
+  else
+  {
+    fp = ING_File(&ING_Records[s->Device], "%s/dev%u_records.bin", s->Device, 0);
+    if (fp != 0)
+    {
+      fwrite(&s->Header, sizeof(s->Header), 1, fp);
+      fwrite(s->Payload, 1, FRM_PADDED(s->Header.Length), fp);
+    }
+    return;
+  }
+  if (numRanks == 0)
+  {
+    return;
+  }
+  /* Interleaved scans: rank rank[r] of frame f is samples[f * numRanks + r] */
+  frames = count / numRanks;
+  for (r = 0; r < numRanks; r++)
+  {
+    fp = ING_File(&ING_Channel[s->Device][rank[r]], "%s/dev%u_ch%u.u16", s->Device, rank[r]);
+    if (fp == 0)
+    {
+      continue;
+    }
+    for (f = 0; f < frames; f++)
+    {
+      column[f] = samples[f * numRanks + r];
+    }
+    fwrite(column, 2, frames, fp);
+  }
+  ING_Samples += (uint64_t)frames * numRanks;
+  ING_Leftover += count - frames * numRanks;
+}
+
+/**
+  * @brief  Output file, opened with a large buffer on first use.
+  * @param  ppFile: cached handle.
+  * @param  pFormat: path format taking the directory, device and channel.
+  * @param  Device: source index.
+  * @param  Channel: rank, ignored by record files.
+  * @retval Stream, or 0 if it cannot be opened.
+  */
+static FILE* ING_File(FILE** ppFile, const char* pFormat, uint32_t Device, uint32_t Channel)
+{
+  char path[4096];
+
+  if (*ppFile == 0)
+  {
+    snprintf(path, sizeof(path), pFormat, ING_OutDir, Device, Channel);
+    *ppFile = fopen(path, "wb");
+    if (*ppFile == 0)
+    {
+      perror(path);
+      return 0;
+    }
+    setvbuf(*ppFile, 0, _IOFBF, ING_FILE_BUFFER);
+  }
+  return *ppFile;
+}
+
+/**
+  * @brief  Per-device rates and error counters on stderr.
+  * @param  NumDevices: sources.
+  * @param  Seconds: time covered by the rates.
+  * @param  Final: 1 for totals since start.
+  * @retval None
+  */
+static void ING_Report(uint32_t NumDevices, double Seconds, int Final)
+{
+  ING_DeviceTypeDef* d;
+  uint32_t i, frames;
+  uint64_t bytes;
+
+  if (Seconds <= 0)
+  {
+    Seconds = 1e-9;
+  }
+  for (i = 0; i < NumDevices; i++)
+  {
+    d = &ING_Device[i];
+    frames = Final ? d->Parser.Frames : d->Parser.Frames - d->LastFrames;
+    bytes = Final ? d->Bytes : d->Bytes - d->LastBytes;
+    fprintf(stderr, "%sdev%u %s: %.0f frames/s %.2f MB/s, crc %u lost %u skipped %u\n",
+            Final ? "total " : "", i, d->pName, frames / Seconds, bytes / Seconds / 1e6,
+            d->Parser.CrcErrors, d->Parser.Lost, d->Parser.Skipped);
+    d->LastFrames = d->Parser.Frames;
+    d->LastBytes = d->Bytes;
+  }
+  if (Final)
+  {
+    fprintf(stderr, "total %.3f s, %llu samples written, %llu left over in partial scans, "
+            "%u sample frames with a bad length, reader waited %.3f s on the writer\n",
+            Seconds, (unsigned long long)ING_Samples, (unsigned long long)ING_Leftover,
+            ING_BadLength, ING_StallSeconds);
+  }
+}
+
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,151 @@
+/**
+ * @file    tools/nc_lin_check.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Host report of the nc_lin table errors
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/*
+ * Linux host program, not part of the firmware. From this directory:
+ *
+ *   cc -O2 -I.. -o nc_lin_check nc_lin_check.c ../nc_lin.c -lm
+ *   ./nc_lin_check
+ *
+ * Builds every table of LIN_CHECK_TABLES with the same LIN_TABLE_DEFINE()
+ * and LIN_TABLE_CHECK() as the firmware, then looks up all 4096 codes with
+ * LIN_LOOKUP() and compares each with the curve in double precision. It
+ * prints the maximum deviation per table and where it occurs, and checks
+ * that LIN_ConvertBlock() returns the same values as LIN_LOOKUP(). The exit
+ * status is 1 if a table exceeds its bound or the two lookups differ.
+ *
+ * Keep LIN_CHECK_TABLES in step with the tables of the firmware: one line
+ * per table, with its curve, segment bits, flash budget in bytes and the
+ * largest deviation allowed, in output units.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdio.h>
+#include "nc_lin.h"
+
+/* Private define ------------------------------------------------------------*/
+/* Pressure bridge, Pa */
+#define PRESS_CURVE(X)            (-1250.0 + 30.5 * (X) + 0.0011 * (X) * (X))
+#define PRESS_BITS                6
+/* NTC divider, 0.01 degC */
+#define NTC_CURVE(X)              (-4000.0 + 4.1 * (X) - 0.00175 * (X) * (X) + 3.3e-7 * (X) * (X) * (X))
+#define NTC_BITS                  5
+
+/* X(NAME, CURVE, BITS, BYTES, TOL) per table */
+#define LIN_CHECK_TABLES(X)                                \
+  X(PressTable, PRESS_CURVE, PRESS_BITS, 300, 2.0)         \
+  X(NtcTable,   NTC_CURVE,   NTC_BITS,   140, 10.0)
+
+/* Private variables ---------------------------------------------------------*/
+#define LIN_CHECK_DEFINE(NAME, CURVE, BITS, BYTES, TOL) \
+  LIN_TABLE_DEFINE(NAME, CURVE, BITS);                  \
+  LIN_TABLE_CHECK(NAME, BITS, BYTES);
+LIN_CHECK_TABLES(LIN_CHECK_DEFINE)
+
+static uint16_t Codes[1 << LIN_CODE_BITS];
+static int32_t Units[1 << LIN_CODE_BITS];
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t Report(const char* pName, const int32_t* pTable, uint32_t Bits, uint32_t Bytes,
+                       double Tol, const double* pCurve);
+
+/* Private functions ---------------------------------------------------------*/
+
+int main(void)
+{
+  static double curve[1 << LIN_CODE_BITS];
+  uint32_t code, errors = 0;
+
+  for (code = 0; code < (1 << LIN_CODE_BITS); code++)
+  {
+    Codes[code] = (uint16_t)code;
+  }
+  printf("table        bits  bytes  max error  at code  bound\n");
+#define LIN_CHECK_RUN(NAME, CURVE, BITS, BYTES, TOL)                   \
+  for (code = 0; code < (1 << LIN_CODE_BITS); code++)                  \
+  {                                                                    \
+    curve[code] = CURVE((double)code);                                 \
+  }                                                                    \
+  errors += Report(#NAME, NAME, BITS, BYTES, TOL, curve);
+  LIN_CHECK_TABLES(LIN_CHECK_RUN)
+#undef LIN_CHECK_RUN
+
+  printf("%s\n", (errors == 0) ? "all tables within bounds" : "FAILED");
+  return (errors == 0) ? 0 : 1;
+}
+
+/**
+  * @brief  Looks up every code of one table and prints its worst deviation.
+  * @param  pName: table name.
+  * @param  pTable: break points.
+  * @param  Bits: segment bits of the table.
+  * @param  Bytes: flash budget.
+  * @param  Tol: largest deviation allowed.
+  * @param  pCurve: the curve at every code.
+  * @retval 1 if the table exceeds Tol or the block conversion differs, else 0.
+  */
+static uint32_t Report(const char* pName, const int32_t* pTable, uint32_t Bits, uint32_t Bytes,
+                       double Tol, const double* pCurve)
+{
+  uint32_t code, worst = 0, differ = 0;
+  double err, max = 0.0;
+
+  LIN_ConvertBlock(pTable, Bits, Codes, Units, 1, 1 << LIN_CODE_BITS);
+  for (code = 0; code < (1 << LIN_CODE_BITS); code++)
+  {
+    err = fabs(pCurve[code] - (double)LIN_LOOKUP(pTable, Bits, code));
+    if (err > max)
+    {
+      max = err;
+      worst = code;
+    }
+    if (Units[code] != LIN_LOOKUP(pTable, Bits, code))
+    {
+      differ++;
+    }
+  }
+  printf("%-11s  %4u  %5u  %9.4f  %7u  %5.1f%s\n", pName, Bits, Bytes, max, worst, Tol,
+         (max > Tol) ? "  EXCEEDED" : "");
+  if (differ != 0)
+  {
+    printf("%-11s  LIN_ConvertBlock() differs from LIN_LOOKUP() at %u codes\n", pName, differ);
+  }
+  return ((max > Tol) || (differ != 0)) ? 1 : 0;
+}
+
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,209 @@
+/**
+ * @file    tools/nc_pack12_check.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Host check of nc_pack12: pack, unpack and single samples against the bit layout
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/*
+ * Linux host program, not part of the firmware. From this directory:
+ *
+ *   cc -O2 -I.. -o nc_pack12_check nc_pack12_check.c ../nc_pack12.c
+ *   ./nc_pack12_check
+ *
+ * Packs random blocks of 0 to P12_CHECK_MAX samples, every length mod 8 and
+ * both ends of the range included, and checks the packed words against the
+ * layout, sample i in bits 12i .. 12i+11 of a little-endian bit stream.
+ * Inputs carry stray bits above bit 11 now and then, which must not reach
+ * the neighbours. Then P12_Unpack() must give the masked samples back,
+ * P12_Get() each of them, and P12_Set() at random indices must change that
+ * sample only. Neither kernel may write past P12_WORDS(N) words or N
+ * samples. The exit status is 1 on any difference.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "nc_pack12.h"
+
+/* Private define ------------------------------------------------------------*/
+#define P12_CHECK_RUNS            3000
+#define P12_CHECK_MAX             4098        /* Two past a 4096-sample buffer: tails of 1 and 2 */
+#define P12_CHECK_GUARD           4           /* Words or samples after the end that must stay */
+#define P12_CHECK_FILL            0xA5
+
+/* Private variables ---------------------------------------------------------*/
+static uint16_t Samples[P12_CHECK_MAX];
+static uint32_t Packed[P12_WORDS(P12_CHECK_MAX) + P12_CHECK_GUARD];
+static uint16_t Unpacked[P12_CHECK_MAX + P12_CHECK_GUARD];
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t Check(uint32_t Count);
+static uint16_t Layout(uint32_t Index);
+static uint32_t Intact(const void* pBuffer, uint32_t From, uint32_t To);
+
+/* Private functions ---------------------------------------------------------*/
+
+int main(void)
+{
+  uint32_t run, count, errors = 0;
+
+  srand(1);
+  for (count = 0; count <= 17; count++)
+  {
+    errors += Check(count);
+  }
+  errors += Check(P12_CHECK_MAX - 1);
+  errors += Check(P12_CHECK_MAX);
+  for (run = 0; run < P12_CHECK_RUNS; run++)
+  {
+    errors += Check((uint32_t)rand() % (P12_CHECK_MAX + 1));
+  }
+
+  printf("%u blocks of 0 to %u samples, %s\n", P12_CHECK_RUNS + 20, P12_CHECK_MAX,
+         (errors == 0) ? "round trip exact" : "MISMATCH");
+  return (errors == 0) ? 0 : 1;
+}
+
+/**
+  * @brief  One block of random samples through every function.
+  * @param  Count: samples.
+  * @retval 1 on a difference, 0 otherwise.
+  */
+static uint32_t Check(uint32_t Count)
+{
+  uint32_t words = P12_WORDS(Count);
+  uint32_t i, n, k;
+  uint16_t v;
+
+  for (i = 0; i < Count; i++)
+  {
+    Samples[i] = (uint16_t)(rand() & 0xFFF);
+    if ((rand() & 7) == 0)
+    {
+      Samples[i] |= (uint16_t)(rand() << 12);   /* Left aligned or oversampled data */
+    }
+  }
+  memset(Packed, P12_CHECK_FILL, sizeof(Packed));
+  memset(Unpacked, P12_CHECK_FILL, sizeof(Unpacked));
+
+  P12_Pack(Samples, Packed, Count);
+  for (i = 0; i < Count; i++)
+  {
+    if ((Layout(i) != (Samples[i] & 0xFFF)) || (P12_Get(Packed, i) != (Samples[i] & 0xFFF)))
+    {
+      printf("%u samples: sample %u packed as 0x%03x, expected 0x%03x\n", Count, i, Layout(i), Samples[i] & 0xFFF);
+      return 1;
+    }
+  }
+  if (!Intact(Packed, words * 4, sizeof(Packed)))
+  {
+    printf("%u samples: P12_Pack() wrote past %u words\n", Count, words);
+    return 1;
+  }
+
+  P12_Unpack(Packed, Unpacked, Count);
+  for (i = 0; i < Count; i++)
+  {
+    if (Unpacked[i] != (Samples[i] & 0xFFF))
+    {
+      printf("%u samples: sample %u unpacked as 0x%03x, expected 0x%03x\n", Count, i, Unpacked[i], Samples[i] & 0xFFF);
+      return 1;
+    }
+  }
+  if (!Intact(Unpacked, Count * 2, sizeof(Unpacked)))
+  {
+    printf("%u samples: P12_Unpack() wrote past sample %u\n", Count, Count);
+    return 1;
+  }
+
+  for (k = 0; (Count != 0) && (k < 8); k++)
+  {
+    n = (uint32_t)rand() % Count;
+    v = (uint16_t)(rand() & 0xFFF);
+    P12_Set(Packed, n, v);
+    Samples[n] = v;
+    for (i = (n > 2) ? n - 2 : 0; (i < n + 3) && (i < Count); i++)
+    {
+      if (P12_Get(Packed, i) != (Samples[i] & 0xFFF))
+      {
+        printf("%u samples: P12_Set(%u) left sample %u as 0x%03x\n", Count, n, i, P12_Get(Packed, i));
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+/**
+  * @brief  Sample of Packed read bit by bit from the documented layout.
+  * @param  Index: sample index.
+  * @retval 12-bit sample.
+  */
+static uint16_t Layout(uint32_t Index)
+{
+  const uint8_t* b = (const uint8_t*)Packed;
+  uint32_t bit, pos;
+  uint16_t v = 0;
+
+  for (bit = 0; bit < 12; bit++)
+  {
+    pos = 12 * Index + bit;
+    v |= (uint16_t)(((b[pos >> 3] >> (pos & 7)) & 1) << bit);
+  }
+  return v;
+}
+
+/**
+  * @brief  Whether the bytes From .. To - 1 of a buffer still hold the fill.
+  * @param  pBuffer: buffer.
+  * @param  From: first byte.
+  * @param  To: end, exclusive.
+  * @retval 1 if untouched.
+  */
+static uint32_t Intact(const void* pBuffer, uint32_t From, uint32_t To)
+{
+  const uint8_t* b = (const uint8_t*)pBuffer;
+
+  for (; From < To; From++)
+  {
+    if (b[From] != P12_CHECK_FILL)
+    {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,203 @@
+/**
+ * @file    core_cm3.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Host stand-in for the CMSIS Cortex-M3 core header
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_SIM_CORE_CM3_H
+#define NC_SIM_CORE_CM3_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_SIM_CORE_CM3_H */
+
+/*
+ * Picked up instead of the CMSIS core_cm3.h when the drivers are built for the
+ * host simulator (-I tools/sim). The core peripherals keep their Cortex-M3
+ * addresses and layouts so nc_sim traps their accesses like any other
+ * register; PRIMASK and WFI go to the simulator.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+#define __I                           volatile const
+#define __O                           volatile
+#define __IO                          volatile
+#define __ASM                         __asm
+#define __INLINE                      inline
+#define __STATIC_INLINE               static inline
+
+typedef struct
+{
+  __IO uint32_t ISER[8];
+       uint32_t RESERVED0[24];
+  __IO uint32_t ICER[8];
+       uint32_t RESERVED1[24];
+  __IO uint32_t ISPR[8];
+       uint32_t RESERVED2[24];
+  __IO uint32_t ICPR[8];
+       uint32_t RESERVED3[24];
+  __IO uint32_t IABR[8];
+       uint32_t RESERVED4[56];
+  __IO uint8_t  IP[240];
+       uint32_t RESERVED5[644];
+  __O  uint32_t STIR;
+}NVIC_Type;
+
+typedef struct
+{
+  __I  uint32_t CPUID;
+  __IO uint32_t ICSR;
+  __IO uint32_t VTOR;
+  __IO uint32_t AIRCR;
+  __IO uint32_t SCR;
+  __IO uint32_t CCR;
+  __IO uint8_t  SHP[12];
+  __IO uint32_t SHCSR;
+}SCB_Type;
+
+typedef struct
+{
+  __IO uint32_t CTRL;
+  __IO uint32_t LOAD;
+  __IO uint32_t VAL;
+  __I  uint32_t CALIB;
+}SysTick_Type;
+
+typedef struct
+{
+  __IO uint32_t DHCSR;
+  __O  uint32_t DCRSR;
+  __IO uint32_t DCRDR;
+  __IO uint32_t DEMCR;
+}CoreDebug_Type;
+
+typedef struct
+{
+  __IO uint32_t CTRL;
+  __IO uint32_t CYCCNT;
+}DWT_Type;
+
+/* Exported constants --------------------------------------------------------*/
+#define SCS_BASE                      (0xE000E000UL)
+#define SysTick_BASE                  (SCS_BASE + 0x0010UL)
+#define NVIC_BASE                     (SCS_BASE + 0x0100UL)
+#define SCB_BASE                      (SCS_BASE + 0x0D00UL)
+#define CoreDebug_BASE                (0xE000EDF0UL)
+#define DWT_BASE                      (0xE0001000UL)
+
+#define SysTick                       ((SysTick_Type*)SysTick_BASE)
+#define NVIC                          ((NVIC_Type*)NVIC_BASE)
+#define SCB                           ((SCB_Type*)SCB_BASE)
+#define CoreDebug                     ((CoreDebug_Type*)CoreDebug_BASE)
+#define DWT                           ((DWT_Type*)DWT_BASE)
+
+#define SysTick_CTRL_ENABLE_Msk       (1UL << 0)
+#define SysTick_CTRL_TICKINT_Msk      (1UL << 1)
+#define SysTick_CTRL_CLKSOURCE_Msk    (1UL << 2)
+#define SysTick_CTRL_COUNTFLAG_Msk    (1UL << 16)
+#define SysTick_LOAD_RELOAD_Msk       (0xFFFFFFUL)
+#define SCB_SCR_SLEEPDEEP_Msk         (1UL << 2)
+#define CoreDebug_DEMCR_TRCENA_Msk    (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk        (1UL << 0)
+
+/* Exported functions ------------------------------------------------------- */
+void SIM_SetPrimask(uint32_t Primask);
+uint32_t SIM_GetPrimask(void);
+void SIM_Wfi(void);
+
+static inline void __disable_irq(void) { SIM_SetPrimask(1); }
+static inline void __enable_irq(void) { SIM_SetPrimask(0); }
+static inline uint32_t __get_PRIMASK(void) { return SIM_GetPrimask(); }
+static inline void __set_PRIMASK(uint32_t priMask) { SIM_SetPrimask(priMask & 1); }
+static inline void __WFI(void) { SIM_Wfi(); }
+static inline void __NOP(void) { }
+static inline void __DSB(void) { __sync_synchronize(); }
+static inline void __ISB(void) { __sync_synchronize(); }
+static inline void __DMB(void) { __sync_synchronize(); }
+
+static inline void NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+  NVIC->ISER[(uint32_t)IRQn >> 5] = 1UL << ((uint32_t)IRQn & 0x1F);
+}
+
+static inline void NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+  NVIC->ICER[(uint32_t)IRQn >> 5] = 1UL << ((uint32_t)IRQn & 0x1F);
+}
+
+static inline void NVIC_SetPendingIRQ(IRQn_Type IRQn)
+{
+  NVIC->ISPR[(uint32_t)IRQn >> 5] = 1UL << ((uint32_t)IRQn & 0x1F);
+}
+
+static inline void NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+  NVIC->ICPR[(uint32_t)IRQn >> 5] = 1UL << ((uint32_t)IRQn & 0x1F);
+}
+
+static inline void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority)
+{
+  if ((int32_t)IRQn < 0)
+  {
+    SCB->SHP[((uint32_t)IRQn & 0xF) - 4] = (uint8_t)(priority << (8 - __NVIC_PRIO_BITS));
+  }
+  else
+  {
+    NVIC->IP[(uint32_t)IRQn] = (uint8_t)(priority << (8 - __NVIC_PRIO_BITS));
+  }
+}
+
+static inline uint32_t SysTick_Config(uint32_t ticks)
+{
+  if ((ticks - 1) > SysTick_LOAD_RELOAD_Msk)
+  {
+    return 1;
+  }
+  SysTick->LOAD = ticks - 1;
+  NVIC_SetPriority(SysTick_IRQn, (1UL << __NVIC_PRIO_BITS) - 1);
+  SysTick->VAL = 0;
+  SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+  return 0;
+}
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_SIM_CORE_CM3_H */
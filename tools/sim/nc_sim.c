@@ -0,0 +1,1609 @@
+/**
+ * @file    nc_sim.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Host simulator of the STM32L1 peripherals
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/*
+ * Runs the unmodified drivers on a Linux x86-64 host. The peripheral and core
+ * register windows are mapped at their STM32L1 addresses with no access
+ * rights, so every register access faults. The fault handler opens the page,
+ * single-steps the one instruction and closes the page again; in between it
+ * knows the address, the direction, the old and the new value, and lets the
+ * register model react (BSRR sets ODR, ...). Virtual time advances by
+ * SIM_ACCESS_CYCLES per access and by SIM_Advance() for the code in between.
+ *
+ * SIM_Run() keeps the trap flag set instead, so every host instruction traps
+ * and counts as a fixed number of cycles. Interrupts are taken between any two
+ * instructions: the trap handler saves the interrupted context, and points the
+ * return at SIM_Exception(), which calls the handler and ends in ud2. The
+ * SIGILL handler then puts the saved context back, as an exception return.
+ * The simulator's own functions that the firmware calls (PRIMASK, __WFI())
+ * clear the trap flag while they run, so they cost no firmware time; the
+ * handlers they call are stepped again.
+ *
+ * Build the drivers with -I tools/sim ahead of the device headers and link
+ * with -no-pie, so that the 32-bit addresses the drivers write to DMA
+ * registers are the real host addresses of static buffers.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <setjmp.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include "nc_sim.h"
+
+/** @addtogroup NC_Tools
+  * @{
+  */
+
+/** @defgroup SIM
+  * @brief Host peripheral simulator
+  *
+@verbatim
+ ===============================================================================
+                         ##### How to use #####
+ ===============================================================================
+    [..] SIM_Init() once, before the first register access, with the core
+         clock that converts virtual cycles to time. Registers start at their
+         reset values.
+    [..] Call the drivers as on the target. SIM_Advance() stands for the code
+         and idle time between register accesses. SIM_Peek() and SIM_Poke()
+         read and set a register behind the models' back, e.g. to raise a
+         status flag.
+    [..] GPIO: BSRR and ODR writes update ODR and record a time-stamped change
+         for any port. SIM_VcdWrite() dumps the changes of one port as a VCD
+         waveform (GTKWave, PulseView, sigrok).
+    [..] Clocks and ADC: RCC ready flags follow their enable bits and SWS
+         follows SW, ADONS follows ADON, SR flags are rc_w0 and EGR, SWSTART
+         and JSWSTART clear themselves, so the init wait loops terminate.
+         The factory calibration words read by nc_vref and nc_temp hold
+         typical values.
+    [..] ADC1: a software start converts the regular sequence, all SQR ranks
+         with SCAN set or the first one without, or the injected ranks, each
+         after the programmed sample time plus 12 cycles. The codes come from
+         SIM_SetAdcInput(), or from the function SIM_SetAdcHook() installs.
+         EOC, JEOC and CONT behave as on the target, and reading DR clears
+         EOC.
+    [..] DMA1_Channel1 serves ADC1 with CR2 DMA set, as with DDS: each regular
+         conversion requests one transfer of DR, which the enabled channel
+         makes at once, counting CNDTR down, raising HT and TC and reloading
+         in circular mode. A request waits while the channel is disabled; a
+         conversion that ends with one still waiting sets OVR and replaces
+         the data, and no transfer is made until OVR is cleared.
+    [..] CRC: each DR write runs the word through the CRC-32 polynomial MSB
+         first, and CR RESET loads 0xFFFFFFFF, as the CRC unit does.
+    [..] USART1 transmitter, 8N1, fed by DR writes or by DMA1_Channel4: a byte
+         takes 10 * BRR APB2 clocks on the line, TDR and the shift register
+         each hold one, and TXE and TC follow. The channel moves a byte from
+         memory on each request while enabled, counts CNDTR down and raises
+         HT and TC. DMA IFCR clears the flags written, GL all four of the
+         channel. SIM_SetUsartTx() records what goes out on the line.
+    [..] Interrupts: SIM_SetVector() installs the handlers. NVIC enable,
+         pending and priority registers, PRIMASK and the SysTick timer are
+         modelled, and peripheral interrupt lines are levels. An exception
+         without a vector stays pending. They are taken after a register
+         access, on __enable_irq(), __WFI() and SIM_Advance(), and after any
+         instruction under SIM_Run(). SIM_GetIrqCount() counts the entries.
+    [..] SIM_Run() runs a function, e.g. the firmware main(), one host
+         instruction at a time for a given number of cycles, and returns
+         even if the function never does.
+    [..] Tracing: between SIM_TraceStart() and SIM_TraceStop() every access is
+         logged with its virtual time, host instruction address, and the
+         word before and after. SIM_RegName() turns an address into a name.
+@endverbatim
+  * @{
+  */
+
+/* Private typedef -----------------------------------------------------------*/
+
+/**
+  * @brief  One register window mapped at its target address.
+  */
+typedef struct
+{
+  uintptr_t Base;
+  uint32_t Size;
+  uint8_t* pAlias;            /*!< Same memory, always accessible */
+}SIM_RegionTypeDef;
+
+/**
+  * @brief  The access being single-stepped.
+  */
+typedef struct
+{
+  uintptr_t Addr;             /*!< Word address */
+  uintptr_t Page;
+  uintptr_t Pc;
+  uint32_t Old;
+  uint8_t Write;
+  uint8_t Active;
+}SIM_StepTypeDef;
+
+/**
+  * @brief  Context interrupted by an exception taken from the trap handler.
+  */
+typedef struct
+{
+  gregset_t Gregs;
+  struct _libc_fpstate Fp;
+}SIM_FrameTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define SIM_PAGE_SIZE             4096UL
+#define SIM_EFLAGS_TF             0x100UL     /* x86 trap flag: one instruction, then SIGTRAP */
+#define SIM_PF_WRITE              0x2UL       /* Page fault error code: write access */
+#define SIM_GPIO_PORTS            8
+#define SIM_GPIO_STRIDE           0x400UL
+#define SIM_INFO_BASE             0x1FF80000UL  /* Factory calibration words */
+#define SIM_VREFINT_CAL           1671          /* 1.224 V at VDDA = 3.0 V */
+#define SIM_TS_CAL1               680
+#define SIM_TS_CAL2               852
+#define SIM_EXC_NUM               (16 + 64)   /* Core exceptions, then IRQ0..63 */
+#define SIM_MAX_NEST              16          /* One level per priority */
+#define SIM_IRQ_CYCLES            12          /* Cortex-M3 exception entry, and again for the return */
+#define SIM_RED_ZONE              128         /* x86-64 ABI: below RSP, still in use */
+#define SIM_NEVER                 (~0ULL)
+#define SIM_ADC_CONV_CYCLES       12          /* 12-bit successive approximation */
+
+/* Private macro -------------------------------------------------------------*/
+#define SIM_REG(ADDR)             (*(uint32_t*)SIM_Alias(ADDR))
+
+/* Private variables ---------------------------------------------------------*/
+static SIM_RegionTypeDef SIM_Region[] =
+{
+  {PERIPH_BASE, 0x30000, 0},          /* APB1, APB2, AHB: up to DMA2 and FLASH */
+  {DWT_BASE,    0x1000,  0},
+  {SCS_BASE,    0x1000,  0},          /* SysTick, NVIC, SCB, CoreDebug */
+  {SIM_INFO_BASE, 0x1000, 0}
+};
+static SIM_StepTypeDef SIM_Step;
+static uint64_t SIM_Cycles;
+static uint32_t SIM_CoreClock;
+static uint32_t SIM_Primask;
+static SIM_EdgeTypeDef SIM_Edge[SIM_MAX_EDGES];
+static uint32_t SIM_NumEdges;
+static SIM_AccessTypeDef* SIM_Trace;
+static uint32_t SIM_TraceSize;
+static uint32_t SIM_TraceCount;
+static void (*SIM_Vector[SIM_EXC_NUM])(void);
+static uint32_t SIM_Entries[SIM_EXC_NUM];
+static uint8_t SIM_Active[SIM_MAX_NEST];      /* Exception numbers, innermost last */
+static uint32_t SIM_Depth;
+static SIM_FrameTypeDef SIM_Frame[SIM_MAX_NEST];
+static uint32_t SIM_Frames;
+static volatile sig_atomic_t SIM_Busy;        /* Simulator code running, no exception entry */
+static uint32_t SIM_SysTickPending;
+static uint32_t SIM_StepCycles;
+static uint64_t SIM_Deadline;
+static sigjmp_buf SIM_Escape;
+static uint64_t SIM_SysTickDue = SIM_NEVER;
+static uint64_t SIM_AdcDue = SIM_NEVER;
+static uint64_t SIM_AdcInjDue = SIM_NEVER;
+static uint16_t SIM_AdcInput[32];
+static uint16_t (*SIM_AdcHook)(uint32_t Channel);
+static uint32_t SIM_AdcRank;                  /* Regular rank converting, from 0 */
+static uint32_t SIM_AdcRequest;               /* 1 while DR waits for DMA1 channel 1 */
+static uintptr_t SIM_Dma1Addr;                /* Channel 1 memory pointer */
+static uint32_t SIM_Dma1Count;                /* Channel 1 CNDTR at enable */
+static uint64_t SIM_UsartDue = SIM_NEVER;     /* Shift register empty, SIM_NEVER while idle */
+static uint32_t SIM_UsartTdr;                 /* 1 while TDR holds a byte */
+static uint8_t SIM_UsartTdrByte;
+static uintptr_t SIM_DmaAddr;                 /* Channel 4 memory pointer */
+static uint32_t SIM_DmaCount;                 /* Channel 4 CNDTR at enable */
+static uint8_t* SIM_UsartOut;
+static uint32_t SIM_UsartOutSize;
+static uint32_t SIM_UsartBytes;
+static uint64_t SIM_UsartFirst;
+static uint64_t SIM_UsartLast;
+
+uint32_t SystemCoreClock = 2097000;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t* SIM_Alias(uintptr_t Addr);
+static void SIM_Fault(int Sig, siginfo_t* pInfo, void* pContext);
+static void SIM_Trap(int Sig, siginfo_t* pInfo, void* pContext);
+static void SIM_Return(int Sig, siginfo_t* pInfo, void* pContext);
+static void SIM_Exception(uint32_t Exc);
+static void SIM_Dispatch(ucontext_t* uc);
+static void SIM_Poll(void);
+static void SIM_Enter(void);
+static void SIM_Leave(void);
+static void SIM_Stepping(uint32_t On);
+static int32_t SIM_Next(void);
+static uint32_t SIM_Priority(uint32_t Exc);
+static void SIM_Request(uint32_t Exc);
+static void SIM_Lines(void);
+static void SIM_Elapse(uint64_t Cycles);
+static uint64_t SIM_NextEvent(void);
+static uint32_t SIM_AdcCycles(uint32_t Channel);
+static uint32_t SIM_AdcChannel(uint32_t Rank);
+static void SIM_AdcDma(void);
+static void SIM_Read(uintptr_t Addr);
+static void SIM_Write(uintptr_t Addr, uint32_t Old, uint32_t New);
+static void SIM_GpioChange(uint32_t Port, uint32_t Old, uint32_t New);
+static uint32_t SIM_Crc32(uint32_t Crc, uint32_t Data);
+static void SIM_Usart(void);
+static void SIM_UsartShift(uint8_t Byte, uint64_t Start);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Maps the register windows and installs the access handlers.
+  * @param  CoreClock: Hz, converts virtual cycles to time.
+  * @retval None
+  */
+void SIM_Init(uint32_t CoreClock)
+{
+  struct sigaction sa;
+  uint32_t i;
+  int fd;
+
+  for (i = 0; i < sizeof(SIM_Region) / sizeof(SIM_Region[0]); i++)
+  {
+    fd = memfd_create("nc_sim", 0);
+    if ((fd < 0) || (ftruncate(fd, SIM_Region[i].Size) != 0) ||
+        (mmap((void*)SIM_Region[i].Base, SIM_Region[i].Size, PROT_NONE,
+              MAP_SHARED | MAP_FIXED_NOREPLACE, fd, 0) != (void*)SIM_Region[i].Base))
+    {
+      fprintf(stderr, "nc_sim: cannot map 0x%08lx\n", (unsigned long)SIM_Region[i].Base);
+      exit(1);
+    }
+    SIM_Region[i].pAlias = mmap(0, SIM_Region[i].Size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+  }
+
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_flags = SA_SIGINFO;
+  sa.sa_sigaction = SIM_Fault;
+  sigaction(SIGSEGV, &sa, 0);
+  sa.sa_sigaction = SIM_Trap;
+  sigaction(SIGTRAP, &sa, 0);
+  sa.sa_sigaction = SIM_Return;
+  sigaction(SIGILL, &sa, 0);
+
+  SIM_CoreClock = CoreClock;
+  SIM_Cycles = 0;
+  SIM_NumEdges = 0;
+  SIM_Reset();
+}
+
+/**
+  * @brief  Puts every simulated register back to its reset value, as after a
+  *         reset or a wake-up from Standby. Virtual time and records are kept.
+  * @retval None
+  */
+void SIM_Reset(void)
+{
+  uint32_t i;
+
+  for (i = 0; i < sizeof(SIM_Region) / sizeof(SIM_Region[0]); i++)
+  {
+    memset(SIM_Region[i].pAlias, 0, SIM_Region[i].Size);
+  }
+  SIM_REG((uintptr_t)&RCC->CR) = RCC_CR_MSION | RCC_CR_MSIRDY;
+  SIM_REG((uintptr_t)&RCC->ICSCR) = 0x0000B000;               /* MSI range 5, 2.097 MHz */
+  SIM_REG((uintptr_t)&GPIOA->MODER) = 0xA8000000;             /* PA13..15: SWD */
+  SIM_REG((uintptr_t)&GPIOB->MODER) = 0x00000280;             /* PB3, PB4: SWO, NJTRST */
+  SIM_REG((uintptr_t)&GPIOB->OSPEEDR) = 0x000000C0;
+  SIM_REG((uintptr_t)&GPIOB->PUPDR) = 0x00000100;
+  SIM_REG(SIM_INFO_BASE + 0x78) = SIM_VREFINT_CAL | (SIM_TS_CAL1 << 16);
+  SIM_REG(SIM_INFO_BASE + 0x7C) = (uint32_t)SIM_TS_CAL2 << 16;
+  SIM_REG((uintptr_t)&CRC->DR) = 0xFFFFFFFF;
+  SIM_REG((uintptr_t)&USART1->SR) = USART_SR_TXE | USART_SR_TC;
+  SIM_SysTickPending = 0;
+  SIM_SysTickDue = SIM_NEVER;
+  SIM_AdcDue = SIM_NEVER;
+  SIM_AdcInjDue = SIM_NEVER;
+  SIM_AdcRank = 0;
+  SIM_AdcRequest = 0;
+  SIM_UsartDue = SIM_NEVER;
+  SIM_UsartTdr = 0;
+  SystemCoreClockUpdate();
+}
+
+/**
+  * @brief  Virtual time.
+  * @retval Core cycles since SIM_Init().
+  */
+uint64_t SIM_GetCycles(void)
+{
+  return SIM_Cycles;
+}
+
+/**
+  * @brief  Lets virtual time pass, for the code and idle time between accesses.
+  * @param  Cycles: core cycles.
+  * @retval None
+  */
+void SIM_Advance(uint32_t Cycles)
+{
+  uint64_t end = SIM_Cycles + Cycles;
+  uint64_t due;
+
+  SIM_Enter();
+  SIM_Poll();
+  while (SIM_Cycles < end)
+  {
+    due = SIM_NextEvent();
+    SIM_Elapse(((due > SIM_Cycles) && (due < end)) ? (due - SIM_Cycles) : (end - SIM_Cycles));
+    SIM_Poll();
+  }
+  SIM_Leave();
+}
+
+/**
+  * @brief  Installs an exception handler.
+  * @param  IRQn: interrupt number, SysTick_IRQn for the SysTick exception.
+  * @param  pHandler: handler, 0 leaves the exception pending forever.
+  * @retval None
+  */
+void SIM_SetVector(IRQn_Type IRQn, void (*pHandler)(void))
+{
+  SIM_Vector[(int32_t)IRQn + 16] = pHandler;
+}
+
+/**
+  * @brief  Number of times an exception has been taken.
+  * @param  IRQn: interrupt number, SysTick_IRQn for the SysTick exception.
+  * @retval Entries since SIM_Init().
+  */
+uint32_t SIM_GetIrqCount(IRQn_Type IRQn)
+{
+  return SIM_Entries[(int32_t)IRQn + 16];
+}
+
+/**
+  * @brief  Sets the code an ADC channel converts to.
+  * @param  Channel: 0 to 31.
+  * @param  Code: 12-bit result.
+  * @retval None
+  */
+void SIM_SetAdcInput(uint32_t Channel, uint16_t Code)
+{
+  SIM_AdcInput[Channel & 31] = Code & 0xFFF;
+}
+
+/**
+  * @brief  Makes every ADC conversion ask a function for its code, e.g. to
+  *         give each sample a value its position can be told from.
+  * @param  pHook: returns the 12-bit code of a channel, 0 goes back to
+  *         SIM_SetAdcInput().
+  * @retval None
+  */
+void SIM_SetAdcHook(uint16_t (*pHook)(uint32_t Channel))
+{
+  SIM_AdcHook = pHook;
+}
+
+/**
+  * @brief  Records the bytes USART1 sends and restarts its counters.
+  * @param  pBuffer: receives the bytes, 0 to count them only.
+  * @param  Size: bytes kept in pBuffer, later ones are counted only.
+  * @retval None
+  */
+void SIM_SetUsartTx(uint8_t* pBuffer, uint32_t Size)
+{
+  SIM_UsartOut = pBuffer;
+  SIM_UsartOutSize = (pBuffer != 0) ? Size : 0;
+  SIM_UsartBytes = 0;
+}
+
+/**
+  * @brief  What USART1 has sent since SIM_SetUsartTx().
+  * @param  pFirst: receives the cycle the first start bit began, may be 0.
+  * @param  pLast: receives the cycle the last stop bit ended, may be 0.
+  * @retval Bytes sent, including those that did not fit the buffer.
+  */
+uint32_t SIM_GetUsartTx(uint64_t* pFirst, uint64_t* pLast)
+{
+  if (pFirst != 0)
+  {
+    *pFirst = SIM_UsartFirst;
+  }
+  if (pLast != 0)
+  {
+    *pLast = SIM_UsartLast;
+  }
+  return SIM_UsartBytes;
+}
+
+/**
+  * @brief  Runs a function one host instruction at a time, with interrupts
+  *         taken between any two instructions.
+  * @param  pFunc: function to run, e.g. the firmware main().
+  * @param  CyclesPerInstr: virtual cycles per host instruction, at least 1.
+  * @param  Cycles: virtual time after which pFunc is abandoned.
+  * @retval 0 if pFunc returned, 1 if the time ran out first.
+  */
+int32_t SIM_Run(void (*pFunc)(void), uint32_t CyclesPerInstr, uint64_t Cycles)
+{
+  SIM_Deadline = SIM_Cycles + Cycles;
+  if (sigsetjmp(SIM_Escape, 1) != 0)
+  {
+    /* Left from the trap handler, possibly from inside an exception */
+    SIM_StepCycles = 0;
+    SIM_Depth = 0;
+    SIM_Frames = 0;
+    SIM_Busy = 0;
+    return 1;
+  }
+  SIM_StepCycles = (CyclesPerInstr != 0) ? CyclesPerInstr : 1;
+  __asm__ volatile("pushfq\n\torq $0x100, (%%rsp)\n\tpopfq" ::: "memory", "cc");
+  pFunc();
+  SIM_StepCycles = 0;                         /* The next trap clears TF */
+  return 0;
+}
+
+/**
+  * @brief  Reads a register without tracing it or triggering its model.
+  * @param  pReg: register address.
+  * @retval The 32-bit word holding the register.
+  */
+uint32_t SIM_Peek(volatile void* pReg)
+{
+  return SIM_REG((uintptr_t)pReg & ~3UL);
+}
+
+/**
+  * @brief  Sets a register without tracing it or triggering its model.
+  * @param  pReg: register address.
+  * @param  Value: new content of the 32-bit word holding the register.
+  * @retval None
+  */
+void SIM_Poke(volatile void* pReg, uint32_t Value)
+{
+  SIM_REG((uintptr_t)pReg & ~3UL) = Value;
+}
+
+/**
+  * @brief  Recorded GPIO output changes, all ports, in time order.
+  * @param  ppEdges: receives the array.
+  * @retval Number of changes (at most SIM_MAX_EDGES).
+  */
+uint32_t SIM_GetEdges(const SIM_EdgeTypeDef** ppEdges)
+{
+  *ppEdges = SIM_Edge;
+  return (SIM_NumEdges < SIM_MAX_EDGES) ? SIM_NumEdges : SIM_MAX_EDGES;
+}
+
+/**
+  * @brief  Writes the recorded output changes of one port as a VCD waveform.
+  * @param  pPath: file to create.
+  * @param  GPIOx: port.
+  * @param  ppNames: 16 signal names, one per pin, 0 for pins left out.
+  * @retval 0 on success, -1 if the file cannot be written.
+  */
+int32_t SIM_VcdWrite(const char* pPath, GPIO_TypeDef* GPIOx, const char* const* ppNames)
+{
+  uint32_t port = (uint32_t)(((uintptr_t)GPIOx - GPIOA_BASE) / SIM_GPIO_STRIDE);
+  uint32_t count = (SIM_NumEdges < SIM_MAX_EDGES) ? SIM_NumEdges : SIM_MAX_EDGES;
+  uint32_t odr = 0;
+  uint32_t i, pin;
+  FILE* fp;
+
+  fp = fopen(pPath, "w");
+  if (fp == 0)
+  {
+    return -1;
+  }
+  fprintf(fp, "$timescale 1 ns $end\n$scope module gpio%c $end\n", "abcdehfg"[port & 7]);
+  for (pin = 0; pin < 16; pin++)
+  {
+    if (ppNames[pin] != 0)
+    {
+      fprintf(fp, "$var wire 1 %c %s $end\n", '!' + pin, ppNames[pin]);
+    }
+  }
+  fprintf(fp, "$upscope $end\n$enddefinitions $end\n#0\n$dumpvars\n");
+  for (pin = 0; pin < 16; pin++)
+  {
+    if (ppNames[pin] != 0)
+    {
+      fprintf(fp, "0%c\n", '!' + pin);
+    }
+  }
+  fprintf(fp, "$end\n");
+
+  for (i = 0; i < count; i++)
+  {
+    if (SIM_Edge[i].Port != port)
+    {
+      continue;
+    }
+    fprintf(fp, "#%llu\n", (unsigned long long)(SIM_Edge[i].Cycles * 1000000000ULL / SIM_CoreClock));
+    for (pin = 0; pin < 16; pin++)
+    {
+      if ((ppNames[pin] != 0) && (((odr ^ SIM_Edge[i].Odr) >> pin) & 1))
+      {
+        fprintf(fp, "%u%c\n", (SIM_Edge[i].Odr >> pin) & 1, '!' + pin);
+      }
+    }
+    odr = SIM_Edge[i].Odr;
+  }
+  return (fclose(fp) == 0) ? 0 : -1;
+}
+
+/**
+  * @brief  Starts logging every register access.
+  * @param  pBuffer: receives the accesses.
+  * @param  Size: entries in pBuffer, later accesses are counted only.
+  * @retval None
+  */
+void SIM_TraceStart(SIM_AccessTypeDef* pBuffer, uint32_t Size)
+{
+  SIM_TraceSize = Size;
+  SIM_TraceCount = 0;
+  SIM_Trace = pBuffer;
+}
+
+/**
+  * @brief  Stops logging.
+  * @retval Accesses since SIM_TraceStart(), including those that did not fit.
+  */
+uint32_t SIM_TraceStop(void)
+{
+  SIM_Trace = 0;
+  return SIM_TraceCount;
+}
+
+/**
+  * @brief  Name of a register, e.g. "ADC1->CR2" or "DMA1_Channel4->CNDTR".
+  * @param  Addr: word address.
+  * @param  pBuf: room for the name.
+  * @param  Size: bytes in pBuf.
+  * @retval pBuf.
+  */
+const char* SIM_RegName(uint32_t Addr, char* pBuf, uint32_t Size)
+{
+  static const char* const rcc[] = {"CR", "ICSCR", "CFGR", "CIR", "AHBRSTR", "APB2RSTR", "APB1RSTR",
+                                    "AHBENR", "APB2ENR", "APB1ENR", "AHBLPENR", "APB2LPENR", "APB1LPENR", "CSR"};
+  static const char* const gpio[] = {"MODER", "OTYPER", "OSPEEDR", "PUPDR", "IDR", "ODR", "BSRR", "LCKR", "AFR[0]", "AFR[1]"};
+  static const char* const tim[] = {"CR1", "CR2", "SMCR", "DIER", "SR", "EGR", "CCMR1", "CCMR2", "CCER", "CNT",
+                                    "PSC", "ARR", "RCR", "CCR1", "CCR2", "CCR3", "CCR4", "BDTR", "DCR", "DMAR", "OR"};
+  static const char* const adc[] = {"SR", "CR1", "CR2", "SMPR1", "SMPR2", "SMPR3", "JOFR1", "JOFR2", "JOFR3", "JOFR4",
+                                    "HTR", "LTR", "SQR1", "SQR2", "SQR3", "SQR4", "SQR5", "JSQR", "JDR1", "JDR2",
+                                    "JDR3", "JDR4", "DR", "SMPR0"};
+  static const char* const chan[] = {"CCR", "CNDTR", "CPAR", "CMAR", "?"};
+  static const char* const usart[] = {"SR", "DR", "BRR", "CR1", "CR2", "CR3", "GTPR"};
+  static const char* const crc[] = {"DR", "IDR", "CR"};
+  static const char* const flash[] = {"ACR", "PECR", "PDKEYR", "PEKEYR", "PRGKEYR", "OPTKEYR", "SR", "OBR", "WRPR"};
+  static const char* const systick[] = {"CTRL", "LOAD", "VAL", "CALIB"};
+  static const char* const dwt[] = {"CTRL", "CYCCNT"};
+  static const char* const dbg[] = {"DHCSR", "DCRSR", "DCRDR", "DEMCR"};
+  const char* const* regs = 0;
+  const char* periph = 0;
+  uint32_t off = 0, count = 0, n;
+
+#define SIM_NAME(BASE, NAME, TABLE)                                                   \
+  if ((periph == 0) && (Addr >= (BASE)) && (Addr - (BASE) < 4 * (sizeof(TABLE) / sizeof(TABLE[0])))) \
+  {                                                                                   \
+    periph = (NAME);                                                                  \
+    regs = (TABLE);                                                                   \
+    off = Addr - (BASE);                                                              \
+    count = sizeof(TABLE) / sizeof(TABLE[0]);                                         \
+  }
+  SIM_NAME(RCC_BASE, "RCC", rcc)
+  SIM_NAME(TIM3_BASE, "TIM3", tim)
+  SIM_NAME(TIM4_BASE, "TIM4", tim)
+  SIM_NAME(ADC1_BASE, "ADC1", adc)
+  SIM_NAME(USART1_BASE, "USART1", usart)
+  SIM_NAME(CRC_BASE, "CRC", crc)
+  SIM_NAME(FLASH_R_BASE, "FLASH", flash)
+  SIM_NAME(SysTick_BASE, "SysTick", systick)
+  SIM_NAME(DWT_BASE, "DWT", dwt)
+  SIM_NAME(CoreDebug_BASE, "CoreDebug", dbg)
+#undef SIM_NAME
+
+  if ((periph == 0) && (Addr >= GPIOA_BASE) && (Addr < GPIOA_BASE + SIM_GPIO_PORTS * SIM_GPIO_STRIDE) &&
+      ((Addr & (SIM_GPIO_STRIDE - 1)) < 4 * (sizeof(gpio) / sizeof(gpio[0]))))
+  {
+    n = (uint32_t)((Addr - GPIOA_BASE) / SIM_GPIO_STRIDE);
+    snprintf(pBuf, Size, "GPIO%c->%s", "ABCDEHFG"[n], gpio[(Addr & (SIM_GPIO_STRIDE - 1)) / 4]);
+    return pBuf;
+  }
+  if ((periph == 0) && (Addr >= DMA1_BASE) && (Addr < DMA1_BASE + 0x08 + 7 * 0x14))
+  {
+    if (Addr < DMA1_BASE + 0x08)
+    {
+      snprintf(pBuf, Size, "DMA1->%s", (Addr == DMA1_BASE) ? "ISR" : "IFCR");
+    }
+    else
+    {
+      n = (Addr - DMA1_BASE - 0x08) / 0x14;
+      snprintf(pBuf, Size, "DMA1_Channel%u->%s", n + 1, chan[((Addr - DMA1_BASE - 0x08) % 0x14) / 4]);
+    }
+    return pBuf;
+  }
+  if ((periph == 0) && (Addr >= ADC_BASE) && (Addr < ADC_BASE + 8))
+  {
+    snprintf(pBuf, Size, "ADC->%s", (Addr == ADC_BASE) ? "CSR" : "CCR");
+    return pBuf;
+  }
+  if ((periph == 0) && (Addr >= NVIC_BASE) && (Addr < NVIC_BASE + 0x400))
+  {
+    snprintf(pBuf, Size, "NVIC+0x%03x", (uint32_t)(Addr - NVIC_BASE));
+    return pBuf;
+  }
+  if ((periph == 0) || (off / 4 >= count))
+  {
+    snprintf(pBuf, Size, "0x%08x", Addr);
+    return pBuf;
+  }
+  snprintf(pBuf, Size, "%s->%s", periph, regs[off / 4]);
+  return pBuf;
+}
+
+/**
+  * @brief  PRIMASK, as set by __disable_irq() and __set_PRIMASK().
+  * @param  Primask: 1 masks interrupts.
+  * @retval None
+  */
+void SIM_SetPrimask(uint32_t Primask)
+{
+  SIM_Enter();
+  SIM_Primask = Primask;
+  if (Primask == 0)
+  {
+    SIM_Poll();
+  }
+  SIM_Leave();
+}
+
+/**
+  * @brief  PRIMASK, as read by __get_PRIMASK().
+  * @retval 1 if interrupts are masked.
+  */
+uint32_t SIM_GetPrimask(void)
+{
+  return SIM_Primask;
+}
+
+/**
+  * @brief  __WFI(): idle until the next model event, then take what is pending.
+  * @retval None
+  */
+void SIM_Wfi(void)
+{
+  uint64_t due = SIM_NextEvent();
+
+  if ((SIM_StepCycles != 0) && (due > SIM_Deadline))
+  {
+    due = SIM_Deadline;
+  }
+  SIM_Advance(((due > SIM_Cycles) && (due - SIM_Cycles < 0xFFFFFFFFULL)) ? (uint32_t)(due - SIM_Cycles) : 1);
+}
+
+/**
+  * @brief  Nothing to do, the clock tree starts from the simulated RCC reset state.
+  * @retval None
+  */
+void SystemInit(void)
+{
+}
+
+/**
+  * @brief  SystemCoreClock from the simulated RCC: MSI range, HSI, HSE or PLL, AHB prescaler.
+  * @retval None
+  */
+void SystemCoreClockUpdate(void)
+{
+  static const uint8_t mul[16] = {3, 4, 6, 8, 12, 16, 24, 32, 48, 48, 48, 48, 48, 48, 48, 48};
+  static const uint8_t shift[16] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 6, 7, 8, 9};
+  uint32_t cfgr = SIM_REG((uintptr_t)&RCC->CFGR);
+  uint32_t clock;
+
+  switch ((cfgr >> 2) & 3)
+  {
+    case 0:
+      clock = 32768UL * (2UL << ((SIM_REG((uintptr_t)&RCC->ICSCR) >> 13) & 7));
+      break;
+    case 1:
+      clock = HSI_VALUE;
+      break;
+    case 2:
+      clock = HSE_VALUE;
+      break;
+    default:
+      clock = ((cfgr & RCC_CFGR_PLLSRC) ? HSE_VALUE : HSI_VALUE) * mul[(cfgr >> 18) & 15] / (((cfgr >> 22) & 3) + 1);
+      break;
+  }
+  SystemCoreClock = clock >> shift[(cfgr >> 4) & 15];
+}
+
+/**
+  * @brief  Alias of a simulated register.
+  * @param  Addr: target address.
+  * @retval Pointer into the accessible alias, 0 outside the register windows.
+  */
+static uint8_t* SIM_Alias(uintptr_t Addr)
+{
+  uint32_t i;
+
+  for (i = 0; i < sizeof(SIM_Region) / sizeof(SIM_Region[0]); i++)
+  {
+    if ((Addr >= SIM_Region[i].Base) && (Addr < SIM_Region[i].Base + SIM_Region[i].Size))
+    {
+      return SIM_Region[i].pAlias + (Addr - SIM_Region[i].Base);
+    }
+  }
+  return 0;
+}
+
+
+/**
+  * @brief  SIGSEGV: a register access. Opens the page and single-steps it.
+  * @param  Sig: SIGSEGV.
+  * @param  pInfo: faulting address.
+  * @param  pContext: interrupted context.
+  * @retval None
+  */
+static void SIM_Fault(int Sig, siginfo_t* pInfo, void* pContext)
+{
+  ucontext_t* uc = (ucontext_t*)pContext;
+  uintptr_t addr = (uintptr_t)pInfo->si_addr;
+
+  if ((SIM_Alias(addr) == 0) || SIM_Step.Active)
+  {
+    /* A real crash: let it happen with the default action */
+    signal(Sig, SIG_DFL);
+    return;
+  }
+  SIM_Step.Addr = addr & ~3UL;
+  SIM_Step.Page = addr & ~(SIM_PAGE_SIZE - 1);
+  SIM_Step.Write = (uc->uc_mcontext.gregs[REG_ERR] & SIM_PF_WRITE) != 0;
+  SIM_Step.Pc = (uintptr_t)uc->uc_mcontext.gregs[REG_RIP];
+  SIM_Step.Old = SIM_REG(SIM_Step.Addr);
+  SIM_Step.Active = 1;
+  mprotect((void*)SIM_Step.Page, SIM_PAGE_SIZE, PROT_READ | PROT_WRITE);
+  uc->uc_mcontext.gregs[REG_EFL] |= SIM_EFLAGS_TF;
+}
+
+/**
+  * @brief  SIGTRAP: the access is done. Closes the page and runs the register model.
+  * @param  Sig: SIGTRAP.
+  * @param  pInfo: unused.
+  * @param  pContext: interrupted context.
+  * @retval None
+  */
+static void SIM_Trap(int Sig, siginfo_t* pInfo, void* pContext)
+{
+  ucontext_t* uc = (ucontext_t*)pContext;
+
+  (void)Sig;
+  (void)pInfo;
+  if (SIM_Step.Active)
+  {
+    mprotect((void*)SIM_Step.Page, SIM_PAGE_SIZE, PROT_NONE);
+    SIM_Step.Active = 0;
+    SIM_Cycles += SIM_ACCESS_CYCLES;
+    if (SIM_Trace != 0)
+    {
+      if (SIM_TraceCount < SIM_TraceSize)
+      {
+        SIM_Trace[SIM_TraceCount].Cycles = SIM_Cycles;
+        SIM_Trace[SIM_TraceCount].Pc = SIM_Step.Pc;
+        SIM_Trace[SIM_TraceCount].Addr = (uint32_t)SIM_Step.Addr;
+        SIM_Trace[SIM_TraceCount].Old = SIM_Step.Old;
+        SIM_Trace[SIM_TraceCount].New = SIM_REG(SIM_Step.Addr);
+        SIM_Trace[SIM_TraceCount].Write = SIM_Step.Write;
+      }
+      SIM_TraceCount++;
+    }
+    if (SIM_Step.Write)
+    {
+      SIM_Write(SIM_Step.Addr, SIM_Step.Old, SIM_REG(SIM_Step.Addr));
+    }
+    else
+    {
+      SIM_Read(SIM_Step.Addr);
+    }
+    SIM_Elapse(0);
+  }
+
+  if (SIM_StepCycles == 0)
+  {
+    uc->uc_mcontext.gregs[REG_EFL] &= ~SIM_EFLAGS_TF;
+  }
+  else if (SIM_Busy == 0)
+  {
+    uc->uc_mcontext.gregs[REG_EFL] |= SIM_EFLAGS_TF;
+    SIM_Elapse(SIM_StepCycles);
+    if (SIM_Cycles >= SIM_Deadline)
+    {
+      siglongjmp(SIM_Escape, 1);
+    }
+  }
+  /* Else simulator code is turning stepping off, see SIM_Enter() */
+  SIM_Dispatch(uc);
+}
+
+/**
+  * @brief  SIGILL: the ud2 at the end of SIM_Exception(). Returns from the
+  *         exception to the saved context, or chains to the next one.
+  * @param  Sig: SIGILL.
+  * @param  pInfo: unused.
+  * @param  pContext: context to replace.
+  * @retval None
+  */
+static void SIM_Return(int Sig, siginfo_t* pInfo, void* pContext)
+{
+  extern const char sim_exception_return[];
+  ucontext_t* uc = (ucontext_t*)pContext;
+
+  (void)pInfo;
+  if ((SIM_Frames == 0) || ((uintptr_t)uc->uc_mcontext.gregs[REG_RIP] != (uintptr_t)sim_exception_return))
+  {
+    signal(Sig, SIG_DFL);
+    return;
+  }
+  SIM_Frames--;
+  memcpy(uc->uc_mcontext.gregs, SIM_Frame[SIM_Frames].Gregs, sizeof(gregset_t));
+  memcpy(uc->uc_mcontext.fpregs, &SIM_Frame[SIM_Frames].Fp, sizeof(struct _libc_fpstate));
+  SIM_Depth--;
+  SIM_Elapse(SIM_IRQ_CYCLES);
+  SIM_Lines();
+  SIM_Dispatch(uc);
+}
+
+/**
+  * @brief  Runs an exception handler entered from the trap handler.
+  * @param  Exc: exception number.
+  * @retval None, ends in ud2 for SIM_Return().
+  */
+__attribute__((noinline, noclone, used)) static void SIM_Exception(uint32_t Exc)
+{
+  SIM_Vector[Exc]();
+  __asm__ volatile("sim_exception_return: ud2");
+}
+
+/**
+  * @brief  Takes the most urgent pending exception, if it may preempt, by
+  *         redirecting the interrupted context to SIM_Exception().
+  * @param  uc: context the trap handler returns to.
+  * @retval None
+  */
+static void SIM_Dispatch(ucontext_t* uc)
+{
+  greg_t sp;
+  int32_t exc;
+
+  if ((SIM_Busy != 0) || ((exc = SIM_Next()) < 0))
+  {
+    return;
+  }
+  memcpy(SIM_Frame[SIM_Frames].Gregs, uc->uc_mcontext.gregs, sizeof(gregset_t));
+  memcpy(&SIM_Frame[SIM_Frames].Fp, uc->uc_mcontext.fpregs, sizeof(struct _libc_fpstate));
+  SIM_Frames++;
+  if (exc == 15)
+  {
+    SIM_SysTickPending = 0;
+  }
+  else
+  {
+    SIM_REG((uintptr_t)&NVIC->ISPR[(exc - 16) >> 5]) &= ~(1UL << ((exc - 16) & 31));
+  }
+  SIM_Active[SIM_Depth++] = (uint8_t)exc;
+  SIM_Entries[exc]++;
+  SIM_Elapse(SIM_IRQ_CYCLES);
+
+  /* Below the red zone, aligned as right after a call */
+  sp = ((uc->uc_mcontext.gregs[REG_RSP] - SIM_RED_ZONE) & ~(greg_t)15) - 8;
+  *(uintptr_t*)sp = 0;
+  uc->uc_mcontext.gregs[REG_RSP] = sp;
+  uc->uc_mcontext.gregs[REG_RIP] = (greg_t)(uintptr_t)SIM_Exception;
+  uc->uc_mcontext.gregs[REG_RDI] = exc;
+}
+
+/**
+  * @brief  Enters simulator code called from the firmware or the host program.
+  *         It is not stepped: its time is what it elapses on purpose.
+  * @retval None
+  */
+static void SIM_Enter(void)
+{
+  SIM_Busy++;
+  SIM_Stepping(0);
+}
+
+/**
+  * @brief  Returns from simulator code, stepping again under SIM_Run().
+  * @retval None
+  */
+static void SIM_Leave(void)
+{
+  SIM_Busy--;
+  SIM_Stepping((SIM_Busy == 0) && (SIM_StepCycles != 0));
+}
+
+/**
+  * @brief  Sets or clears the trap flag of the running code.
+  * @param  On: 1 traps after every instruction from the next one on.
+  * @retval None
+  */
+static void SIM_Stepping(uint32_t On)
+{
+  /* Clear of the red zone, which pushfq would otherwise overwrite */
+  if (On != 0)
+  {
+    __asm__ volatile("leaq -128(%%rsp), %%rsp\n\tpushfq\n\torq $0x100, (%%rsp)\n\tpopfq\n\tleaq 128(%%rsp), %%rsp"
+                     ::: "memory", "cc");
+  }
+  else
+  {
+    __asm__ volatile("leaq -128(%%rsp), %%rsp\n\tpushfq\n\tandq $~0x100, (%%rsp)\n\tpopfq\n\tleaq 128(%%rsp), %%rsp"
+                     ::: "memory", "cc");
+  }
+}
+
+/**
+  * @brief  Takes pending exceptions by plain calls, from simulator functions
+  *         the firmware calls (__enable_irq(), __WFI()) or the host program.
+  * @note   Called with SIM_Busy held, released while the handler runs.
+  * @retval None
+  */
+static void SIM_Poll(void)
+{
+  int32_t exc;
+
+  while ((exc = SIM_Next()) >= 0)
+  {
+    if (exc == 15)
+    {
+      SIM_SysTickPending = 0;
+    }
+    else
+    {
+      SIM_REG((uintptr_t)&NVIC->ISPR[(exc - 16) >> 5]) &= ~(1UL << ((exc - 16) & 31));
+    }
+    SIM_Active[SIM_Depth++] = (uint8_t)exc;
+    SIM_Entries[exc]++;
+    SIM_Elapse(SIM_IRQ_CYCLES);
+    SIM_Busy--;
+    SIM_Stepping(SIM_StepCycles != 0);
+    SIM_Vector[exc]();
+    SIM_Busy++;
+    SIM_Stepping(0);
+    SIM_Depth--;
+    SIM_Elapse(SIM_IRQ_CYCLES);
+    SIM_Lines();
+  }
+}
+
+/**
+  * @brief  Most urgent exception that may preempt what is running now.
+  * @retval Exception number, -1 if none. Equal priorities go by number.
+  */
+static int32_t SIM_Next(void)
+{
+  uint32_t level, prio, exc;
+  int32_t best = -1;
+
+  if ((SIM_Primask != 0) || (SIM_Depth >= SIM_MAX_NEST))
+  {
+    return -1;
+  }
+  level = (SIM_Depth != 0) ? SIM_Priority(SIM_Active[SIM_Depth - 1]) : 256;
+  if ((SIM_SysTickPending != 0) && (SIM_Vector[15] != 0) && ((prio = SIM_Priority(15)) < level))
+  {
+    level = prio;
+    best = 15;
+  }
+  for (exc = 16; exc < SIM_EXC_NUM; exc++)
+  {
+    if ((SIM_REG((uintptr_t)&NVIC->ISPR[(exc - 16) >> 5]) & SIM_REG((uintptr_t)&NVIC->ISER[(exc - 16) >> 5]) &
+         (1UL << ((exc - 16) & 31))) && (SIM_Vector[exc] != 0) && ((prio = SIM_Priority(exc)) < level))
+    {
+      level = prio;
+      best = (int32_t)exc;
+    }
+  }
+  return best;
+}
+
+/**
+  * @brief  Priority byte of an exception, as programmed in NVIC IP or SCB SHP.
+  * @param  Exc: exception number, 4 or above.
+  * @retval 0 (most urgent) to 255.
+  */
+static uint32_t SIM_Priority(uint32_t Exc)
+{
+  if (Exc >= 16)
+  {
+    return *SIM_Alias((uintptr_t)&NVIC->IP[Exc - 16]);
+  }
+  return *SIM_Alias((uintptr_t)&SCB->SHP[Exc - 4]);
+}
+
+/**
+  * @brief  A peripheral interrupt line is high: pending unless already active,
+  *         an active one pends again on return if its line is still high.
+  * @param  Exc: exception number.
+  * @retval None
+  */
+static void SIM_Request(uint32_t Exc)
+{
+  uint32_t i;
+
+  for (i = 0; i < SIM_Depth; i++)
+  {
+    if (SIM_Active[i] == Exc)
+    {
+      return;
+    }
+  }
+  SIM_REG((uintptr_t)&NVIC->ISPR[(Exc - 16) >> 5]) |= 1UL << ((Exc - 16) & 31);
+}
+
+/**
+  * @brief  Evaluates the modelled peripheral interrupt lines.
+  * @retval None
+  */
+static void SIM_Lines(void)
+{
+  uint32_t sr = SIM_REG((uintptr_t)&ADC1->SR);
+  uint32_t cr1 = SIM_REG((uintptr_t)&ADC1->CR1);
+  uint32_t isr = SIM_REG((uintptr_t)&DMA1->ISR);
+  uint32_t ccr = SIM_REG((uintptr_t)&DMA1_Channel4->CCR);
+
+  if (((sr & ADC_SR_EOC) && (cr1 & ADC_CR1_EOCIE)) || ((sr & ADC_SR_JEOC) && (cr1 & ADC_CR1_JEOCIE)) ||
+      ((sr & ADC_SR_AWD) && (cr1 & ADC_CR1_AWDIE)) || ((sr & ADC_SR_OVR) && (cr1 & ADC_CR1_OVRIE)))
+  {
+    SIM_Request(ADC1_IRQn + 16);
+  }
+  /* Channel n TCIF, HTIF, TEIF, shifted down by 4 * (n - 1), line up with TCIE, HTIE, TEIE */
+  if (isr & SIM_REG((uintptr_t)&DMA1_Channel1->CCR) & (DMA_CCR1_TCIE | DMA_CCR1_HTIE | DMA_CCR1_TEIE))
+  {
+    SIM_Request(DMA1_Channel1_IRQn + 16);
+  }
+  if ((isr >> 12) & ccr & (DMA_CCR1_TCIE | DMA_CCR1_HTIE | DMA_CCR1_TEIE))
+  {
+    SIM_Request(DMA1_Channel4_IRQn + 16);
+  }
+}
+
+/**
+  * @brief  Lets virtual time pass and fires the model events that fall due.
+  * @param  Cycles: core cycles, 0 only fires what is already due.
+  * @retval None
+  */
+static void SIM_Elapse(uint64_t Cycles)
+{
+  uint32_t jl, n, ch, cr2;
+
+  SIM_Cycles += Cycles;
+  while (SIM_SysTickDue <= SIM_Cycles)
+  {
+    SIM_REG((uintptr_t)&SysTick->CTRL) |= SysTick_CTRL_COUNTFLAG_Msk;
+    if (SIM_REG((uintptr_t)&SysTick->CTRL) & SysTick_CTRL_TICKINT_Msk)
+    {
+      SIM_SysTickPending = 1;
+    }
+    SIM_SysTickDue += (SIM_REG((uintptr_t)&SysTick->LOAD) & SysTick_LOAD_RELOAD_Msk) + 1;
+  }
+  while (SIM_AdcDue <= SIM_Cycles)
+  {
+    ch = SIM_AdcChannel(SIM_AdcRank);
+    cr2 = SIM_REG((uintptr_t)&ADC1->CR2);
+    if (SIM_AdcRequest != 0)
+    {
+      SIM_REG((uintptr_t)&ADC1->SR) |= ADC_SR_OVR;
+    }
+    SIM_REG((uintptr_t)&ADC1->DR) = (SIM_AdcHook != 0) ? (SIM_AdcHook(ch) & 0xFFF) : SIM_AdcInput[ch];
+    SIM_REG((uintptr_t)&ADC1->SR) |= ADC_SR_EOC;
+    SIM_AdcRequest = (cr2 & ADC_CR2_DMA) ? 1 : 0;
+    /* L counts the ranks after the first */
+    SIM_AdcRank = ((SIM_REG((uintptr_t)&ADC1->CR1) & ADC_CR1_SCAN) &&
+                   (SIM_AdcRank < ((SIM_REG((uintptr_t)&ADC1->SQR1) >> 20) & 0x1F))) ? (SIM_AdcRank + 1) : 0;
+    SIM_AdcDue = ((SIM_AdcRank != 0) || (cr2 & ADC_CR2_CONT)) ?
+                 (SIM_AdcDue + SIM_AdcCycles(SIM_AdcChannel(SIM_AdcRank))) : SIM_NEVER;
+    SIM_AdcDma();
+    SIM_Lines();
+  }
+  if (SIM_AdcInjDue <= SIM_Cycles)
+  {
+    /* Ranks are right-aligned in JSQR: JL = 1 converts JSQ3, JSQ4 into JDR1, JDR2 */
+    jl = (SIM_REG((uintptr_t)&ADC1->JSQR) >> 20) & 3;
+    for (n = 0; n <= jl; n++)
+    {
+      ch = (SIM_REG((uintptr_t)&ADC1->JSQR) >> (5 * (3 - jl + n))) & 0x1F;
+      SIM_REG((uintptr_t)&ADC1->JDR1 + 4 * n) = SIM_AdcInput[ch];
+    }
+    SIM_REG((uintptr_t)&ADC1->SR) |= ADC_SR_JEOC;
+    SIM_AdcInjDue = SIM_NEVER;
+    SIM_Lines();
+  }
+  if (SIM_UsartDue <= SIM_Cycles)
+  {
+    SIM_Usart();
+  }
+}
+
+/**
+  * @brief  Time of the next model event.
+  * @retval Virtual cycles, SIM_NEVER if nothing is scheduled.
+  */
+static uint64_t SIM_NextEvent(void)
+{
+  uint64_t due = SIM_SysTickDue;
+
+  due = (SIM_AdcDue < due) ? SIM_AdcDue : due;
+  due = (SIM_AdcInjDue < due) ? SIM_AdcInjDue : due;
+  due = (SIM_UsartDue < due) ? SIM_UsartDue : due;
+  return due;
+}
+
+/**
+  * @brief  Conversion time of an ADC channel: programmed sample time plus 12
+  *         cycles, counted as core cycles (core and ADC both on HSI).
+  * @param  Channel: 0 to 31.
+  * @retval Cycles.
+  */
+static uint32_t SIM_AdcCycles(uint32_t Channel)
+{
+  static const uint16_t smp[8] = {4, 9, 16, 24, 48, 96, 192, 384};
+  uint32_t smpr;
+
+  if (Channel > 29)
+  {
+    smpr = SIM_REG((uintptr_t)&ADC1->SMPR0) >> (3 * (Channel - 30));
+  }
+  else if (Channel > 19)
+  {
+    smpr = SIM_REG((uintptr_t)&ADC1->SMPR1) >> (3 * (Channel - 20));
+  }
+  else if (Channel > 9)
+  {
+    smpr = SIM_REG((uintptr_t)&ADC1->SMPR2) >> (3 * (Channel - 10));
+  }
+  else
+  {
+    smpr = SIM_REG((uintptr_t)&ADC1->SMPR3) >> (3 * Channel);
+  }
+  return smp[smpr & 7] + SIM_ADC_CONV_CYCLES;
+}
+
+/**
+  * @brief  Channel of a regular rank: SQR5 holds ranks 1 to 6, SQR4 7 to 12,
+  *         and so on down to SQR1.
+  * @param  Rank: 0 for the first rank.
+  * @retval Channel, 0 to 31.
+  */
+static uint32_t SIM_AdcChannel(uint32_t Rank)
+{
+  return (SIM_REG((uintptr_t)&ADC1->SQR5 - 4 * (Rank / 6)) >> (5 * (Rank % 6))) & 0x1F;
+}
+
+/**
+  * @brief  DMA1 channel 1: moves DR to memory if ADC1 has a request waiting
+  *         and the channel is enabled.
+  * @retval None
+  */
+static void SIM_AdcDma(void)
+{
+  uint32_t ccr = SIM_REG((uintptr_t)&DMA1_Channel1->CCR);
+  uint32_t cndtr = SIM_REG((uintptr_t)&DMA1_Channel1->CNDTR) & 0xFFFF;
+  uint32_t data;
+
+  if ((SIM_AdcRequest == 0) || !(ccr & DMA_CCR1_EN) || (cndtr == 0) ||
+      (SIM_REG((uintptr_t)&ADC1->SR) & ADC_SR_OVR))
+  {
+    return;
+  }
+  SIM_AdcRequest = 0;
+  /* The DMA read clears EOC, as a CPU read does */
+  data = SIM_REG((uintptr_t)&ADC1->DR);
+  SIM_REG((uintptr_t)&ADC1->SR) &= ~ADC_SR_EOC;
+  if ((ccr & DMA_CCR1_MSIZE) == DMA_CCR1_MSIZE_1)
+  {
+    *(uint32_t*)SIM_Dma1Addr = data;
+  }
+  else if ((ccr & DMA_CCR1_MSIZE) == DMA_CCR1_MSIZE_0)
+  {
+    *(uint16_t*)SIM_Dma1Addr = (uint16_t)data;
+  }
+  else
+  {
+    *(uint8_t*)SIM_Dma1Addr = (uint8_t)data;
+  }
+  if (ccr & DMA_CCR1_MINC)
+  {
+    SIM_Dma1Addr += 1UL << ((ccr & DMA_CCR1_MSIZE) >> 10);
+  }
+  cndtr--;
+  if (cndtr == 0)
+  {
+    SIM_REG((uintptr_t)&DMA1->ISR) |= DMA_ISR_GIF1 | DMA_ISR_TCIF1;
+    if (ccr & DMA_CCR1_CIRC)
+    {
+      cndtr = SIM_Dma1Count;
+      SIM_Dma1Addr = SIM_REG((uintptr_t)&DMA1_Channel1->CMAR);
+    }
+  }
+  else if (cndtr == SIM_Dma1Count / 2)
+  {
+    SIM_REG((uintptr_t)&DMA1->ISR) |= DMA_ISR_GIF1 | DMA_ISR_HTIF1;
+  }
+  SIM_REG((uintptr_t)&DMA1_Channel1->CNDTR) = cndtr;
+}
+
+/**
+  * @brief  Register models: side effects of a read.
+  * @param  Addr: word address.
+  * @retval None
+  */
+static void SIM_Read(uintptr_t Addr)
+{
+  if (Addr == (uintptr_t)&ADC1->DR)
+  {
+    SIM_REG((uintptr_t)&ADC1->SR) &= ~ADC_SR_EOC;
+  }
+}
+
+/**
+  * @brief  Register models: side effects of a write.
+  * @param  Addr: word address.
+  * @param  Old: word before the write.
+  * @param  New: word as written.
+  * @retval None
+  */
+static void SIM_Write(uintptr_t Addr, uint32_t Old, uint32_t New)
+{
+  uint32_t port, odr, n;
+
+  if (Addr == (uintptr_t)&RCC->CR)
+  {
+    /* Oscillators are ready as soon as they are on */
+    New &= ~(RCC_CR_HSIRDY | RCC_CR_MSIRDY | RCC_CR_HSERDY | RCC_CR_PLLRDY);
+    SIM_REG(Addr) = New | ((New & (RCC_CR_HSION | RCC_CR_MSION | RCC_CR_HSEON | RCC_CR_PLLON)) << 1);
+  }
+  else if (Addr == (uintptr_t)&RCC->CFGR)
+  {
+    SIM_REG(Addr) = (New & ~RCC_CFGR_SWS) | ((New & RCC_CFGR_SW) << 2);
+  }
+  else if (Addr == (uintptr_t)&ADC1->SR)
+  {
+    SIM_REG(Addr) = Old & New;
+    SIM_AdcDma();
+  }
+  else if (Addr == (uintptr_t)&ADC1->CR2)
+  {
+    SIM_REG(Addr) = New & ~(ADC_CR2_SWSTART | ADC_CR2_JSWSTART);
+    SIM_REG((uintptr_t)&ADC1->SR) = (SIM_REG((uintptr_t)&ADC1->SR) & ~ADC_SR_ADONS) |
+                                    ((New & ADC_CR2_ADON) ? ADC_SR_ADONS : 0);
+    if (!(New & ADC_CR2_ADON))
+    {
+      SIM_AdcDue = SIM_NEVER;
+      SIM_AdcInjDue = SIM_NEVER;
+    }
+    else
+    {
+      if ((New & ADC_CR2_SWSTART) && (SIM_AdcDue == SIM_NEVER))
+      {
+        SIM_REG((uintptr_t)&ADC1->SR) |= ADC_SR_STRT;
+        SIM_AdcRank = 0;
+        SIM_AdcDue = SIM_Cycles + SIM_AdcCycles(SIM_AdcChannel(0));
+      }
+      if ((New & ADC_CR2_JSWSTART) && (SIM_AdcInjDue == SIM_NEVER))
+      {
+        SIM_REG((uintptr_t)&ADC1->SR) |= ADC_SR_JSTRT;
+        SIM_AdcInjDue = SIM_Cycles;
+        for (n = 0; n <= ((SIM_REG((uintptr_t)&ADC1->JSQR) >> 20) & 3); n++)
+        {
+          SIM_AdcInjDue += SIM_AdcCycles((SIM_REG((uintptr_t)&ADC1->JSQR) >> (5 * (3 - n))) & 0x1F);
+        }
+      }
+    }
+  }
+  else if ((Addr == (uintptr_t)&SysTick->CTRL) || (Addr == (uintptr_t)&SysTick->VAL))
+  {
+    if (Addr == (uintptr_t)&SysTick->VAL)
+    {
+      /* Any write clears the counter and COUNTFLAG, the next clock reloads */
+      SIM_REG(Addr) = 0;
+      SIM_REG((uintptr_t)&SysTick->CTRL) &= ~SysTick_CTRL_COUNTFLAG_Msk;
+    }
+    if (!(SIM_REG((uintptr_t)&SysTick->CTRL) & SysTick_CTRL_ENABLE_Msk) ||
+        ((SIM_REG((uintptr_t)&SysTick->LOAD) & SysTick_LOAD_RELOAD_Msk) == 0))
+    {
+      SIM_SysTickDue = SIM_NEVER;
+    }
+    else if ((Addr == (uintptr_t)&SysTick->VAL) || !(Old & SysTick_CTRL_ENABLE_Msk))
+    {
+      SIM_SysTickDue = SIM_Cycles + (SIM_REG((uintptr_t)&SysTick->LOAD) & SysTick_LOAD_RELOAD_Msk) + 1;
+    }
+  }
+  else if ((Addr >= (uintptr_t)&NVIC->ISER[0]) && (Addr < (uintptr_t)&NVIC->IABR[0]))
+  {
+    /* Write 1 to set or clear: enables live in ISER, pendings in ISPR, the
+       clear registers read back the same */
+    n = (uint32_t)((Addr - (uintptr_t)&NVIC->ISER[0]) & 0x1F);
+    switch ((Addr - (uintptr_t)&NVIC->ISER[0]) >> 7)
+    {
+      case 0:
+        SIM_REG(Addr) = Old | New;
+        break;
+      case 1:
+        SIM_REG((uintptr_t)&NVIC->ISER[0] + n) &= ~New;
+        break;
+      case 2:
+        SIM_REG(Addr) = Old | New;
+        break;
+      default:
+        SIM_REG((uintptr_t)&NVIC->ISPR[0] + n) &= ~New;
+        break;
+    }
+    SIM_REG((uintptr_t)&NVIC->ICER[0] + n) = SIM_REG((uintptr_t)&NVIC->ISER[0] + n);
+    SIM_REG((uintptr_t)&NVIC->ICPR[0] + n) = SIM_REG((uintptr_t)&NVIC->ISPR[0] + n);
+  }
+  else if (Addr == (uintptr_t)&CRC->DR)
+  {
+    SIM_REG(Addr) = SIM_Crc32(Old, New);
+  }
+  else if (Addr == (uintptr_t)&CRC->CR)
+  {
+    /* RESET reads as 0 */
+    SIM_REG(Addr) = 0;
+    if (New & CRC_CR_RESET)
+    {
+      SIM_REG((uintptr_t)&CRC->DR) = 0xFFFFFFFF;
+    }
+  }
+  else if (Addr == (uintptr_t)&DMA1->IFCR)
+  {
+    /* Write 1 to clear, GL clears the whole channel; GL stays set while any flag is */
+    odr = SIM_REG((uintptr_t)&DMA1->ISR);
+    for (n = 0; n < 7; n++)
+    {
+      if (New & (1UL << (4 * n)))
+      {
+        New |= 0xFUL << (4 * n);
+      }
+    }
+    odr &= ~New;
+    for (n = 0; n < 7; n++)
+    {
+      if ((odr & (0xEUL << (4 * n))) == 0)
+      {
+        odr &= ~(1UL << (4 * n));
+      }
+    }
+    SIM_REG((uintptr_t)&DMA1->ISR) = odr;
+    SIM_REG(Addr) = 0;
+  }
+  else if (Addr == (uintptr_t)&DMA1_Channel1->CCR)
+  {
+    if ((New & DMA_CCR1_EN) && !(Old & DMA_CCR1_EN))
+    {
+      SIM_Dma1Addr = SIM_REG((uintptr_t)&DMA1_Channel1->CMAR);
+      SIM_Dma1Count = SIM_REG((uintptr_t)&DMA1_Channel1->CNDTR) & 0xFFFF;
+    }
+    SIM_AdcDma();
+  }
+  else if (Addr == (uintptr_t)&DMA1_Channel4->CCR)
+  {
+    if ((New & DMA_CCR1_EN) && !(Old & DMA_CCR1_EN))
+    {
+      SIM_DmaAddr = SIM_REG((uintptr_t)&DMA1_Channel4->CMAR);
+      SIM_DmaCount = SIM_REG((uintptr_t)&DMA1_Channel4->CNDTR) & 0xFFFF;
+    }
+    SIM_Usart();
+  }
+  else if ((Addr == (uintptr_t)&DMA1_Channel1->CNDTR) || (Addr == (uintptr_t)&DMA1_Channel4->CNDTR))
+  {
+    if (SIM_REG(Addr - 4) & DMA_CCR1_EN)
+    {
+      /* Read-only while the channel is enabled */
+      SIM_REG(Addr) = Old;
+    }
+  }
+  else if (Addr == (uintptr_t)&USART1->DR)
+  {
+    SIM_UsartTdr = 1;
+    SIM_UsartTdrByte = (uint8_t)New;
+    SIM_REG((uintptr_t)&USART1->SR) &= ~(USART_SR_TXE | USART_SR_TC);
+    SIM_Usart();
+  }
+  else if ((Addr == (uintptr_t)&USART1->CR1) || (Addr == (uintptr_t)&USART1->CR3))
+  {
+    SIM_Usart();
+  }
+  else if ((Addr == (uintptr_t)&TIM3->EGR) || (Addr == (uintptr_t)&TIM4->EGR))
+  {
+    SIM_REG(Addr) = 0;
+  }
+  else if ((Addr >= GPIOA_BASE) && (Addr < GPIOA_BASE + SIM_GPIO_PORTS * SIM_GPIO_STRIDE))
+  {
+    port = (uint32_t)((Addr - GPIOA_BASE) / SIM_GPIO_STRIDE);
+    switch (Addr & (SIM_GPIO_STRIDE - 1))
+    {
+      case 0x14:
+        /* ODR */
+        SIM_GpioChange(port, Old, New & 0xFFFF);
+        SIM_REG(Addr) = New & 0xFFFF;
+        break;
+      case 0x18:
+        /* BSRR: reads as 0, set wins over reset */
+        odr = SIM_REG(Addr - 4);
+        SIM_REG(Addr - 4) = (odr & ~(New >> 16)) | (New & 0xFFFF);
+        SIM_REG(Addr) = 0;
+        SIM_GpioChange(port, odr, SIM_REG(Addr - 4));
+        break;
+      default:
+        break;
+    }
+  }
+  SIM_Lines();
+}
+
+/**
+  * @brief  Records an output change of a port.
+  * @param  Port: 0 for GPIOA, ...
+  * @param  Old: ODR before.
+  * @param  New: ODR after.
+  * @retval None
+  */
+static void SIM_GpioChange(uint32_t Port, uint32_t Old, uint32_t New)
+{
+  if (Old == New)
+  {
+    return;
+  }
+  if (SIM_NumEdges < SIM_MAX_EDGES)
+  {
+    SIM_Edge[SIM_NumEdges].Cycles = SIM_Cycles;
+    SIM_Edge[SIM_NumEdges].Odr = (uint16_t)New;
+    SIM_Edge[SIM_NumEdges].Port = (uint8_t)Port;
+  }
+  SIM_NumEdges++;
+}
+
+/**
+  * @brief  USART1 and DMA1 channel 4: serves DMA requests while TXE, and
+  *         moves TDR into the shift register each time it empties. Raises
+  *         the channel interrupt line for the flags set.
+  * @retval None
+  */
+static void SIM_Usart(void)
+{
+  uint32_t ccr, cndtr;
+
+  for (;;)
+  {
+    ccr = SIM_REG((uintptr_t)&DMA1_Channel4->CCR);
+    cndtr = SIM_REG((uintptr_t)&DMA1_Channel4->CNDTR) & 0xFFFF;
+    while ((SIM_UsartTdr == 0) && (ccr & DMA_CCR1_EN) && (cndtr != 0) &&
+           (SIM_REG((uintptr_t)&USART1->CR3) & USART_CR3_DMAT) &&
+           ((SIM_REG((uintptr_t)&USART1->CR1) & (USART_CR1_UE | USART_CR1_TE)) == (USART_CR1_UE | USART_CR1_TE)))
+    {
+      /* One request: a byte from memory into TDR */
+      SIM_UsartTdr = 1;
+      SIM_UsartTdrByte = *(const uint8_t*)SIM_DmaAddr;
+      SIM_REG((uintptr_t)&USART1->SR) &= ~(USART_SR_TXE | USART_SR_TC);
+      if (ccr & DMA_CCR1_MINC)
+      {
+        SIM_DmaAddr++;
+      }
+      SIM_REG((uintptr_t)&DMA1_Channel4->CNDTR) = --cndtr;
+      if (cndtr == 0)
+      {
+        SIM_REG((uintptr_t)&DMA1->ISR) |= DMA_ISR_GIF4 | DMA_ISR_TCIF4;
+      }
+      else if (cndtr == SIM_DmaCount / 2)
+      {
+        SIM_REG((uintptr_t)&DMA1->ISR) |= DMA_ISR_GIF4 | DMA_ISR_HTIF4;
+      }
+      if (SIM_UsartDue == SIM_NEVER)
+      {
+        /* Idle line: straight into the shift register */
+        SIM_UsartTdr = 0;
+        SIM_UsartShift(SIM_UsartTdrByte, SIM_Cycles);
+      }
+    }
+    if ((SIM_UsartDue == SIM_NEVER) || (SIM_UsartDue > SIM_Cycles))
+    {
+      break;
+    }
+    SIM_UsartLast = SIM_UsartDue;
+    SIM_UsartDue = SIM_NEVER;
+    if (SIM_UsartTdr != 0)
+    {
+      SIM_UsartTdr = 0;
+      SIM_UsartShift(SIM_UsartTdrByte, SIM_UsartLast);
+    }
+    else
+    {
+      SIM_REG((uintptr_t)&USART1->SR) |= USART_SR_TC;
+    }
+  }
+  SIM_Lines();
+}
+
+/**
+  * @brief  Starts a byte on the line; TDR is free again.
+  * @param  Byte: the byte.
+  * @param  Start: cycle of the start bit.
+  * @retval None
+  */
+static void SIM_UsartShift(uint8_t Byte, uint64_t Start)
+{
+  static const uint8_t shift[8] = {0, 0, 0, 0, 1, 2, 3, 4};
+  uint32_t brr = SIM_REG((uintptr_t)&USART1->BRR) & 0xFFFF;
+
+  if (SIM_UsartBytes < SIM_UsartOutSize)
+  {
+    SIM_UsartOut[SIM_UsartBytes] = Byte;
+  }
+  if (SIM_UsartBytes == 0)
+  {
+    SIM_UsartFirst = Start;
+  }
+  SIM_UsartBytes++;
+  /* 8N1, oversampling by 16: a bit is BRR clocks of APB2 */
+  SIM_UsartDue = Start + (((uint64_t)10 * ((brr != 0) ? brr : 1)) << shift[(SIM_REG((uintptr_t)&RCC->CFGR) >> 11) & 7]);
+  SIM_REG((uintptr_t)&USART1->SR) |= USART_SR_TXE;
+}
+
+/**
+  * @brief  One word through the CRC unit: polynomial 0x04C11DB7, MSB first.
+  * @param  Crc: data register before the write.
+  * @param  Data: word written.
+  * @retval Data register after the write.
+  */
+static uint32_t SIM_Crc32(uint32_t Crc, uint32_t Data)
+{
+  uint32_t bit;
+
+  Crc ^= Data;
+  for (bit = 0; bit < 32; bit++)
+  {
+    Crc = (Crc & 0x80000000UL) ? ((Crc << 1) ^ 0x04C11DB7UL) : (Crc << 1);
+  }
+  return Crc;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,104 @@
+/**
+ * @file    nc_sim.h
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Host simulator of the STM32L1 peripherals
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+ /* Define to prevent recursive inclusion -- */
+#ifndef NC_SIM_H
+#define NC_SIM_H 100
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif /* NC_SIM_H */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32l1xx.h"
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+  * @brief  One recorded output change of a GPIO port.
+  */
+typedef struct
+{
+  uint64_t Cycles;            /*!< Virtual time of the change */
+  uint16_t Odr;               /*!< ODR after the change */
+  uint8_t Port;               /*!< 0 for GPIOA, 1 for GPIOB, ... */
+}SIM_EdgeTypeDef;
+
+/**
+  * @brief  One traced register access.
+  */
+typedef struct
+{
+  uint64_t Cycles;            /*!< Virtual time of the access */
+  uintptr_t Pc;               /*!< Host address of the accessing instruction */
+  uint32_t Addr;              /*!< Word address */
+  uint32_t Old;               /*!< Word before the access */
+  uint32_t New;               /*!< Word as written, or as read */
+  uint8_t Write;
+}SIM_AccessTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+#define SIM_ACCESS_CYCLES             2       /*!< Virtual cycles per register access */
+#define SIM_MAX_EDGES                 65536   /*!< GPIO changes kept, later ones are counted only */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void SIM_Init(uint32_t CoreClock);
+void SIM_Reset(void);
+uint64_t SIM_GetCycles(void);
+void SIM_Advance(uint32_t Cycles);
+void SIM_SetVector(IRQn_Type IRQn, void (*pHandler)(void));
+uint32_t SIM_GetIrqCount(IRQn_Type IRQn);
+void SIM_SetAdcInput(uint32_t Channel, uint16_t Code);
+void SIM_SetAdcHook(uint16_t (*pHook)(uint32_t Channel));
+void SIM_SetUsartTx(uint8_t* pBuffer, uint32_t Size);
+uint32_t SIM_GetUsartTx(uint64_t* pFirst, uint64_t* pLast);
+int32_t SIM_Run(void (*pFunc)(void), uint32_t CyclesPerInstr, uint64_t Cycles);
+uint32_t SIM_Peek(volatile void* pReg);
+void SIM_Poke(volatile void* pReg, uint32_t Value);
+uint32_t SIM_GetEdges(const SIM_EdgeTypeDef** ppEdges);
+int32_t SIM_VcdWrite(const char* pPath, GPIO_TypeDef* GPIOx, const char* const* ppNames);
+void SIM_TraceStart(SIM_AccessTypeDef* pBuffer, uint32_t Size);
+uint32_t SIM_TraceStop(void);
+const char* SIM_RegName(uint32_t Addr, char* pBuf, uint32_t Size);
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NC_SIM_H */
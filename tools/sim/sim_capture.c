@@ -0,0 +1,454 @@
+/**
+ * @file    tools/sim/sim_capture.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Capture engine and ADC1 stream on nc_sim: triggers, wrap, missed windows
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/*
+ * Runs the oscilloscope capture engine (nc_capture) and the ADC1 stream
+ * handler of nc_stm32l1_dma against the nc_sim model of ADC1 scanning three
+ * ranks into DMA1_Channel1. From the repository root:
+ *
+ *   cc -O2 -no-pie -DSTM32L1XX_MD -Itools/sim -I. -o sim_capture \
+ *      tools/sim/sim_capture.c tools/sim/nc_sim.c nc_capture.c nc_pack12.c \
+ *      nc_stm32l1_adc.c nc_stm32l1_dma.c nc_stm32l1_rcc.c
+ *   ./sim_capture
+ *
+ * Conversion n converts to n % 4095, so every sample tells its position in
+ * the stream and, since 4095 is a multiple of the scan length, its rank.
+ * Each frozen record must hold Pre samples and the post-trigger run, rounded
+ * up to a whole scan, with no gap from Start, the first conversion after
+ * CAP_Trigger() at Trigger, and sample i of the buffer from rank i % 3.
+ * Buffers start filled with 0xFFFF, which no conversion gives: after an early
+ * trigger everything outside the window must still hold it.
+ *
+ * Capture cases: a trigger mid-buffer; one near the end, so the post-trigger
+ * run wraps to the start of the buffer; one while the ring's TC is pending
+ * with interrupts masked; one before the ring has filled, Pre less than
+ * asked; and with both buffers held, a Missed trigger, then CAP_Release()
+ * restarting the engine. ADC OVR must stay clear while a buffer is armed.
+ *
+ * Stream case: the half and full callbacks must alternate and hand out the
+ * samples without a gap, also when the handler runs late and finds HT and TC
+ * both set.
+ *
+ * The exit status is 1 on any mismatch.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "nc_sim.h"
+#include "nc_capture.h"
+#include "nc_stm32l1_adc.h"
+#include "nc_stm32l1_dma.h"
+#include "nc_stm32l1_rcc.h"
+
+/* Private define ------------------------------------------------------------*/
+#define SIM_CAP_CLOCK             32000000UL
+#define SIM_CAP_RANKS             3
+#define SIM_CAP_CONV              (96 + 12)   /* Cycles per conversion: sample time plus 12 */
+#define SIM_CAP_LENGTH            60          /* Samples per buffer, 20 scans */
+#define SIM_CAP_CODES             4095        /* Conversion n gives n % 4095 */
+#define SIM_CAP_EMPTY             0xFFFF
+#define SIM_CAP_FULL              0xFFFF      /* Expected Pre: all the ring keeps */
+#define SIM_CAP_STREAM            60
+#define SIM_CAP_BLOCKS            10
+
+/* Private variables ---------------------------------------------------------*/
+static const uint8_t Channel[SIM_CAP_RANKS] = {ADC_Channel_1, ADC_Channel_2, ADC_Channel_3};
+static uint16_t Buffer[CAP_POOL_SIZE][SIM_CAP_LENGTH];
+static uint16_t* const Pool[CAP_POOL_SIZE] = {Buffer[0], Buffer[1], Buffer[2], Buffer[3]};
+static uint16_t Stream[SIM_CAP_STREAM];
+static CAP_EngineTypeDef Cap;
+static void (*Handler)(void);
+static uint32_t Converted;                    /* Conversions so far, the next one's number */
+static uint32_t RankErrors;
+static uint32_t Blocks;                       /* Stream blocks handed out */
+static uint32_t StreamErrors;
+
+/* Private function prototypes -----------------------------------------------*/
+void DMA1_Channel1_IRQHandler(void);
+static void CaptureIRQ(void);
+static uint16_t Convert(uint32_t Ch);
+static void AdcStart(void);
+static void Setup(uint8_t NumBuffers, uint16_t Post);
+static void Until(uint32_t Pos);
+static uint32_t Fire(void);
+static uint32_t Verify(const char* pName, uint32_t Triggered, uint32_t Pre, uint32_t Early);
+static uint32_t Check(const char* pName, const CAP_RecordTypeDef* pRecord, uint32_t Triggered, uint32_t Pre, uint32_t Early);
+static uint32_t Overrun(const char* pName);
+static void StreamBlock(uint16_t* pBlock, uint32_t Count);
+static uint32_t CheckStream(void);
+
+/* Private functions ---------------------------------------------------------*/
+
+int main(void)
+{
+  CAP_RecordTypeDef r[2];
+  uint32_t t[2];
+  uint32_t errors = 0;
+
+  SIM_Init(SIM_CAP_CLOCK);
+  SIM_SetVector(DMA1_Channel1_IRQn, DMA1_Channel1_IRQHandler);
+  SIM_SetAdcHook(Convert);
+
+  /* Mid-buffer, once the ring has wrapped */
+  Setup(3, 30);
+  SIM_Advance(2 * SIM_CAP_LENGTH * SIM_CAP_CONV);
+  Until(20);
+  errors += Verify("mid", Fire(), SIM_CAP_FULL, 0);
+
+  /* Near the end: 51 + 30 wraps past 60 */
+  Setup(3, 30);
+  SIM_Advance(2 * SIM_CAP_LENGTH * SIM_CAP_CONV);
+  Until(SIM_CAP_LENGTH - 9);
+  errors += Verify("wrap", Fire(), SIM_CAP_FULL, 0);
+
+  /* First wrap not yet seen by the interrupt: the ring is full all the same */
+  Setup(3, 30);
+  __disable_irq();
+  while (!(SIM_Peek(&DMA1->ISR) & DMA_ISR_TCIF1))
+  {
+    SIM_Advance(1);
+  }
+  Until(2);
+  t[0] = Fire();
+  __enable_irq();
+  errors += Verify("tc pending", t[0], SIM_CAP_FULL, 0);
+
+  /* Early: 7 samples since CAP_Start(), 7 + 12 rounded up to 21 */
+  Setup(3, 12);
+  Until(7);
+  errors += Verify("early", Fire(), 7, 1);
+
+  /* Both buffers held: the engine idles without the ADC overrunning, counts
+     a Missed trigger, and runs again in step with the scan once one is
+     released */
+  Setup(2, 30);
+  SIM_Advance(2 * SIM_CAP_LENGTH * SIM_CAP_CONV);
+  t[0] = Fire();
+  SIM_Advance(31 * SIM_CAP_CONV);
+  SIM_Advance(2 * SIM_CAP_LENGTH * SIM_CAP_CONV);
+  t[1] = Fire();
+  SIM_Advance(41 * SIM_CAP_CONV);
+  errors += Overrun("held");
+  if ((Cap.State != CAP_STATE_IDLE) || (CAP_Trigger(&Cap) != 0) || (Cap.Missed != 1) ||
+      (CAP_GetCapture(&Cap, &r[0]) != 1) || (CAP_GetCapture(&Cap, &r[1]) != 1))
+  {
+    printf("held       state %u missed %u\n", (unsigned)Cap.State, (unsigned)Cap.Missed);
+    errors++;
+  }
+  else
+  {
+    errors += Check("held 0", &r[0], t[0], SIM_CAP_FULL, 0);
+    errors += Check("held 1", &r[1], t[1], SIM_CAP_FULL, 0);
+    CAP_Release(&Cap, &r[0]);
+    SIM_Advance(2 * SIM_CAP_LENGTH * SIM_CAP_CONV);
+    if (Cap.State != CAP_STATE_ARMED)
+    {
+      printf("restart    state %u\n", (unsigned)Cap.State);
+      errors++;
+    }
+    errors += Verify("restart", Fire(), SIM_CAP_FULL, 0);
+  }
+
+  errors += CheckStream();
+  printf("%s\n", (errors == 0) ? "as expected" : "MISMATCH");
+  return (errors == 0) ? 0 : 1;
+}
+
+/**
+  * @brief  The vector: capture engine or ADC1 stream, whichever runs.
+  * @retval None
+  */
+void DMA1_Channel1_IRQHandler(void)
+{
+  Handler();
+}
+
+/**
+  * @brief  Capture mode DMA interrupt.
+  * @retval None
+  */
+static void CaptureIRQ(void)
+{
+  CAP_DMAIRQHandler(&Cap);
+}
+
+/**
+  * @brief  ADC hook: numbers the conversions and checks the scan order.
+  * @param  Ch: channel being converted.
+  * @retval Code of the conversion.
+  */
+static uint16_t Convert(uint32_t Ch)
+{
+  if (Ch != Channel[Converted % SIM_CAP_RANKS])
+  {
+    RankErrors++;
+  }
+  return (uint16_t)(Converted++ % SIM_CAP_CODES);
+}
+
+/**
+  * @brief  ADC1 scanning the three ranks continuously, one DMA request per
+  *         conversion.
+  * @retval None
+  */
+static void AdcStart(void)
+{
+  ADC_InitTypeDef ADC_InitStructure;
+  uint32_t r;
+
+  RCC_APB2PeriphClockCmd(RCC_APB2Periph_ADC1, ENABLE);
+  ADC_StructInit(&ADC_InitStructure);
+  ADC_InitStructure.ADC_ScanConvMode = ENABLE;
+  ADC_InitStructure.ADC_ContinuousConvMode = ENABLE;
+  ADC_InitStructure.ADC_NbrOfConversion = SIM_CAP_RANKS;
+  ADC_Init(ADC1, &ADC_InitStructure);
+  /* Ranks 1..3 in SQR5, 96-cycle sample time in SMPR3 */
+  ADC1->SQR5 = 0;
+  for (r = 0; r < SIM_CAP_RANKS; r++)
+  {
+    ADC1->SQR5 |= (uint32_t)Channel[r] << (5 * r);
+    ADC1->SMPR3 |= (uint32_t)ADC_SampleTime_96Cycles << (3 * Channel[r]);
+  }
+  ADC1->CR2 |= ADC_CR2_DMA | ADC_CR2_DDS;
+  ADC_Cmd(ADC1, ENABLE);
+  ADC1->CR2 |= ADC_CR2_SWSTART;
+}
+
+/**
+  * @brief  Fresh engine on empty buffers, then the ADC started.
+  * @param  NumBuffers: buffers in the pool.
+  * @param  Post: post-trigger samples.
+  * @retval None
+  */
+static void Setup(uint8_t NumBuffers, uint16_t Post)
+{
+  uint32_t n, i;
+
+  SIM_Reset();
+  Converted = 0;
+  for (n = 0; n < CAP_POOL_SIZE; n++)
+  {
+    for (i = 0; i < SIM_CAP_LENGTH; i++)
+    {
+      Buffer[n][i] = SIM_CAP_EMPTY;
+    }
+  }
+  if (CAP_Init(&Cap, Pool, NumBuffers, SIM_CAP_LENGTH, Post, SIM_CAP_RANKS) != 0)
+  {
+    printf("CAP_Init rejected %u buffers, Post %u\n", (unsigned)NumBuffers, (unsigned)Post);
+  }
+  Handler = CaptureIRQ;
+  NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+  CAP_Start(&Cap);
+  AdcStart();
+}
+
+/**
+  * @brief  Lets time pass until the DMA is about to write a given index.
+  * @param  Pos: buffer index.
+  * @retval None
+  */
+static void Until(uint32_t Pos)
+{
+  while ((SIM_CAP_LENGTH - SIM_Peek(&DMA1_Channel1->CNDTR)) % SIM_CAP_LENGTH != Pos)
+  {
+    SIM_Advance(1);
+  }
+}
+
+/**
+  * @brief  Triggers and lets the post-trigger run complete.
+  * @retval Number of the first conversion after the trigger, ~0 if rejected.
+  */
+static uint32_t Fire(void)
+{
+  uint32_t n = Converted;
+
+  if (CAP_Trigger(&Cap) == 0)
+  {
+    return 0xFFFFFFFFUL;
+  }
+  if (!__get_PRIMASK())
+  {
+    SIM_Advance((Cap.Post + SIM_CAP_RANKS) * SIM_CAP_CONV);
+  }
+  return n;
+}
+
+/**
+  * @brief  Lets a masked post-trigger run complete, then takes, checks and
+  *         releases its record.
+  * @param  pName: case.
+  * @param  Triggered: from Fire().
+  * @param  Pre: expected pre-trigger samples, SIM_CAP_FULL for all the ring keeps.
+  * @param  Early: 1 if the buffer was never filled.
+  * @retval Number of failed checks.
+  */
+static uint32_t Verify(const char* pName, uint32_t Triggered, uint32_t Pre, uint32_t Early)
+{
+  CAP_RecordTypeDef r;
+  uint32_t errors;
+
+  SIM_Advance((Cap.Post + SIM_CAP_RANKS) * SIM_CAP_CONV);
+  errors = Overrun(pName);
+  if ((Triggered == 0xFFFFFFFFUL) || (CAP_GetCapture(&Cap, &r) != 1))
+  {
+    printf("%-10s no capture\n", pName);
+    return errors + 1;
+  }
+  errors += Check(pName, &r, Triggered, Pre, Early);
+  CAP_Release(&Cap, &r);
+  return errors;
+}
+
+/**
+  * @brief  One record against the conversion numbers.
+  * @param  pName: case.
+  * @param  pRecord: record from CAP_GetCapture().
+  * @param  Triggered: number of the first conversion after the trigger.
+  * @param  Pre: expected pre-trigger samples, SIM_CAP_FULL for all the ring keeps.
+  * @param  Early: 1 if samples outside the window were never written.
+  * @retval Number of failed checks.
+  */
+static uint32_t Check(const char* pName, const CAP_RecordTypeDef* pRecord, uint32_t Triggered, uint32_t Pre, uint32_t Early)
+{
+  uint32_t post, window, i, idx, want, bad = 0;
+
+  post = Cap.Post + (SIM_CAP_RANKS - (pRecord->Trigger + Cap.Post) % SIM_CAP_RANKS) % SIM_CAP_RANKS;
+  window = pRecord->Pre + post;
+  Pre = (Pre == SIM_CAP_FULL) ? (SIM_CAP_LENGTH - post) : Pre;
+  if ((pRecord->Pre != Pre) || (window > SIM_CAP_LENGTH) ||
+      (pRecord->Start != (pRecord->Trigger + SIM_CAP_LENGTH - pRecord->Pre) % SIM_CAP_LENGTH) ||
+      (pRecord->pBuffer[pRecord->Trigger] != Triggered % SIM_CAP_CODES))
+  {
+    bad++;
+  }
+  for (i = 0; (bad == 0) && (i < SIM_CAP_LENGTH); i++)
+  {
+    idx = (pRecord->Start + i) % SIM_CAP_LENGTH;
+    want = (i < window) ? ((Triggered + SIM_CAP_CODES - pRecord->Pre + i) % SIM_CAP_CODES) : SIM_CAP_EMPTY;
+    if ((i < window) || Early)
+    {
+      bad += (pRecord->pBuffer[idx] != want) || ((i < window) && ((want % SIM_CAP_RANKS) != (idx % SIM_CAP_RANKS)));
+    }
+  }
+  bad += RankErrors;
+  printf("%-10s Start %2u Trigger %2u Pre %2u post %2u  %s\n", pName, (unsigned)pRecord->Start,
+         (unsigned)pRecord->Trigger, (unsigned)pRecord->Pre, (unsigned)post, (bad == 0) ? "ok" : "MISMATCH");
+  return (bad != 0) ? 1 : 0;
+}
+
+/**
+  * @brief  ADC OVR: a conversion was lost for want of a DMA transfer.
+  * @param  pName: case.
+  * @retval 1 if OVR is set.
+  */
+static uint32_t Overrun(const char* pName)
+{
+  if (SIM_Peek(&ADC1->SR) & ADC_SR_OVR)
+  {
+    printf("%-10s ADC overrun\n", pName);
+    return 1;
+  }
+  return 0;
+}
+
+/**
+  * @brief  Stream callback, half or full: blocks alternate and continue the
+  *         conversion numbers.
+  * @param  pBlock: the half of Stream just filled.
+  * @param  Count: samples in it.
+  * @retval None
+  */
+static void StreamBlock(uint16_t* pBlock, uint32_t Count)
+{
+  uint32_t i;
+
+  if ((Count != SIM_CAP_STREAM / 2) || (pBlock != Stream + (Blocks & 1) * Count))
+  {
+    StreamErrors++;
+    return;
+  }
+  for (i = 0; i < Count; i++)
+  {
+    StreamErrors += (pBlock[i] != (Blocks * Count + i) % SIM_CAP_CODES);
+  }
+  Blocks++;
+}
+
+/**
+  * @brief  DMA_ADC1StreamIRQHandler(): on time, then late with HT and TC both
+  *         pending.
+  * @retval Number of failed checks.
+  */
+static uint32_t CheckStream(void)
+{
+  uint32_t entries, blocks, errors = 0;
+
+  SIM_Reset();
+  Converted = 0;
+  Blocks = 0;
+  StreamErrors = 0;
+  Handler = DMA_ADC1StreamIRQHandler;
+  DMA_ADC1StreamInit(Stream, SIM_CAP_STREAM, StreamBlock, StreamBlock);
+  NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+  AdcStart();
+  SIM_Advance(SIM_CAP_BLOCKS * (SIM_CAP_STREAM / 2) * SIM_CAP_CONV + SIM_CAP_CONV / 2);
+  errors += (Blocks != SIM_CAP_BLOCKS);
+
+  /* Masked from just after a wrap until the next one: both halves wait */
+  while (SIM_Peek(&DMA1_Channel1->CNDTR) != SIM_CAP_STREAM - 1)
+  {
+    SIM_Advance(1);
+  }
+  __disable_irq();
+  while (!(SIM_Peek(&DMA1->ISR) & DMA_ISR_TCIF1))
+  {
+    SIM_Advance(1);
+  }
+  entries = SIM_GetIrqCount(DMA1_Channel1_IRQn);
+  blocks = Blocks;
+  __enable_irq();
+  errors += (SIM_GetIrqCount(DMA1_Channel1_IRQn) != entries + 1) || (Blocks != blocks + 2);
+  errors += Overrun("stream");
+  errors += (StreamErrors != 0);
+  printf("stream     %u blocks, late handler %u blocks  %s\n", (unsigned)Blocks,
+         (unsigned)(Blocks - blocks), (errors == 0) ? "ok" : "MISMATCH");
+  return (errors != 0) ? 1 : 0;
+}
+
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
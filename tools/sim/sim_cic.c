@@ -0,0 +1,166 @@
+/**
+ * @file    tools/sim/sim_cic.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Cycle cost and DC gain of nc_cic on nc_sim
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/*
+ * Measures CIC_Decimate() per input sample on the nc_sim cycle clock and
+ * checks its DC gain. From the repository root:
+ *
+ *   cc -O2 -no-pie -DSTM32L1XX_MD -Itools/sim -I. -o sim_cic \
+ *      tools/sim/sim_cic.c tools/sim/nc_sim.c nc_cic.c
+ *   ./sim_cic
+ *
+ * Each configuration decimates a block of SIM_CIC_BLOCK samples under
+ * SIM_Run(), one virtual cycle per host instruction, and the same call with
+ * no samples is subtracted. The figures are x86-64 instructions, not
+ * Cortex-M3 cycles: they compare configurations, the target runs the same
+ * loop with about the same number of instructions. A constant full-scale
+ * input must then settle to 4095 * R^N >> Shift; the exit status is 1
+ * otherwise.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "nc_sim.h"
+#include "nc_cic.h"
+
+/* Private define ------------------------------------------------------------*/
+#define SIM_CIC_CLOCK             32000000UL
+#define SIM_CIC_CPI               1           /* Virtual cycles per host instruction */
+#define SIM_CIC_BLOCK             1024
+#define SIM_CIC_FULL_SCALE        4095
+
+/* Private variables ---------------------------------------------------------*/
+static const uint8_t Stages[] = {1, 2, 3, 4, 5};
+static const uint16_t Rates[] = {4, 5, 16, 64};
+static uint16_t Input[SIM_CIC_BLOCK];
+static int32_t Output[SIM_CIC_BLOCK + 1];
+static CIC_TypeDef Cic;
+static uint32_t Count;
+
+/* Private function prototypes -----------------------------------------------*/
+static void Bench(void);
+static uint64_t Measure(uint32_t Samples);
+
+/* Private functions ---------------------------------------------------------*/
+
+int main(void)
+{
+  uint32_t seed = 12345;
+  uint32_t i, s, r, n, produced;
+  uint64_t gain, cycles;
+  uint32_t errors = 0;
+
+  SIM_Init(SIM_CIC_CLOCK);
+  printf(" N    R  Shift  DC gain  cycles/input\n");
+  for (s = 0; s < sizeof(Stages); s++)
+  {
+    for (r = 0; r < sizeof(Rates) / sizeof(Rates[0]); r++)
+    {
+      if (CIC_Init(&Cic, Stages[s], Rates[r]) != 0)
+      {
+        printf("%2u %4u  growth above 32 bits, rejected\n", Stages[s], Rates[r]);
+        continue;
+      }
+      for (i = 0; i < SIM_CIC_BLOCK; i++)
+      {
+        seed = seed * 1664525UL + 1013904223UL;
+        Input[i] = (uint16_t)(seed >> 20);
+      }
+      cycles = Measure(SIM_CIC_BLOCK) - Measure(0);
+
+      /* DC: settled once every stage has seen N * R constant samples */
+      for (i = 0; i < SIM_CIC_BLOCK; i++)
+      {
+        Input[i] = SIM_CIC_FULL_SCALE;
+      }
+      for (gain = 1, n = 0; n < Stages[s]; n++)
+      {
+        gain *= Rates[r];
+      }
+      CIC_Init(&Cic, Stages[s], Rates[r]);
+      for (n = 0; n * SIM_CIC_BLOCK < 2UL * Stages[s] * Rates[r]; n++)
+      {
+        CIC_Decimate(&Cic, Input, 1, SIM_CIC_BLOCK, Output);
+      }
+      produced = CIC_Decimate(&Cic, Input, 1, SIM_CIC_BLOCK, Output);
+      for (i = 0; i < produced; i++)
+      {
+        if ((uint64_t)Output[i] != ((SIM_CIC_FULL_SCALE * gain) >> Cic.Shift))
+        {
+          errors++;
+        }
+      }
+      printf("%2u %4u  %5u  %7.4f  %12.2f\n", Stages[s], Rates[r], Cic.Shift,
+             (double)gain / (double)(1ULL << Cic.Shift), (double)cycles / SIM_CIC_BLOCK);
+    }
+  }
+
+  if (errors != 0)
+  {
+    printf("%u outputs off the DC gain\n", errors);
+    return 1;
+  }
+  printf("as expected\n");
+  return 0;
+}
+
+/**
+  * @brief  The code under test, run by SIM_Run().
+  * @retval None
+  */
+static void Bench(void)
+{
+  CIC_Decimate(&Cic, Input, 1, Count, Output);
+}
+
+/**
+  * @brief  Virtual cycles of one CIC_Decimate() call, from the same state.
+  * @param  Samples: input samples.
+  * @retval Cycles.
+  */
+static uint64_t Measure(uint32_t Samples)
+{
+  CIC_TypeDef saved = Cic;
+  uint64_t start = SIM_GetCycles();
+
+  Count = Samples;
+  SIM_Run(Bench, SIM_CIC_CPI, 1000000000ULL);
+  Cic = saved;
+  return SIM_GetCycles() - start;
+}
+
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,173 @@
+/**
+ * @file    tools/sim/sim_crc.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Hardware CRC shared between main and an interrupt on nc_sim
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/*
+ * Checks that the CRC unit gives the right answer to main() and to an
+ * interrupt handler that both use it. From the repository root:
+ *
+ *   cc -O2 -no-pie -DSTM32L1XX_MD -Itools/sim -I. -o sim_crc \
+ *      tools/sim/sim_crc.c tools/sim/nc_sim.c nc_stm32l1_crc.c nc_stm32l1_rcc.c
+ *   ./sim_crc
+ *
+ * The worker computes the CRC of a block in two pieces, CRC_CalcBlockCRC()
+ * then CRC_UpdateBlockCRC(), over and over. SysTick fires every
+ * SIM_CRC_TICK cycles, a period prime to the loop so it lands on every
+ * instruction, and its handler computes the CRC of another block. Every
+ * result is compared with a bitwise reference. The exit status is 1 on any
+ * mismatch.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "nc_sim.h"
+#include "nc_stm32l1_crc.h"
+
+/* Private define ------------------------------------------------------------*/
+#define SIM_CRC_CLOCK             32000000UL
+#define SIM_CRC_CPI               1           /* Virtual cycles per host instruction */
+#define SIM_CRC_TICK              331
+#define SIM_CRC_RUNS              100
+#define SIM_CRC_WORDS             64
+#define SIM_CRC_SPLIT             24          /* Words in the first piece */
+#define SIM_CRC_ISR_WORDS         5
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t Block[SIM_CRC_WORDS];
+static uint32_t IsrBlock[SIM_CRC_ISR_WORDS];
+static uint32_t BlockCrc;
+static uint32_t IsrCrc;
+static uint32_t MainErrors;
+static volatile uint32_t IsrErrors;
+
+/* Private function prototypes -----------------------------------------------*/
+void SysTick_Handler(void);
+static void Worker(void);
+static uint32_t Reference(const uint32_t* pBuffer, uint32_t Length);
+
+/* Private functions ---------------------------------------------------------*/
+
+int main(void)
+{
+  uint32_t seed = 12345;
+  uint32_t i;
+  int32_t timeout;
+
+  for (i = 0; i < SIM_CRC_WORDS; i++)
+  {
+    seed = seed * 1664525UL + 1013904223UL;
+    Block[i] = seed;
+  }
+  for (i = 0; i < SIM_CRC_ISR_WORDS; i++)
+  {
+    seed = seed * 1664525UL + 1013904223UL;
+    IsrBlock[i] = seed;
+  }
+  BlockCrc = Reference(Block, SIM_CRC_WORDS);
+  IsrCrc = Reference(IsrBlock, SIM_CRC_ISR_WORDS);
+
+  SIM_Init(SIM_CRC_CLOCK);
+  SIM_SetVector(SysTick_IRQn, SysTick_Handler);
+  CRC_Init();
+  SysTick_Config(SIM_CRC_TICK);
+  timeout = SIM_Run(Worker, SIM_CRC_CPI, 1000000000ULL);
+  SysTick->CTRL = 0;
+
+  printf("%u blocks of %u words, %u SysTick interrupts: %u wrong in main(), %u wrong in the handler\n",
+         SIM_CRC_RUNS, SIM_CRC_WORDS, SIM_GetIrqCount(SysTick_IRQn), MainErrors, IsrErrors);
+  if ((timeout != 0) || (MainErrors != 0) || (IsrErrors != 0) || (SIM_GetIrqCount(SysTick_IRQn) == 0))
+  {
+    printf("MISMATCH\n");
+    return 1;
+  }
+  printf("as expected\n");
+  return 0;
+}
+
+/**
+  * @brief  Uses the CRC unit from the interrupt.
+  * @retval None
+  */
+void SysTick_Handler(void)
+{
+  if (CRC_CalcBlockCRC(IsrBlock, SIM_CRC_ISR_WORDS) != IsrCrc)
+  {
+    IsrErrors++;
+  }
+}
+
+/**
+  * @brief  Uses the CRC unit from the interrupted context, in two pieces.
+  * @retval None
+  */
+static void Worker(void)
+{
+  uint32_t run, crc;
+
+  for (run = 0; run < SIM_CRC_RUNS; run++)
+  {
+    crc = CRC_CalcBlockCRC(Block, SIM_CRC_SPLIT);
+    crc = CRC_UpdateBlockCRC(crc, Block + SIM_CRC_SPLIT, SIM_CRC_WORDS - SIM_CRC_SPLIT);
+    if (crc != BlockCrc)
+    {
+      MainErrors++;
+    }
+  }
+}
+
+/**
+  * @brief  CRC of the unit computed bit by bit, independent of the driver.
+  * @param  pBuffer: words.
+  * @param  Length: number of words.
+  * @retval 32-bit CRC
+  */
+static uint32_t Reference(const uint32_t* pBuffer, uint32_t Length)
+{
+  uint32_t crc = CRC_INIT_VALUE;
+  uint32_t i, bit;
+
+  for (i = 0; i < Length; i++)
+  {
+    crc ^= pBuffer[i];
+    for (bit = 0; bit < 32; bit++)
+    {
+      crc = (crc & 0x80000000UL) ? ((crc << 1) ^ CRC_POLYNOMIAL) : (crc << 1);
+    }
+  }
+  return crc;
+}
+
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,211 @@
+/**
+ * @file    tools/sim/sim_delta.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   DLT_EncodeBlock() and DLT_DecodeBlock() on nc_sim: ratio and cycles per mode
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/*
+ * Measures the delta coder on the nc_sim cycle clock in each mode. From the
+ * repository root:
+ *
+ *   cc -O2 -no-pie -DSTM32L1XX_MD -Itools/sim -I. -o sim_delta \
+ *      tools/sim/sim_delta.c tools/sim/nc_sim.c nc_delta.c -lm
+ *   ./sim_delta
+ *
+ * The input is SIM_DLT_BLOCKS DMA blocks of SIM_DLT_FRAMES scans of three
+ * ranks, the mix the firmware samples:
+ *   rank 0  50 Hz tone of 1000 codes at 1 kHz, second order predictor
+ *   rank 1  slow drift with +-2 codes of noise, as Vrefint or the sensor
+ *   rank 2  +-32 codes of white noise around mid-scale
+ * Each mode encodes all the blocks, then a decoder bank restores them, both
+ * under SIM_Run() with one virtual cycle per host instruction. The ratio is
+ * against 16-bit samples and against 12-bit packing (P12, 1.5 bytes per
+ * sample). The cycle figures are x86-64 instructions, not Cortex-M3 cycles;
+ * what carries over is how the modes compare. Every block must decode to
+ * the input and AUTO must never be larger than VARINT or PACKED; the exit
+ * status is 1 otherwise.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "nc_sim.h"
+#include "nc_delta.h"
+
+/* Private define ------------------------------------------------------------*/
+#define SIM_DLT_CLOCK             32000000UL
+#define SIM_DLT_CPI               1           /* Virtual cycles per host instruction */
+#define SIM_DLT_RANKS             3
+#define SIM_DLT_FRAMES            128         /* Scans per DMA block */
+#define SIM_DLT_BLOCKS            8
+#define SIM_DLT_SAMPLES           (SIM_DLT_BLOCKS * SIM_DLT_FRAMES * SIM_DLT_RANKS)
+#define SIM_DLT_BOUND             DLT_BLOCK_BOUND(SIM_DLT_FRAMES, SIM_DLT_RANKS)
+
+/* Private variables ---------------------------------------------------------*/
+static const char* const ModeName[3] = {"VARINT", "PACKED", "AUTO"};
+static uint16_t Input[SIM_DLT_SAMPLES];
+static uint16_t Output[SIM_DLT_SAMPLES];
+static uint8_t Coded[SIM_DLT_BLOCKS][SIM_DLT_BOUND];
+static uint32_t Size[SIM_DLT_BLOCKS];
+static DLT_BankTypeDef Bank;
+static uint32_t Blocks;
+static uint32_t Malformed;
+
+/* Private function prototypes -----------------------------------------------*/
+static void Encode(void);
+static void Decode(void);
+static void Setup(uint8_t Mode);
+static uint64_t Measure(void (*pFunc)(void), uint8_t Mode, uint32_t NumBlocks);
+
+/* Private functions ---------------------------------------------------------*/
+
+int main(void)
+{
+  uint32_t i, n, mode, total[3];
+  uint32_t seed = 1, errors = 0;
+  uint64_t enc, dec;
+  int32_t noise;
+
+  for (n = 0; n < SIM_DLT_BLOCKS * SIM_DLT_FRAMES; n++)
+  {
+    seed = seed * 1103515245UL + 12345;
+    noise = (int32_t)((seed >> 16) & 0x3F) - 32;
+    Input[SIM_DLT_RANKS * n] = (uint16_t)lround(2048.0 + 1000.0 * sin(2.0 * M_PI * 50.0 * n / 1000.0));
+    Input[SIM_DLT_RANKS * n + 1] = (uint16_t)(1500 + n / 64 + noise / 16);
+    Input[SIM_DLT_RANKS * n + 2] = (uint16_t)(2048 + noise);
+  }
+
+  SIM_Init(SIM_DLT_CLOCK);
+  printf("mode     bytes  bits/sample  vs 16-bit  vs 12-bit  encode cycles/sample  decode cycles/sample\n");
+  for (mode = DLT_MODE_VARINT; mode <= DLT_MODE_AUTO; mode++)
+  {
+    enc = Measure(Encode, (uint8_t)mode, SIM_DLT_BLOCKS) - Measure(Encode, (uint8_t)mode, 0);
+    Setup((uint8_t)mode);
+    Encode();
+    dec = Measure(Decode, (uint8_t)mode, SIM_DLT_BLOCKS) - Measure(Decode, (uint8_t)mode, 0);
+
+    memset(Output, 0, sizeof(Output));
+    Malformed = 0;
+    Setup((uint8_t)mode);
+    Decode();
+    total[mode] = 0;
+    for (i = 0; i < SIM_DLT_BLOCKS; i++)
+    {
+      total[mode] += Size[i];
+    }
+    if ((Malformed != 0) || (memcmp(Input, Output, sizeof(Input)) != 0))
+    {
+      printf("%s: decoded blocks differ from the input\n", ModeName[mode]);
+      errors++;
+    }
+    printf("%-6s  %6u  %11.2f  %9.2f  %9.2f  %20.2f  %20.2f\n", ModeName[mode], total[mode],
+           8.0 * total[mode] / SIM_DLT_SAMPLES, 2.0 * SIM_DLT_SAMPLES / total[mode],
+           1.5 * SIM_DLT_SAMPLES / total[mode], (double)enc / SIM_DLT_SAMPLES, (double)dec / SIM_DLT_SAMPLES);
+  }
+  if ((total[DLT_MODE_AUTO] > total[DLT_MODE_VARINT]) || (total[DLT_MODE_AUTO] > total[DLT_MODE_PACKED]))
+  {
+    printf("AUTO is larger than a fixed mode\n");
+    errors++;
+  }
+
+  printf("%s\n", (errors == 0) ? "as expected" : "MISMATCH");
+  return (errors == 0) ? 0 : 1;
+}
+
+/**
+  * @brief  Encodes the first Blocks blocks in order, run by SIM_Run().
+  * @retval None
+  */
+static void Encode(void)
+{
+  uint32_t i;
+
+  for (i = 0; i < Blocks; i++)
+  {
+    Size[i] = DLT_EncodeBlock(&Bank, Input + i * SIM_DLT_FRAMES * SIM_DLT_RANKS, SIM_DLT_FRAMES, Coded[i]);
+  }
+}
+
+/**
+  * @brief  Decodes the first Blocks blocks in order, run by SIM_Run().
+  * @retval None
+  */
+static void Decode(void)
+{
+  uint32_t i;
+
+  for (i = 0; i < Blocks; i++)
+  {
+    if (DLT_DecodeBlock(&Bank, Coded[i], Size[i], Output + i * SIM_DLT_FRAMES * SIM_DLT_RANKS,
+                        SIM_DLT_FRAMES) != (int32_t)Size[i])
+    {
+      Malformed++;
+    }
+  }
+}
+
+/**
+  * @brief  A fresh bank, both sides configured alike.
+  * @param  Mode: DLT_MODE_x.
+  * @retval None
+  */
+static void Setup(uint8_t Mode)
+{
+  Blocks = SIM_DLT_BLOCKS;
+  if ((DLT_Init(&Bank, SIM_DLT_RANKS, Mode) != 0) || (DLT_SetOrder(&Bank, 0, 2) != 0))
+  {
+    printf("DLT_Init rejected the bank\n");
+  }
+}
+
+/**
+  * @brief  Virtual cycles of Encode() or Decode() on a fresh bank.
+  * @param  pFunc: Encode or Decode.
+  * @param  Mode: DLT_MODE_x.
+  * @param  NumBlocks: blocks to run.
+  * @retval Cycles.
+  */
+static uint64_t Measure(void (*pFunc)(void), uint8_t Mode, uint32_t NumBlocks)
+{
+  uint64_t start;
+
+  Setup(Mode);
+  Blocks = NumBlocks;
+  start = SIM_GetCycles();
+  SIM_Run(pFunc, SIM_DLT_CPI, 1000000000ULL);
+  return SIM_GetCycles() - start;
+}
+
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
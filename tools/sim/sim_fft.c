@@ -0,0 +1,290 @@
+/**
+ * @file    tools/sim/sim_fft.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Throughput and accuracy of nc_fft on nc_sim
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/*
+ * Measures one spectral summary per block on the nc_sim cycle clock, and the
+ * error of FFT_RealQ15() against a double precision DFT. From the repository
+ * root:
+ *
+ *   cc -O2 -no-pie -DSTM32L1XX_MD -Itools/sim -I. -o sim_fft \
+ *      tools/sim/sim_fft.c tools/sim/nc_sim.c nc_fft.c -lm
+ *   ./sim_fft
+ *
+ * For N = 64 to 1024 a block of 12-bit codes goes through FFT_Load() with a
+ * Hann window, FFT_RealQ15() and FFT_MagSquared() under SIM_Run(), one
+ * virtual cycle per host instruction; blocks/s is 32 MHz over the total.
+ * These are x86-64 instructions rather than Cortex-M3 cycles, so the rate is
+ * a model of the target, not a measurement of it. The accuracy pass runs
+ * random, tone, impulse, square and constant full-scale blocks through
+ * FFT_Load() without a window and compares every output word with the DFT
+ * of the same Q15 input scaled by 1/N. Each pass of the transform truncates
+ * once, so the exit status is 1 if the worst error exceeds one LSB per pass
+ * plus one: ceil(log2(N/2) / 2) + 1 LSB.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdio.h>
+#include "nc_sim.h"
+#include "nc_fft.h"
+
+/* Private define ------------------------------------------------------------*/
+#define SIM_FFT_CLOCK             32000000UL
+#define SIM_FFT_CPI               1           /* Virtual cycles per host instruction */
+#define SIM_FFT_SIGNALS           7
+
+/* Private variables ---------------------------------------------------------*/
+static uint16_t Codes[FFT_MAX_POINTS];
+static int16_t Window[FFT_MAX_POINTS];
+static int16_t Buf[FFT_MAX_POINTS];
+static uint32_t Bins[FFT_MAX_POINTS / 2 + 1];
+static uint32_t Points;
+static uint32_t Stage;
+
+/* Private function prototypes -----------------------------------------------*/
+static void Bench(void);
+static uint64_t Measure(uint32_t What);
+static void Signal(uint32_t Kind, uint32_t N, uint32_t* pSeed);
+static double Error(uint32_t N, double* pSumSq);
+
+/* Private functions ---------------------------------------------------------*/
+
+int main(void)
+{
+  static const char* const names[SIM_FFT_SIGNALS] =
+    {"random", "tone", "impulse", "square", "full +", "full -", "ramp"};
+  uint32_t seed = 12345;
+  uint32_t n, kind, run, bound;
+  uint64_t load, fft, mag;
+  double err, worst, sumsq, rms;
+  uint32_t errors = 0;
+
+  SIM_Init(SIM_FFT_CLOCK);
+  printf("   N   load  FFT_RealQ15  magnitude  total cycles  blocks/s at 32 MHz\n");
+  for (n = FFT_MIN_POINTS; n <= FFT_MAX_POINTS; n <<= 1)
+  {
+    Points = n;
+    FFT_HannInit(Window, n);
+    Signal(0, n, &seed);
+    load = Measure(1);
+    fft = Measure(2);
+    mag = Measure(3);
+    printf("%4u  %5llu  %11llu  %9llu  %12llu  %18.0f\n", n, (unsigned long long)load,
+           (unsigned long long)fft, (unsigned long long)mag, (unsigned long long)(load + fft + mag),
+           (double)SIM_FFT_CLOCK / (double)(load + fft + mag));
+  }
+
+  printf("\n   N  max error  rms error (LSB)  worst input\n");
+  for (n = FFT_MIN_POINTS; n <= FFT_MAX_POINTS; n <<= 1)
+  {
+    worst = 0.0;
+    sumsq = 0.0;
+    rms = 0.0;
+    bound = 0;
+    for (kind = 0; kind < SIM_FFT_SIGNALS; kind++)
+    {
+      for (run = 0; run < ((kind == 0) ? 20 : 1); run++)
+      {
+        Signal(kind, n, &seed);
+        FFT_Load(Buf, Codes, 1, n, 0);
+        err = Error(n, &sumsq);
+        rms += sumsq;
+        if (err > worst)
+        {
+          worst = err;
+          bound = kind;
+        }
+      }
+    }
+    rms = sqrt(rms / (n * (20 + SIM_FFT_SIGNALS - 1)));
+    printf("%4u  %9.2f  %15.2f  %s\n", n, worst, rms, names[bound]);
+    /* Radix-4 passes, plus the radix-2 one for odd log2(N/2) */
+    for (run = 0, kind = n / 2; kind > 1; kind >>= 2)
+    {
+      run++;
+    }
+    if (worst > run + 1)
+    {
+      errors++;
+    }
+  }
+
+  if (errors != 0)
+  {
+    printf("%u sizes above one LSB per pass plus one\n", errors);
+    return 1;
+  }
+  printf("as expected\n");
+  return 0;
+}
+
+/**
+  * @brief  The code under test, run by SIM_Run().
+  * @retval None
+  */
+static void Bench(void)
+{
+  switch (Stage)
+  {
+    case 1:
+      FFT_Load(Buf, Codes, 1, Points, Window);
+      break;
+    case 2:
+      FFT_RealQ15(Buf, Points);
+      break;
+    case 3:
+      FFT_MagSquared(Buf, Points, Bins);
+      break;
+    default:
+      break;
+  }
+}
+
+/**
+  * @brief  Virtual cycles of one step of the summary, less the empty call.
+  * @param  What: 1 load and window, 2 transform, 3 magnitude squared.
+  * @retval Cycles.
+  */
+static uint64_t Measure(uint32_t What)
+{
+  uint64_t start, empty;
+
+  start = SIM_GetCycles();
+  Stage = 0;
+  SIM_Run(Bench, SIM_FFT_CPI, 1000000000ULL);
+  empty = SIM_GetCycles() - start;
+  start = SIM_GetCycles();
+  Stage = What;
+  SIM_Run(Bench, SIM_FFT_CPI, 1000000000ULL);
+  return SIM_GetCycles() - start - empty;
+}
+
+/**
+  * @brief  Fills Codes[] with a test block.
+  * @param  Kind: 0 random, 1 tone, 2 impulse, 3 square, 4 and 5 constant full
+  *         scale, 6 a slow ramp.
+  * @param  N: samples.
+  * @param  pSeed: random state.
+  * @retval None
+  */
+static void Signal(uint32_t Kind, uint32_t N, uint32_t* pSeed)
+{
+  uint32_t i;
+
+  for (i = 0; i < N; i++)
+  {
+    *pSeed = *pSeed * 1664525UL + 1013904223UL;
+    switch (Kind)
+    {
+      case 0:
+        Codes[i] = (uint16_t)(*pSeed >> 20);
+        break;
+      case 1:
+        Codes[i] = (uint16_t)lround(2048.0 + 2047.0 * sin(2.0 * M_PI * 5.0 * i / N));
+        break;
+      case 2:
+        Codes[i] = (i == 0) ? 4095 : 2048;
+        break;
+      case 3:
+        Codes[i] = ((i / 8) & 1) ? 0 : 4095;
+        break;
+      case 4:
+        Codes[i] = 4095;
+        break;
+      case 5:
+        Codes[i] = 0;
+        break;
+      default:
+        Codes[i] = (uint16_t)(2048 + 2047 * i / N);
+        break;
+    }
+  }
+}
+
+/**
+  * @brief  Transforms Buf[] and compares it with a double precision DFT.
+  * @param  N: FFT size.
+  * @param  pSumSq: receives the sum of squared errors over the N output words.
+  * @retval Largest error, in LSB.
+  */
+static double Error(uint32_t N, double* pSumSq)
+{
+  static double x[FFT_MAX_POINTS];
+  double re, im, e, worst = 0.0;
+  uint32_t n, k;
+
+  for (n = 0; n < N; n++)
+  {
+    x[n] = Buf[n];
+  }
+  FFT_RealQ15(Buf, N);
+  *pSumSq = 0.0;
+  for (k = 0; k <= N / 2; k++)
+  {
+    re = 0.0;
+    im = 0.0;
+    for (n = 0; n < N; n++)
+    {
+      re += x[n] * cos(2.0 * M_PI * (double)((k * n) % N) / N);
+      im -= x[n] * sin(2.0 * M_PI * (double)((k * n) % N) / N);
+    }
+    re /= N;
+    im /= N;
+    if (k == 0)
+    {
+      e = fabs(Buf[0] - re);
+    }
+    else if (k == N / 2)
+    {
+      e = fabs(Buf[1] - re);
+    }
+    else
+    {
+      e = fabs(Buf[2 * k] - re);
+      *pSumSq += e * e;
+      e = (fabs(Buf[2 * k + 1] - im) > e) ? fabs(Buf[2 * k + 1] - im) : e;
+      *pSumSq += (Buf[2 * k + 1] - im) * (Buf[2 * k + 1] - im);
+      worst = (e > worst) ? e : worst;
+      continue;
+    }
+    *pSumSq += e * e;
+    worst = (e > worst) ? e : worst;
+  }
+  return worst;
+}
+
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,162 @@
+/**
+ * @file    tools/sim/sim_goertzel.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Cycles per sample of nc_goertzel against the number of targets
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/*
+ * Measures GOERTZEL_Process() on the nc_sim cycle clock for 1 to
+ * GOERTZEL_MAX_TARGETS targets. From the repository root:
+ *
+ *   cc -O2 -no-pie -DSTM32L1XX_MD -Itools/sim -I. -o sim_goertzel \
+ *      tools/sim/sim_goertzel.c tools/sim/nc_sim.c nc_goertzel.c \
+ *      nc_fixmath.c -lm
+ *   ./sim_goertzel
+ *
+ * The input is a 50 Hz tone of SIM_GZ_AMPLITUDE codes at fs = 1 kHz, and
+ * the targets are 50 Hz and its odd harmonics. A block of SIM_GZ_BLOCK
+ * samples, whole windows of SIM_GZ_WINDOW, runs under SIM_Run() with one
+ * virtual cycle per host instruction, so the per-window magnitude step is
+ * included. The figures are x86-64 instructions, not Cortex-M3 cycles; what
+ * carries over is the growth with the number of targets. The 50 Hz target
+ * must read the tone amplitude and the harmonics nearly nothing; the exit
+ * status is 1 otherwise.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "nc_sim.h"
+#include "nc_goertzel.h"
+
+/* Private define ------------------------------------------------------------*/
+#define SIM_GZ_CLOCK              32000000UL
+#define SIM_GZ_CPI                1           /* Virtual cycles per host instruction */
+#define SIM_GZ_FS                 1000
+#define SIM_GZ_WINDOW             200         /* 5 Hz bins */
+#define SIM_GZ_BLOCK              (5 * SIM_GZ_WINDOW)
+#define SIM_GZ_AMPLITUDE          1000        /* Codes */
+
+/* Private variables ---------------------------------------------------------*/
+static const int32_t Coeffs[GOERTZEL_MAX_TARGETS] =
+{
+  GOERTZEL_COEFF(50, SIM_GZ_FS),  GOERTZEL_COEFF(150, SIM_GZ_FS), GOERTZEL_COEFF(250, SIM_GZ_FS),
+  GOERTZEL_COEFF(350, SIM_GZ_FS), GOERTZEL_COEFF(450, SIM_GZ_FS), GOERTZEL_COEFF(110, SIM_GZ_FS),
+  GOERTZEL_COEFF(210, SIM_GZ_FS), GOERTZEL_COEFF(310, SIM_GZ_FS)
+};
+static uint16_t Input[SIM_GZ_BLOCK];
+static GOERTZEL_BankTypeDef Bank;
+static uint32_t Count;
+
+/* Private function prototypes -----------------------------------------------*/
+static void Bench(void);
+static uint64_t Measure(uint32_t Samples);
+
+/* Private functions ---------------------------------------------------------*/
+
+int main(void)
+{
+  uint32_t i, targets, other;
+  uint32_t errors = 0;
+  uint64_t cycles, base = 0;
+
+  for (i = 0; i < SIM_GZ_BLOCK; i++)
+  {
+    Input[i] = (uint16_t)lround(2048.0 + SIM_GZ_AMPLITUDE * sin(2.0 * M_PI * 50.0 * i / SIM_GZ_FS));
+  }
+
+  SIM_Init(SIM_GZ_CLOCK);
+  printf("targets  cycles/sample  per target  50 Hz amplitude  largest other\n");
+  for (targets = 1; targets <= GOERTZEL_MAX_TARGETS; targets++)
+  {
+    GOERTZEL_Init(&Bank, Coeffs, (uint8_t)targets, SIM_GZ_WINDOW);
+    cycles = Measure(SIM_GZ_BLOCK) - Measure(0);
+    if (targets == 1)
+    {
+      base = cycles;
+    }
+
+    GOERTZEL_Process(&Bank, Input, 1, SIM_GZ_BLOCK);
+    other = 0;
+    for (i = 1; i < targets; i++)
+    {
+      other = (Bank.Amplitude[i] > other) ? Bank.Amplitude[i] : other;
+    }
+    /* Amplitude is Q4 */
+    if ((Bank.Windows != 5) || (abs((int32_t)Bank.Amplitude[0] - 16 * SIM_GZ_AMPLITUDE) > 16 * SIM_GZ_AMPLITUDE / 100) ||
+        (other > 16 * SIM_GZ_AMPLITUDE / 100))
+    {
+      errors++;
+    }
+    printf("%7u  %13.2f  %10.2f  %15.2f  %13.2f\n", targets, (double)cycles / SIM_GZ_BLOCK,
+           (targets > 1) ? (double)(cycles - base) / SIM_GZ_BLOCK / (targets - 1) : 0.0,
+           Bank.Amplitude[0] / 16.0, other / 16.0);
+  }
+
+  if (errors != 0)
+  {
+    printf("%u target counts read the wrong amplitudes\n", errors);
+    return 1;
+  }
+  printf("as expected\n");
+  return 0;
+}
+
+/**
+  * @brief  The code under test, run by SIM_Run().
+  * @retval None
+  */
+static void Bench(void)
+{
+  GOERTZEL_Process(&Bank, Input, 1, Count);
+}
+
+/**
+  * @brief  Virtual cycles of one GOERTZEL_Process() call, from the same state.
+  * @param  Samples: input samples.
+  * @retval Cycles.
+  */
+static uint64_t Measure(uint32_t Samples)
+{
+  GOERTZEL_BankTypeDef saved = Bank;
+  uint64_t start = SIM_GetCycles();
+
+  Count = Samples;
+  SIM_Run(Bench, SIM_GZ_CPI, 1000000000ULL);
+  Bank = saved;
+  return SIM_GetCycles() - start;
+}
+
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
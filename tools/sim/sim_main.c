@@ -0,0 +1,145 @@
+/**
+ * @file    tools/sim/sim_main.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Runs the firmware main() on nc_sim with SysTick and ADC interrupts
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/*
+ * Runs the unmodified firmware main() from main.c on nc_sim, one host
+ * instruction at a time, with the SysTick and ADC1 interrupts it enables.
+ * From the repository root:
+ *
+ *   cc -O2 -no-pie -DSTM32L1XX_MD -Dmain=nc_firmware_main -Itools/sim -I. \
+ *      -o sim_main tools/sim/sim_main.c tools/sim/nc_sim.c main.c \
+ *      nc_stm32l1_adc.c nc_stm32l1_gpio.c nc_stm32l1_rcc.c \
+ *      nc_stm32l1_snapshot.c nc_median.c nc_vref.c nc_temp.c
+ *   ./sim_main
+ *
+ * VREFINT and the temperature sensor convert as at VDDA = 3.3 V and 45 degC.
+ * After SIM_MAIN_MS of virtual time the SysTick handler must have counted the
+ * milliseconds since SysTick_Config(). init_ADC() and every 128th tick must
+ * have started the injected group, and each JEOC must have refreshed the
+ * supply estimate and DieTemp.Centi. The exit status is 1 otherwise.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "nc_sim.h"
+#include "nc_stm32l1_adc.h"
+#include "nc_vref.h"
+#include "nc_temp.h"
+
+/* Private define ------------------------------------------------------------*/
+#define SIM_MAIN_CLOCK            16000000UL  /* HSI, once init_ADC() has switched to it */
+#define SIM_MAIN_MS               300
+#define SIM_MAIN_CPI              8           /* Virtual cycles per host instruction */
+#define SIM_MAIN_VREFINT          1519        /* 1671 * 3.0 V / 3.3 V */
+#define SIM_MAIN_TS               647         /* (680 + 172 * 15 / 80) * 3.0 V / 3.3 V */
+
+/* Private variables ---------------------------------------------------------*/
+extern volatile uint32_t msTicks;
+extern VREF_TypeDef Supply;
+extern TEMP_TypeDef DieTemp;
+
+/* Private function prototypes -----------------------------------------------*/
+int nc_firmware_main(void);
+void SysTick_Handler(void);
+void ADC1_IRQHandler(void);
+static void Firmware(void);
+
+/* Private functions ---------------------------------------------------------*/
+
+#undef main
+int main(void)
+{
+  VREF_TypeDef expect;
+  uint32_t ticks, adc, i, errors = 0;
+  int16_t centi;
+
+  SIM_Init(SIM_MAIN_CLOCK);
+  SIM_SetVector(SysTick_IRQn, SysTick_Handler);
+  SIM_SetVector(ADC1_IRQn, ADC1_IRQHandler);
+  SIM_SetAdcInput(ADC_Channel_Vrefint, SIM_MAIN_VREFINT);
+  SIM_SetAdcInput(ADC_Channel_TempSensor, SIM_MAIN_TS);
+
+  if (SIM_Run(Firmware, SIM_MAIN_CPI, (uint64_t)SIM_MAIN_CLOCK / 1000 * SIM_MAIN_MS) == 0)
+  {
+    printf("main() returned\n");
+    errors++;
+  }
+  ticks = SIM_GetIrqCount(SysTick_IRQn);
+  adc = SIM_GetIrqCount(ADC1_IRQn);
+
+  /* The same running average, fed the same readings */
+  expect.Cal = VREF_CAL;
+  expect.RawAvg = 0;
+  VREF_Update(&expect, expect.Cal);
+  expect.RawAvg = 0;
+  for (i = 0; i < adc; i++)
+  {
+    VREF_Update(&expect, SIM_MAIN_VREFINT);
+  }
+  centi = TEMP_Convert(&DieTemp, SIM_MAIN_TS, &expect);
+
+  printf("%.3f ms: %u SysTick, msTicks %u, %u ADC1 (JEOC), VDDA %u mV (expected %u mV), "
+         "die %d.%02d degC (expected %d.%02d degC)\n",
+         (double)SIM_GetCycles() * 1e3 / SIM_MAIN_CLOCK, ticks, msTicks, adc, Supply.Vdda, expect.Vdda,
+         DieTemp.Centi / 100, DieTemp.Centi % 100, centi / 100, centi % 100);
+  /* The stepped init code takes a few ms before SysTick_Config() */
+  if ((ticks != msTicks) || (ticks < SIM_MAIN_MS * 9 / 10) || (ticks > SIM_MAIN_MS))
+  {
+    errors++;
+  }
+  if ((adc != ticks / 128 + 1) || (Supply.Vdda != expect.Vdda) || (Supply.Vdda < 3295) || (Supply.Vdda > 3305))
+  {
+    errors++;
+  }
+  if ((DieTemp.Centi != centi) || (DieTemp.Centi < 4450) || (DieTemp.Centi > 4550))
+  {
+    errors++;
+  }
+  printf("%s\n", (errors == 0) ? "as expected" : "MISMATCH");
+  return (errors == 0) ? 0 : 1;
+}
+
+/**
+  * @brief  The firmware entry point, as a void function for SIM_Run().
+  * @retval None
+  */
+static void Firmware(void)
+{
+  (void)nc_firmware_main();
+}
+
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
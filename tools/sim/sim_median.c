@@ -0,0 +1,174 @@
+/**
+ * @file    tools/sim/sim_median.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   MED_Push against a sort per sample on nc_sim
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/*
+ * Measures MED_Push() on the nc_sim cycle clock against the naive filter
+ * that copies the window and insertion-sorts it for every sample. From the
+ * repository root:
+ *
+ *   cc -O2 -no-pie -DSTM32L1XX_MD -Itools/sim -I. -o sim_median \
+ *      tools/sim/sim_median.c tools/sim/nc_sim.c nc_median.c
+ *   ./sim_median
+ *
+ * The input is slow noise with a full-scale spike every 17 samples. For
+ * windows 3, 5 (the comparison networks), 15, 31 and MED_MAX_WINDOW (the
+ * heaps) both filters run SIM_MED_SAMPLES samples under SIM_Run(), one
+ * virtual cycle per host instruction. The figures are x86-64 instructions,
+ * not Cortex-M3 cycles; the ratio between the two filters is what carries
+ * over. Both must give the same output for every sample; the exit status is
+ * 1 otherwise.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "nc_sim.h"
+#include "nc_median.h"
+
+/* Private define ------------------------------------------------------------*/
+#define SIM_MED_CLOCK             32000000UL
+#define SIM_MED_CPI               1           /* Virtual cycles per host instruction */
+#define SIM_MED_SAMPLES           512
+
+/* Private variables ---------------------------------------------------------*/
+static const uint8_t Windows[] = {3, 5, 15, 31, MED_MAX_WINDOW};
+static uint16_t Input[SIM_MED_SAMPLES];
+static uint16_t Output[SIM_MED_SAMPLES];
+static uint16_t Expected[SIM_MED_SAMPLES];
+static MED_FilterTypeDef Filter;
+static uint16_t Ring[MED_MAX_WINDOW];
+static uint32_t Window;
+
+/* Private function prototypes -----------------------------------------------*/
+static void BenchMedian(void);
+static void BenchSort(void);
+
+/* Private functions ---------------------------------------------------------*/
+
+int main(void)
+{
+  uint32_t seed = 12345;
+  uint32_t i, w, mismatches;
+  uint32_t errors = 0;
+  uint64_t start, median, sort;
+
+  for (i = 0; i < SIM_MED_SAMPLES; i++)
+  {
+    seed = seed * 1664525UL + 1013904223UL;
+    Input[i] = (uint16_t)((i % 17 == 16) ? 4095 : 2000 + (seed >> 26));
+  }
+
+  SIM_Init(SIM_MED_CLOCK);
+  printf("window  MED_Push cycles/sample  sort cycles/sample  speed-up\n");
+  for (w = 0; w < sizeof(Windows); w++)
+  {
+    Window = Windows[w];
+    MED_Init(&Filter, (uint8_t)Window);
+    start = SIM_GetCycles();
+    SIM_Run(BenchMedian, SIM_MED_CPI, 1000000000ULL);
+    median = SIM_GetCycles() - start;
+    start = SIM_GetCycles();
+    SIM_Run(BenchSort, SIM_MED_CPI, 1000000000ULL);
+    sort = SIM_GetCycles() - start;
+
+    mismatches = 0;
+    for (i = 0; i < SIM_MED_SAMPLES; i++)
+    {
+      mismatches += (Output[i] != Expected[i]);
+    }
+    errors += mismatches;
+    printf("%6u  %22.1f  %18.1f  %8.1f%s\n", Window, (double)median / SIM_MED_SAMPLES,
+           (double)sort / SIM_MED_SAMPLES, (double)sort / (double)median,
+           (mismatches != 0) ? "  MISMATCH" : "");
+  }
+
+  if (errors != 0)
+  {
+    printf("%u outputs differ from the sorted median\n", errors);
+    return 1;
+  }
+  printf("as expected\n");
+  return 0;
+}
+
+/**
+  * @brief  MED_Push() over the input, run by SIM_Run().
+  * @retval None
+  */
+static void BenchMedian(void)
+{
+  uint32_t i;
+
+  for (i = 0; i < SIM_MED_SAMPLES; i++)
+  {
+    Output[i] = MED_Push(&Filter, Input[i]);
+  }
+}
+
+/**
+  * @brief  The naive filter over the input, run by SIM_Run(): a ring of the
+  *         last Window samples, the first replicated as MED_Push() does, copied
+  *         and insertion-sorted for every sample.
+  * @retval None
+  */
+static void BenchSort(void)
+{
+  uint16_t sorted[MED_MAX_WINDOW];
+  uint32_t i, j, k, idx = 0;
+  uint16_t v;
+
+  for (j = 0; j < Window; j++)
+  {
+    Ring[j] = Input[0];
+  }
+  for (i = 0; i < SIM_MED_SAMPLES; i++)
+  {
+    Ring[idx] = Input[i];
+    idx = (idx + 1 == Window) ? 0 : idx + 1;
+    for (j = 0; j < Window; j++)
+    {
+      v = Ring[j];
+      for (k = j; (k > 0) && (sorted[k - 1] > v); k--)
+      {
+        sorted[k] = sorted[k - 1];
+      }
+      sorted[k] = v;
+    }
+    Expected[i] = sorted[Window / 2];
+  }
+}
+
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
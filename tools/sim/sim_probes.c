@@ -0,0 +1,149 @@
+/**
+ * @file    sim_probes.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Scope probe waveform on the host simulator
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/*
+ * Drives the NC_PROBE pins through the real GPIO and DMA drivers on nc_sim and
+ * writes the GPIOB waveform as VCD. From the repository root:
+ *
+ *   cc -O2 -no-pie -DSTM32L1XX_MD -Itools/sim -I. -o sim_probes \
+ *      tools/sim/sim_probes.c tools/sim/nc_sim.c nc_stm32l1_gpio.c \
+ *      nc_stm32l1_dma.c nc_stm32l1_rcc.c
+ *   ./sim_probes probes.vcd
+ *
+ * Each cycle of the timeline is an ADC interrupt followed by the DMA half and
+ * full transfer handlers, whose callbacks raise NC_PROBE_DSP with the same
+ * BSRR store that drops their DMA probe. The recorded edges are checked
+ * against that timeline; the exit status is 1 on a mismatch.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "nc_sim.h"
+#include "nc_stm32l1_gpio.h"
+#include "nc_stm32l1_dma.h"
+#include "nc_defines.h"
+
+/* Private define ------------------------------------------------------------*/
+#define SIM_PROBES_CYCLES         4
+#define SIM_PROBES_CLOCK          32000000UL
+
+/* Private variables ---------------------------------------------------------*/
+static uint16_t Samples[64];
+static const char* const ProbeName[16] =
+{
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  "probe_isr", "probe_dma_ht", "probe_dma_tc", "probe_dsp"
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static void Block(uint16_t* pBlock, uint32_t Count);
+
+/* Private functions ---------------------------------------------------------*/
+
+int main(int argc, char** argv)
+{
+  /* Expected GPIOB outputs, one per recorded change, for each cycle */
+  static const uint16_t expect[] =
+  {
+    NC_PROBE_ISR, 0,
+    NC_PROBE_DMA_HT, NC_PROBE_DSP, 0,
+    NC_PROBE_DMA_TC, NC_PROBE_DSP, 0
+  };
+  const SIM_EdgeTypeDef* edges;
+  uint32_t count, i, errors = 0;
+
+  SIM_Init(SIM_PROBES_CLOCK);
+  GPIO_PinMapInit();
+  DMA_ADC1StreamInit(Samples, 64, Block, Block);
+
+  for (i = 0; i < SIM_PROBES_CYCLES; i++)
+  {
+    SIM_Advance(2000);
+    GPIO_SetBits(NC_PROBE_PORT, NC_PROBE_ISR);
+    SIM_Advance(120);
+    GPIO_ResetBits(NC_PROBE_PORT, NC_PROBE_ISR);
+
+    SIM_Advance(3000);
+    SIM_Poke(&DMA1->ISR, DMA1_IT_GL(1) | DMA1_IT_HT(1));
+    DMA_ADC1StreamIRQHandler();
+
+    SIM_Advance(3000);
+    SIM_Poke(&DMA1->ISR, DMA1_IT_GL(1) | DMA1_IT_TC(1));
+    DMA_ADC1StreamIRQHandler();
+  }
+
+  count = SIM_GetEdges(&edges);
+  if (count != SIM_PROBES_CYCLES * (sizeof(expect) / sizeof(expect[0])))
+  {
+    errors++;
+  }
+  for (i = 0; (i < count) && (errors == 0); i++)
+  {
+    if ((edges[i].Port != 1) || (edges[i].Odr != expect[i % (sizeof(expect) / sizeof(expect[0]))]))
+    {
+      errors++;
+    }
+  }
+  for (i = 0; i < count; i++)
+  {
+    printf("%10.3f us  GPIOB ODR 0x%04x\n", (double)edges[i].Cycles * 1e6 / SIM_PROBES_CLOCK, edges[i].Odr);
+  }
+  if (SIM_VcdWrite((argc > 1) ? argv[1] : "probes.vcd", GPIOB, ProbeName) != 0)
+  {
+    perror("vcd");
+    return 1;
+  }
+  printf("%u changes, %s\n", count, (errors == 0) ? "as expected" : "MISMATCH");
+  return (errors == 0) ? 0 : 1;
+}
+
+/**
+  * @brief  DMA half callback: block processing, then DSP probe up, DMA probe down in one store.
+  * @param  pBlock: samples.
+  * @param  Count: samples in the block.
+  * @retval None
+  */
+static void Block(uint16_t* pBlock, uint32_t Count)
+{
+  (void)pBlock;
+  SIM_Advance(40 * Count);
+  NC_PROBE_MARK(NC_PROBE_DSP, NC_PROBE_DMA_HT | NC_PROBE_DMA_TC);
+  SIM_Advance(20);
+  GPIO_WriteMask(NC_PROBE_PORT, 0, NC_PROBE_DSP);
+}
+
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,340 @@
+/**
+ * @file    sim_trace.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Register access tracer and redundant-write analyzer
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/*
+ * Runs the init paths of main.c and the drivers on nc_sim, logs every register
+ * access with its call site and reports, per init path:
+ *   - no-op writes: the register already held the value and no bit of it
+ *     triggers anything on write (BSRR, IFCR, EGR, SWSTART, data registers);
+ *   - repeated writes: a register stored more than once by the same path;
+ *   - avoidable read-modify-writes: a read immediately followed by a write of
+ *     the same register, where the read returned exactly what the path itself
+ *     had written before, so the value was already known.
+ * From the repository root:
+ *
+ *   cc -O2 -g -no-pie -DSTM32L1XX_MD -Dmain=nc_firmware_main -Itools/sim -I. \
+ *      -o sim_trace tools/sim/sim_trace.c tools/sim/nc_sim.c main.c \
+ *      nc_stm32l1_adc.c nc_stm32l1_gpio.c nc_stm32l1_rcc.c \
+ *      nc_stm32l1_snapshot.c nc_median.c nc_vref.c nc_temp.c
+ *   ./sim_trace [-v]
+ *
+ * Call sites come from addr2line on the executable, hence -g; -v also prints
+ * every access. Findings are candidates: a repeated write can be required by
+ * the hardware (FLASH ACC64 before LATENCY, EN last on a DMA channel).
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "nc_sim.h"
+#include "nc_stm32l1_adc.h"
+#include "nc_stm32l1_gpio.h"
+#include "nc_stm32l1_snapshot.h"
+
+#undef main                           /* -Dmain=nc_firmware_main is meant for main.c */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  const char* pName;
+  void (*pInit)(void);
+}TRC_PathTypeDef;
+
+typedef struct
+{
+  uintptr_t Pc;
+  char Text[96];
+}TRC_SiteTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define TRC_MAX_ACCESSES          4096
+#define TRC_MAX_SITES             512
+
+/* Private variables ---------------------------------------------------------*/
+extern SNAP_TypeDef WakeSnapshot;
+void init_ADC(void);
+void init_TIM3(void);
+
+static SIM_AccessTypeDef TRC_Access[TRC_MAX_ACCESSES];
+static TRC_SiteTypeDef TRC_Site[TRC_MAX_SITES];
+static uint32_t TRC_NumSites;
+static const char* TRC_Exe;
+
+/* Private function prototypes -----------------------------------------------*/
+static void TRC_AdcInit(void);
+static void TRC_SnapCapture(void);
+static void TRC_SnapRestore(void);
+static void TRC_Analyze(const char* pName, uint32_t Count, int Verbose);
+static uint32_t TRC_ActionBits(uint32_t Addr);
+static const char* TRC_Where(uintptr_t Pc);
+
+/* Private functions ---------------------------------------------------------*/
+
+int main(int argc, char** argv)
+{
+  static const TRC_PathTypeDef path[] =
+  {
+    {"GPIO_PinMapInit", GPIO_PinMapInit},
+    {"init_TIM3", init_TIM3},
+    {"init_ADC", init_ADC},
+    {"ADC_Init (defaults)", TRC_AdcInit},
+    {"SNAP_Capture", TRC_SnapCapture},
+    {"SNAP_Restore", TRC_SnapRestore}
+  };
+  int verbose = (argc > 1) && (strcmp(argv[1], "-v") == 0);
+  uint32_t i, count;
+
+  TRC_Exe = argv[0];
+  SIM_Init(16000000);
+  for (i = 0; i < sizeof(path) / sizeof(path[0]); i++)
+  {
+    SIM_TraceStart(TRC_Access, TRC_MAX_ACCESSES);
+    path[i].pInit();
+    count = SIM_TraceStop();
+    TRC_Analyze(path[i].pName, (count < TRC_MAX_ACCESSES) ? count : TRC_MAX_ACCESSES, verbose);
+  }
+  return 0;
+}
+
+/**
+  * @brief  SPL ADC_Init() with ADC_StructInit() defaults.
+  * @retval None
+  */
+static void TRC_AdcInit(void)
+{
+  ADC_InitTypeDef init;
+
+  ADC_StructInit(&init);
+  ADC_Init(ADC1, &init);
+}
+
+/**
+  * @brief  SNAP_Capture() of the state left by the init paths.
+  * @retval None
+  */
+static void TRC_SnapCapture(void)
+{
+  SNAP_Capture(&WakeSnapshot);
+}
+
+/**
+  * @brief  SNAP_Restore() of that image onto registers at their reset values.
+  * @retval None
+  */
+static void TRC_SnapRestore(void)
+{
+  SIM_Reset();
+  SNAP_Restore(&WakeSnapshot);
+}
+
+/**
+  * @brief  Prints the accesses of one init path that look redundant.
+  * @param  pName: path name.
+  * @param  Count: traced accesses.
+  * @param  Verbose: also print every access.
+  * @retval None
+  */
+static void TRC_Analyze(const char* pName, uint32_t Count, int Verbose)
+{
+  static uint8_t reported[TRC_MAX_ACCESSES];
+  const SIM_AccessTypeDef* a;
+  char name[32];
+  uint32_t reads = 0, writes = 0, findings = 0;
+  uint32_t i, j, n;
+  int32_t last;
+
+  for (i = 0; i < Count; i++)
+  {
+    if (TRC_Access[i].Write)
+    {
+      writes++;
+    }
+    else
+    {
+      reads++;
+    }
+  }
+  printf("%s: %u reads, %u writes, %llu cycles\n", pName, reads, writes,
+         (Count == 0) ? 0ULL : (unsigned long long)(TRC_Access[Count - 1].Cycles - TRC_Access[0].Cycles + SIM_ACCESS_CYCLES));
+  if (Verbose)
+  {
+    for (i = 0; i < Count; i++)
+    {
+      a = &TRC_Access[i];
+      printf("    %c %-22s 0x%08x -> 0x%08x  %s\n", a->Write ? 'W' : 'R', SIM_RegName(a->Addr, name, sizeof(name)),
+             a->Old, a->New, TRC_Where(a->Pc));
+    }
+  }
+
+  memset(reported, 0, sizeof(reported));
+  for (i = 0; i < Count; i++)
+  {
+    a = &TRC_Access[i];
+    if (!a->Write)
+    {
+      continue;
+    }
+    SIM_RegName(a->Addr, name, sizeof(name));
+
+    /* No-op write */
+    if ((a->New == a->Old) && ((a->New & TRC_ActionBits(a->Addr)) == 0))
+    {
+      printf("  no-op write       %-22s 0x%08x           %s\n", name, a->New, TRC_Where(a->Pc));
+      findings++;
+    }
+
+    /* Read-modify-write of a value this path wrote itself */
+    if ((i > 0) && !TRC_Access[i - 1].Write && (TRC_Access[i - 1].Addr == a->Addr))
+    {
+      for (last = (int32_t)i - 2; last >= 0; last--)
+      {
+        if (TRC_Access[last].Write && (TRC_Access[last].Addr == a->Addr))
+        {
+          break;
+        }
+      }
+      if ((last >= 0) && (TRC_Access[i - 1].New == TRC_Access[last].New) && (TRC_ActionBits(a->Addr) != 0xFFFFFFFF))
+      {
+        printf("  known-value RMW   %-22s %s", name, TRC_Where(a->Pc));
+        printf(" re-reads what %s wrote\n", TRC_Where(TRC_Access[last].Pc));
+        findings++;
+      }
+    }
+
+    /* Repeated writes, reported once per register */
+    if (reported[i])
+    {
+      continue;
+    }
+    for (j = i + 1, n = 1; j < Count; j++)
+    {
+      if (TRC_Access[j].Write && (TRC_Access[j].Addr == a->Addr))
+      {
+        n++;
+      }
+    }
+    if ((n > 1) && (TRC_ActionBits(a->Addr) != 0xFFFFFFFF))
+    {
+      printf("  repeated write    %-22s x%u:", name, n);
+      for (j = i; j < Count; j++)
+      {
+        if (TRC_Access[j].Write && (TRC_Access[j].Addr == a->Addr))
+        {
+          reported[j] = 1;
+          printf(" %s", TRC_Where(TRC_Access[j].Pc));
+        }
+      }
+      printf("\n");
+      findings++;
+    }
+  }
+  if (findings == 0)
+  {
+    printf("  nothing redundant\n");
+  }
+}
+
+/**
+  * @brief  Bits of a register that do something when written, whatever they held.
+  * @param  Addr: word address.
+  * @retval Mask, 0xFFFFFFFF for registers where every write acts.
+  */
+static uint32_t TRC_ActionBits(uint32_t Addr)
+{
+  if ((Addr >= GPIOA_BASE) && (Addr < GPIOA_BASE + 0x2000) && ((Addr & 0x3FF) == 0x18))
+  {
+    return 0xFFFFFFFF;                                /* BSRR */
+  }
+  if ((Addr == (uint32_t)&DMA1->IFCR) || (Addr == (uint32_t)&TIM3->EGR) || (Addr == (uint32_t)&TIM4->EGR) ||
+      (Addr == (uint32_t)&CRC->DR) || (Addr == (uint32_t)&USART1->DR) || (Addr == (uint32_t)&ADC1->DR))
+  {
+    return 0xFFFFFFFF;
+  }
+  if (Addr == (uint32_t)&ADC1->CR2)
+  {
+    return ADC_CR2_SWSTART | ADC_CR2_JSWSTART;
+  }
+  if (Addr == (uint32_t)&CRC->CR)
+  {
+    return CRC_CR_RESET;
+  }
+  return 0;
+}
+
+/**
+  * @brief  Source position of a host instruction, from addr2line.
+  * @param  Pc: instruction address.
+  * @retval "file:line", or the address if it cannot be resolved.
+  */
+static const char* TRC_Where(uintptr_t Pc)
+{
+  char cmd[512];
+  char line[sizeof(TRC_Site[0].Text)];
+  TRC_SiteTypeDef* s;
+  uint32_t i;
+  FILE* fp;
+  char* p;
+
+  for (i = 0; i < TRC_NumSites; i++)
+  {
+    if (TRC_Site[i].Pc == Pc)
+    {
+      return TRC_Site[i].Text;
+    }
+  }
+  s = &TRC_Site[(TRC_NumSites < TRC_MAX_SITES) ? TRC_NumSites++ : TRC_MAX_SITES - 1];
+  s->Pc = Pc;
+  snprintf(s->Text, sizeof(s->Text), "0x%lx", (unsigned long)Pc);
+  snprintf(cmd, sizeof(cmd), "addr2line -s -e '%s' 0x%lx 2>/dev/null", TRC_Exe, (unsigned long)Pc);
+  fp = popen(cmd, "r");
+  if (fp != 0)
+  {
+    if ((fgets(line, sizeof(line), fp) != 0) && (line[0] != '?'))
+    {
+      p = strpbrk(line, " \n");
+      if (p != 0)
+      {
+        *p = 0;
+      }
+      memcpy(s->Text, line, sizeof(line));
+    }
+    pclose(fp);
+  }
+  return s->Text;
+}
+
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/
@@ -0,0 +1,301 @@
+/**
+ * @file    tools/sim/sim_usart.c
+ * @author  Noel Cruz
+ * @email   noel_s_cruz@yahoo.com
+ * @github  https://github.com/noey2020
+ * @version v1.0
+ * @ide     Keil uVision
+ * @license GNU GPL v3
+ * @brief   Framed USART1 transmitter on nc_sim: chaining, backpressure, throughput
+ *
+@verbatim
+----------------------------------------------------------------------
+Copyright (C) 2020, Noel Cruz
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+----------------------------------------------------------------------
+@endverbatim
+ */
+
+/*
+ * Runs USART1_TxFrame() and USART1_TxIRQHandler() against the nc_sim model
+ * of DMA1_Channel4 and USART1, and parses the bytes that reach the line with
+ * FRM_Parse(). From the repository root:
+ *
+ *   cc -O2 -no-pie -DSTM32L1XX_MD -Itools/sim -I. -o sim_usart \
+ *      tools/sim/sim_usart.c tools/sim/nc_sim.c nc_stm32l1_usart.c \
+ *      nc_stm32l1_dma.c nc_stm32l1_rcc.c nc_stm32l1_crc.c nc_frame.c
+ *   ./sim_usart
+ *
+ * Backpressure: SysTick, less urgent than the DMA interrupt, offers
+ * 1024-byte frames at 1.5 times what 2 Mbaud carries. Every frame on the
+ * line must parse with a good CRC, header, payload and CRC chained with no
+ * gap, and the drops must show up as sequence gaps and FRM_FLAG_OVERRUN.
+ * The line must stay busy while the queue is full.
+ *
+ * Race: SysTick, more urgent than the DMA interrupt, queues 16-byte frames in
+ * pairs. A long gap lets the link go idle, then the second frame of the pair
+ * follows after about one frame time, one cycle later each pair, so across
+ * the run the producer lands on every instruction of the handler's idle
+ * transition. A frame queued in that window and never started only leaves
+ * with the next offer, so the queue must be empty at the end of every long
+ * gap. Every frame must be sent, and the link must drain at the end.
+ *
+ * The exit status is 1 on any mismatch.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "nc_sim.h"
+#include "nc_stm32l1_usart.h"
+#include "nc_stm32l1_crc.h"
+
+/* Private define ------------------------------------------------------------*/
+#define SIM_USART_CLOCK           32000000UL
+#define SIM_USART_BAUD            2000000UL
+#define SIM_USART_CPI             1           /* Virtual cycles per host instruction */
+#define SIM_USART_BYTE            (10 * SIM_USART_CLOCK / SIM_USART_BAUD)
+#define SIM_USART_BIG             1024        /* 512 samples as uint16_t */
+#define SIM_USART_BIG_FRAMES      30
+#define SIM_USART_SMALL           16
+#define SIM_USART_SWEEP           (2 * SIM_USART_BYTE)  /* Race: offsets -SWEEP..SWEEP-1 cycles */
+#define SIM_USART_BUFFERS         (USART_TX_QUEUE_SIZE + 1)
+#define SIM_USART_LINE            65536       /* Bytes kept, more than either run sends */
+
+/* Private typedef -----------------------------------------------------------*/
+
+/**
+  * @brief  One run: what the producer offers and how urgently.
+  */
+typedef struct
+{
+  const char* pName;
+  uint16_t Length;            /*!< Payload bytes per frame */
+  uint16_t Frames;            /*!< Frames offered */
+  uint32_t Period;            /*!< Cycles between offers */
+  uint32_t Sweep;             /*!< 0, or pairs: Period, then a frame time swept by +-Sweep */
+  uint32_t SysTickPriority;
+  uint32_t DmaPriority;
+}SIM_UsartRunTypeDef;
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t Payload[SIM_USART_BUFFERS][SIM_USART_BIG / 4];
+static uint8_t Line[SIM_USART_LINE];
+static FRM_ParserTypeDef Parser;
+static const SIM_UsartRunTypeDef* Run;
+static volatile uint32_t Offered;
+static uint32_t Done;
+static uint32_t Stuck;
+
+/* Private function prototypes -----------------------------------------------*/
+void SysTick_Handler(void);
+void DMA1_Channel4_IRQHandler(void);
+static void TxDone(const uint32_t* pPayload);
+static void Firmware(void);
+static uint32_t Check(const SIM_UsartRunTypeDef* pRun);
+
+/* Private functions ---------------------------------------------------------*/
+
+int main(void)
+{
+  static const SIM_UsartRunTypeDef backpressure =
+  {
+    "backpressure", SIM_USART_BIG, SIM_USART_BIG_FRAMES,
+    (SIM_USART_BIG + 20) * SIM_USART_BYTE * 2 / 3, 0, 3, 1
+  };
+  static const SIM_UsartRunTypeDef race =
+  {
+    "race", SIM_USART_SMALL, 4 * SIM_USART_SWEEP,
+    3 * (SIM_USART_SMALL + 20) * SIM_USART_BYTE, SIM_USART_SWEEP, 0, 1
+  };
+  uint32_t i, j, errors = 0;
+
+  for (i = 0; i < SIM_USART_BUFFERS; i++)
+  {
+    for (j = 0; j < SIM_USART_BIG / 4; j++)
+    {
+      Payload[i][j] = (i << 24) ^ (j * 0x9E3779B9UL);
+    }
+  }
+  SIM_Init(SIM_USART_CLOCK);
+  SIM_SetVector(SysTick_IRQn, SysTick_Handler);
+  SIM_SetVector(DMA1_Channel4_IRQn, DMA1_Channel4_IRQHandler);
+  errors += Check(&backpressure);
+  errors += Check(&race);
+  printf("%s\n", (errors == 0) ? "as expected" : "MISMATCH");
+  return (errors == 0) ? 0 : 1;
+}
+
+/**
+  * @brief  The producer: one frame per tick until the run's count is offered.
+  * @note   LOAD written here sets the gap after the next tick, not this one.
+  * @retval None
+  */
+void SysTick_Handler(void)
+{
+  uint32_t n = Offered;
+
+  if ((Run->Sweep != 0) && ((n & 1) != 0) && (USART1_TxPending() != 0))
+  {
+    /* After a long gap: a frame waited for this offer to be started */
+    Stuck++;
+  }
+  if (n < Run->Frames)
+  {
+    (void)USART1_TxFrame(FRM_TYPE_SAMPLES, 0, n, 1, Payload[n % SIM_USART_BUFFERS], Run->Length);
+    Offered = n + 1;
+  }
+  if (Run->Sweep != 0)
+  {
+    /* Gaps after odd offers are short, the pair's offset from one frame time */
+    SysTick->LOAD = ((n & 1) == 0) ?
+                    ((Run->Length + 20) * SIM_USART_BYTE + n / 2 - Run->Sweep - 1) : (Run->Period - 1);
+  }
+}
+
+/**
+  * @brief  The vector the driver expects to be called from.
+  * @retval None
+  */
+void DMA1_Channel4_IRQHandler(void)
+{
+  USART1_TxIRQHandler();
+}
+
+/**
+  * @brief  Done callback, counts the payloads handed back.
+  * @param  pPayload: unused.
+  * @retval None
+  */
+static void TxDone(const uint32_t* pPayload)
+{
+  (void)pPayload;
+  Done++;
+}
+
+/**
+  * @brief  Idles until every frame is offered and the line is quiet.
+  * @retval None
+  */
+static void Firmware(void)
+{
+  while ((Offered < Run->Frames) || (USART1_TxPending() != 0) || !(USART1->SR & USART_SR_TC))
+  {
+    __WFI();
+  }
+}
+
+/**
+  * @brief  One run, then the line parsed and checked against the driver.
+  * @param  pRun: what to offer.
+  * @retval Number of failed checks.
+  */
+static uint32_t Check(const SIM_UsartRunTypeDef* pRun)
+{
+  const FRM_HeaderTypeDef* h;
+  USART_TxStatsTypeDef stats;
+  uint64_t first, last, limit;
+  uint32_t bytes, kept, used, pos, overruns = 0, bad = 0, last_seq = 0, errors = 0;
+  int32_t stalled;
+
+  Run = pRun;
+  Offered = 0;
+  Done = 0;
+  Stuck = 0;
+  SIM_Reset();
+  SIM_SetUsartTx(Line, sizeof(Line));
+  USART1_TxInit(SIM_USART_BAUD, SIM_USART_CLOCK, TxDone);
+  CRC_Init();
+  NVIC_SetPriority(DMA1_Channel4_IRQn, pRun->DmaPriority);
+  NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+  SysTick_Config(pRun->Period);
+  NVIC_SetPriority(SysTick_IRQn, pRun->SysTickPriority);
+
+  limit = (uint64_t)pRun->Frames * (pRun->Period + (pRun->Length + 24) * SIM_USART_BYTE) * 2;
+  stalled = SIM_Run(Firmware, SIM_USART_CPI, limit);
+  SysTick->CTRL = 0;
+  USART1_TxGetStats(&stats);
+  bytes = SIM_GetUsartTx(&first, &last);
+  kept = (bytes < sizeof(Line)) ? bytes : sizeof(Line);
+
+  /* What the receiver sees, with what the parser still holds at the end */
+  FRM_ParserInit(&Parser);
+  pos = 0;
+  do
+  {
+    h = FRM_Parse(&Parser, Line + pos, kept - pos, &used);
+    pos += used;
+    if (h == 0)
+    {
+      continue;
+    }
+    if (h->Flags & FRM_FLAG_OVERRUN)
+    {
+      overruns++;
+    }
+    if ((h->Length != pRun->Length) ||
+        (memcmp(FRM_PAYLOAD(&Parser), Payload[h->Sequence % SIM_USART_BUFFERS], pRun->Length) != 0))
+    {
+      bad++;
+    }
+    last_seq = h->Sequence;
+  } while ((pos < kept) || (h != 0));
+
+  printf("%s: %u offered, %u sent, %u dropped, %u SysTick, %u DMA1_Channel4%s\n", pRun->pName, pRun->Frames,
+         stats.Frames, stats.Dropped, SIM_GetIrqCount(SysTick_IRQn), SIM_GetIrqCount(DMA1_Channel4_IRQn),
+         stalled ? ", STALLED" : "");
+  if (pRun->Sweep != 0)
+  {
+    printf("  %u frames left queued over an idle gap\n", Stuck);
+  }
+  printf("  parsed %u frames, %u CRC errors, %u bytes skipped, %u lost, %u with OVERRUN, %u bad payloads\n",
+         Parser.Frames, Parser.CrcErrors, Parser.Skipped, Parser.Lost, overruns, bad);
+  printf("  %u bytes in %.3f ms: %.1f%% of the %lu baud line, %.1f kB/s of payload\n", bytes,
+         (double)(last - first) * 1e3 / SIM_USART_CLOCK,
+         100.0 * bytes * SIM_USART_BYTE / (double)(last - first), SIM_USART_BAUD,
+         (double)stats.Frames * pRun->Length * SIM_USART_CLOCK / (double)(last - first) / 1e3);
+
+  if ((stalled != 0) || (stats.Frames + stats.Dropped != pRun->Frames) || (Done != stats.Frames) ||
+      (Parser.Frames != stats.Frames) || (Parser.CrcErrors != 0) || (Parser.Skipped != 0) || (bad != 0) ||
+      (bytes != stats.Bytes) || (bytes > sizeof(Line)) || (Stuck != 0))
+  {
+    errors++;
+  }
+  /* Drops after the last frame sent leave no gap for the receiver to see */
+  if (Parser.Lost != stats.Dropped - (pRun->Frames - 1 - last_seq))
+  {
+    errors++;
+  }
+  if ((stats.Dropped != 0) && ((overruns == 0) || (overruns > Parser.Lost)))
+  {
+    errors++;
+  }
+  if ((pRun->Sweep == 0) && (pRun->Period < (uint32_t)(pRun->Length + 20) * SIM_USART_BYTE) &&
+      (bytes * (uint64_t)SIM_USART_BYTE * 100 < (last - first) * 99))
+  {
+    /* Saturated: the pieces must follow each other with no idle line */
+    errors++;
+  }
+  return errors;
+}
+
+/************************ Copyright (C) 2020, Noel Cruz *****END OF FILE****/